@@ -22,6 +22,9 @@
 #include "../src/misc/Solve.h"
 #include "../src/Cholesky/LLT.h"
 #include "../src/Cholesky/LDLT.h"
+#if defined EIGEN_ARCH_CORTEXM
+#include "../src/Cholesky/arch/LLT_CortexM.h"
+#endif
 #ifdef EIGEN_USE_LAPACKE
 #include "../src/Cholesky/LLT_MKL.h"
 #endif
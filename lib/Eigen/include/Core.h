@@ -131,6 +131,13 @@ extern "C"
 #endif
 #endif
 
+// ARMv7E-M with a single precision FPU (Cortex-M4F, Cortex-M7) has no packet unit Eigen can use for floats,
+// but gets tuned settings and fixed-size scalar kernels. EIGEN_ARCH_CORTEXM can also be defined by hand
+// (together with EIGEN_DONT_VECTORIZE) to check those kernels against the generic path on another host.
+#if !defined(EIGEN_VECTORIZE) && defined(__ARM_ARCH_7EM__) && defined(__ARM_FP) && !defined(EIGEN_DONT_USE_CORTEXM_KERNELS)
+#define EIGEN_ARCH_CORTEXM
+#endif
+
 #if (defined _OPENMP) && (!defined EIGEN_DONT_PARALLELIZE)
 #define EIGEN_HAS_OPENMP
 #endif
@@ -274,6 +281,12 @@ using std::ptrdiff_t;
 #include "../src/Core/arch/NEON/Complex.h"
 #endif
 
+#if defined EIGEN_VECTORIZE_SSE
+#include "../src/Core/arch/SSE/Settings.h"
+#elif defined EIGEN_ARCH_CORTEXM
+#include "../src/Core/arch/CortexM/Settings.h"
+#endif
+
 #include "../src/Core/arch/Default/Settings.h"
 
 #include "../src/Core/Functors.h"
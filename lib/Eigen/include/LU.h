@@ -29,6 +29,8 @@
 
 #if defined EIGEN_VECTORIZE_SSE
 #include "../src/LU/arch/Inverse_SSE.h"
+#elif defined EIGEN_ARCH_CORTEXM
+#include "../src/LU/arch/Inverse_CortexM.h"
 #endif
 
 #ifdef EIGEN2_SUPPORT
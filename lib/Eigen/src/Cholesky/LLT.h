@@ -264,6 +264,15 @@ static typename MatrixType::Index llt_rank_update_lower(MatrixType& mat, const V
   return -1;
 }
 
+// Small fixed-size factorizations can be specialized per architecture (see Cholesky/arch).
+// The generic version is disabled, blocked() then runs the algorithms below.
+template<int Arch, typename Scalar, typename MatrixType>
+struct llt_inplace_fixed
+{
+  enum { Enabled = 0 };
+  static typename MatrixType::Index run(MatrixType&) { return -1; }
+};
+
 template<typename Scalar> struct llt_inplace<Scalar, Lower>
 {
   typedef typename NumTraits<Scalar>::Real RealScalar;
@@ -294,12 +303,35 @@ template<typename Scalar> struct llt_inplace<Scalar, Lower>
     return -1;
   }
 
+  // unblocked() through a map without packet access, see EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE
+  template<typename MatrixType>
+  static typename MatrixType::Index unblocked_scalar(MatrixType& m, true_type /* direct access */)
+  {
+    // keep the compile-time sizes and stride, so fixed-size loops are still unrolled
+    typedef Matrix<Scalar,MatrixType::RowsAtCompileTime,MatrixType::ColsAtCompileTime,
+                   (int(MatrixType::Flags)&RowMajorBit ? RowMajor : ColMajor) | DontAlign,
+                   MatrixType::MaxRowsAtCompileTime,MatrixType::MaxColsAtCompileTime> ScalarMatrix;
+    typedef OuterStride<MatrixType::OuterStrideAtCompileTime> ScalarStride;
+    Map<ScalarMatrix,Unaligned,ScalarStride> map(&m.coeffRef(0,0), m.rows(), m.cols(), ScalarStride(m.outerStride()));
+    return unblocked(map);
+  }
+  template<typename MatrixType>
+  static typename MatrixType::Index unblocked_scalar(MatrixType& m, false_type /* direct access */)
+  {
+    return unblocked(m);
+  }
+
   template<typename MatrixType>
   static typename MatrixType::Index blocked(MatrixType& m)
   {
     typedef typename MatrixType::Index Index;
     eigen_assert(m.rows()==m.cols());
+    typedef llt_inplace_fixed<Architecture::Target, Scalar, MatrixType> FixedKernel;
+    if(FixedKernel::Enabled)
+      return FixedKernel::run(m);
     Index size = m.rows();
+    if(size<=EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE)
+      return unblocked_scalar(m, typename conditional<bool(int(MatrixType::Flags)&DirectAccessBit), true_type, false_type>::type());
     if(size<32)
       return unblocked(m);
 
@@ -0,0 +1,77 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/* Cholesky factorization of small fixed-size float matrices for Cortex-M.
+ *
+ * The generic unblocked algorithm works on Dynamic sized blocks, so the factorization goes through
+ * runtime-sized products and reductions. With the size known at compile time all the loops below
+ * have constant bounds and are completely unrolled by the compiler. At -Os this pays off from 4x4
+ * (tools/eigen_bench); a 3x3 factorization is as fast with the generic path and keeps using it.
+ *
+ * The operations are done in exactly the same order as llt_inplace<float,Lower>::unblocked, so the
+ * result is bit-for-bit identical to the generic path (as long as the compiler does not contract
+ * the multiply-adds differently in the two versions).
+ */
+
+#ifndef EIGEN_LLT_CORTEXM_H
+#define EIGEN_LLT_CORTEXM_H
+
+namespace Eigen { 
+
+namespace internal {
+
+template<typename MatrixType>
+struct llt_inplace_fixed<Architecture::CortexM, float, MatrixType>
+{
+  enum {
+    Size = MatrixType::RowsAtCompileTime,
+    Enabled = Size != Dynamic && Size >= 4 && Size <= 6 // 3x3 is as fast with the generic path
+  };
+  typedef typename MatrixType::Index Index;
+
+  static Index run(MatrixType& mat)
+  {
+    using std::sqrt;
+
+    for(Index k = 0; k < Size; ++k)
+    {
+      // x = a(k,k) - |A10|^2
+      float x = mat.coeff(k,k);
+      if (k>0)
+      {
+        float squared_norm = mat.coeff(k,0) * mat.coeff(k,0);
+        for(Index j = 1; j < k; ++j)
+          squared_norm += mat.coeff(k,j) * mat.coeff(k,j);
+        x -= squared_norm;
+      }
+      if (x<=0.0f)
+        return k;
+      mat.coeffRef(k,k) = x = sqrt(x);
+
+      // A21 = (A21 - A20 * A10^T) / x
+      for(Index i = k+1; i < Size; ++i)
+      {
+        float a = mat.coeff(i,k);
+        if (k>0)
+        {
+          float dot = mat.coeff(i,0) * mat.coeff(k,0);
+          for(Index j = 1; j < k; ++j)
+            dot += mat.coeff(i,j) * mat.coeff(k,j);
+          a -= dot;
+        }
+        mat.coeffRef(i,k) = a / x;
+      }
+    }
+    return -1;
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_LLT_CORTEXM_H
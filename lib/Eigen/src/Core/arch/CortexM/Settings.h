@@ -0,0 +1,32 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/* Settings for ARMv7E-M cores with a single precision FPU (Cortex-M4F, Cortex-M7).
+ * Included before Default/Settings.h, so the user can still override everything. */
+
+#ifndef EIGEN_CORTEXM_SETTINGS_H
+#define EIGEN_CORTEXM_SETTINGS_H
+
+/** Without a data cache the packing done by the cache friendly (GEBP) product does not pay off for
+  * small matrices, and the coefficient based product does not need blocking buffers.
+  * The loop unrolling limit and the register count are left at their defaults: a higher unrolling
+  * limit made the 6x6 products slower at -Os (tools/eigen_bench), and the register count only
+  * matters to the GEBP product, which this threshold keeps away from fixed sizes below 16.
+  */
+#ifndef EIGEN_CACHEFRIENDLY_PRODUCT_THRESHOLD
+#define EIGEN_CACHEFRIENDLY_PRODUCT_THRESHOLD 16
+#endif
+
+/** Temporaries of the triangular solvers and of the matrix-vector products go on the stack when alloca
+  * is available and on the heap otherwise. Memory.h only detects alloca on Linux, Apple and when the C
+  * library defines it as a macro, so name the builtin explicitly rather than silently calling malloc.
+  */
+#ifndef EIGEN_ALLOCA
+#define EIGEN_ALLOCA __builtin_alloca
+#endif
+
+#endif // EIGEN_CORTEXM_SETTINGS_H
@@ -46,4 +46,13 @@
 #define EIGEN_ARCH_DEFAULT_NUMBER_OF_REGISTERS 8
 #endif
 
+/** Dense decompositions of matrices up to this size (rows and columns) run their unblocked
+  * algorithm through a map without packet access, so every block operation takes the scalar path.
+  * Their blocks are only a few coefficients long, so the packet loops mostly run their prologue and
+  * epilogue. 0 keeps the packet path for all sizes.
+  */
+#ifndef EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE
+#define EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE 0
+#endif
+
 #endif // EIGEN_DEFAULT_SETTINGS_H
\ No newline at end of file
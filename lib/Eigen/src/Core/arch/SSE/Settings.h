@@ -0,0 +1,22 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/* Settings for SSE hosts. Included before Default/Settings.h, so the user can still override everything. */
+
+#ifndef EIGEN_SSE_SETTINGS_H
+#define EIGEN_SSE_SETTINGS_H
+
+/** The partial pivoting LU and the LLT of 3x3..12x12 float matrices are slower with 4-float packets
+  * than without (tools/eigen_bench), because the columns of their rank updates are shorter than a few
+  * packets. 16 is the size up to which both already skip blocking. Products keep the packet path:
+  * 6x6 and larger products and the 4x4 inverse are faster with it.
+  */
+#ifndef EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE
+#define EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE 16
+#endif
+
+#endif // EIGEN_SSE_SETTINGS_H
@@ -261,6 +261,27 @@ struct compute_inverse_and_det_with_check<MatrixType, ResultType, 4>
   }
 };
 
+/****************************
+*** Size 6 implementation ***
+****************************/
+
+// Same as the general case, but can be specialized for a given architecture via the Arch template argument.
+template<int Arch, typename Scalar, typename MatrixType, typename ResultType>
+struct compute_inverse_size6
+{
+  static inline void run(const MatrixType& matrix, ResultType& result)
+  {
+    result = matrix.partialPivLu().inverse();
+  }
+};
+
+template<typename MatrixType, typename ResultType>
+struct compute_inverse<MatrixType, ResultType, 6>
+ : compute_inverse_size6<Architecture::Target, typename MatrixType::Scalar,
+                            MatrixType, ResultType>
+{
+};
+
 /*************************
 *** MatrixBase methods ***
 *************************/
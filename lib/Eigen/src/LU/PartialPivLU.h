@@ -228,6 +228,9 @@ struct partial_lu_impl
   // and Block.
   typedef Map<Matrix<Scalar, Dynamic, Dynamic, StorageOrder> > MapLU;
   typedef Block<MapLU, Dynamic, Dynamic> MatrixType;
+  // without packet access, see EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE
+  typedef Map<Matrix<Scalar, Dynamic, Dynamic, StorageOrder | DontAlign> > ScalarMapLU;
+  typedef Block<ScalarMapLU, Dynamic, Dynamic> ScalarMatrixType;
   typedef Block<MatrixType,Dynamic,Dynamic> BlockType;
   typedef typename MatrixType::RealScalar RealScalar;
   typedef typename MatrixType::Index Index;
@@ -242,7 +245,8 @@ struct partial_lu_impl
     *
     * \returns The index of the first pivot which is exactly zero if any, or a negative number otherwise.
     */
-  static Index unblocked_lu(MatrixType& lu, PivIndex* row_transpositions, PivIndex& nb_transpositions)
+  template<typename LUType>
+  static Index unblocked_lu(LUType& lu, PivIndex* row_transpositions, PivIndex& nb_transpositions)
   {
     const Index rows = lu.rows();
     const Index cols = lu.cols();
@@ -311,6 +315,12 @@ struct partial_lu_impl
     // if the matrix is too small, no blocking:
     if(size<=16)
     {
+      if(rows<=EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE && cols<=EIGEN_SCALAR_DECOMPOSITION_MAX_SIZE)
+      {
+        ScalarMapLU scalar_lu1(lu_data,StorageOrder==RowMajor?rows:luStride,StorageOrder==RowMajor?luStride:cols);
+        ScalarMatrixType scalar_lu(scalar_lu1,0,0,rows,cols);
+        return unblocked_lu(scalar_lu, row_transpositions, nb_transpositions);
+      }
       return unblocked_lu(lu, row_transpositions, nb_transpositions);
     }
 
@@ -0,0 +1,145 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/* 6x6 float inverse for Cortex-M.
+ *
+ * The generic path builds a PartialPivLU and solves it against the identity with the blocked
+ * triangular solver, which packs the operands for the GEBP kernel. Here the factorization is done
+ * on a local array with constant loop bounds, in the same order as PartialPivLU (so the LU factors
+ * are bit-for-bit identical), followed by forward and back substitution per column. The substitution
+ * keeps the panel structure of triangular_solve_matrix (small triangular panels solved column by
+ * column, the rows outside the panel updated by dot products), so the inverse is bit-for-bit
+ * identical to the generic path as well.
+ *
+ * 3x3 and 4x4 matrices already use the closed-form cofactor formulas of Inverse.h.
+ */
+
+#ifndef EIGEN_INVERSE_CORTEXM_H
+#define EIGEN_INVERSE_CORTEXM_H
+
+namespace Eigen { 
+
+namespace internal {
+
+template<typename MatrixType, typename ResultType>
+struct compute_inverse_size6<Architecture::CortexM, float, MatrixType, ResultType>
+{
+  typedef typename MatrixType::Index Index;
+
+  static void run(const MatrixType& matrix, ResultType& result)
+  {
+    using std::abs;
+
+    float lu[6][6];
+    Index row_of[6]; // row_of[i]: row of the original matrix now stored in row i
+    for(Index i = 0; i < 6; ++i)
+    {
+      for(Index j = 0; j < 6; ++j)
+        lu[i][j] = matrix.coeff(i,j);
+      row_of[i] = i;
+    }
+
+    for(Index k = 0; k < 6; ++k)
+    {
+      // first row with the biggest magnitude, like maxCoeff()
+      Index pivot = k;
+      float biggest = abs(lu[k][k]);
+      for(Index i = k+1; i < 6; ++i)
+      {
+        if(abs(lu[i][k]) > biggest)
+        {
+          biggest = abs(lu[i][k]);
+          pivot = i;
+        }
+      }
+
+      if(biggest != 0.0f)
+      {
+        if(pivot != k)
+        {
+          for(Index j = 0; j < 6; ++j)
+            std::swap(lu[k][j], lu[pivot][j]);
+          std::swap(row_of[k], row_of[pivot]);
+        }
+        for(Index i = k+1; i < 6; ++i)
+          lu[i][k] /= lu[k][k];
+      }
+
+      for(Index i = k+1; i < 6; ++i)
+        for(Index j = k+1; j < 6; ++j)
+          lu[i][j] -= lu[i][k] * lu[k][j];
+    }
+
+    for(Index c = 0; c < 6; ++c)
+    {
+      float x[6];
+      for(Index i = 0; i < 6; ++i)
+        x[i] = row_of[i] == c ? 1.0f : 0.0f;
+
+      solveUnitLower(lu, x);
+      solveUpper(lu, x);
+
+      for(Index i = 0; i < 6; ++i)
+        result.coeffRef(i,c) = x[i];
+    }
+  }
+
+private:
+  // panel width of triangular_solve_matrix
+  typedef gebp_traits<float,float> Traits;
+  enum { PanelWidth = EIGEN_PLAIN_ENUM_MAX(Traits::mr,Traits::nr) };
+
+  // L x = b: inside a panel column by column, below the panel by dot products (the GEBP update)
+  static EIGEN_STRONG_INLINE void solveUnitLower(const float (&lu)[6][6], float (&x)[6])
+  {
+    for(Index k1 = 0; k1 < 6; k1 += PanelWidth)
+    {
+      const Index end = (std::min)(k1 + Index(PanelWidth), Index(6));
+      for(Index i = k1; i < end; ++i)
+        for(Index r = i+1; r < end; ++r)
+          x[r] -= x[i] * lu[r][i];
+
+      for(Index t = end; t < 6; ++t)
+      {
+        float dot = 0.0f;
+        for(Index p = k1; p < end; ++p)
+          dot += lu[t][p] * x[p];
+        x[t] -= dot;
+      }
+    }
+  }
+
+  // U x = b, same structure from the bottom, dividing by multiplying with the reciprocal
+  static EIGEN_STRONG_INLINE void solveUpper(const float (&lu)[6][6], float (&x)[6])
+  {
+    for(Index k1 = 0; k1 < 6; k1 += PanelWidth)
+    {
+      const Index width = (std::min)(Index(PanelWidth), Index(6) - k1);
+      const Index start = 6 - k1 - width;
+      for(Index i = 6 - k1 - 1; i >= start; --i)
+      {
+        x[i] *= 1.0f / lu[i][i];
+        for(Index r = start; r < i; ++r)
+          x[r] -= x[i] * lu[r][i];
+      }
+
+      for(Index t = 0; t < start; ++t)
+      {
+        float dot = 0.0f;
+        for(Index p = start; p < start + width; ++p)
+          dot += lu[t][p] * x[p];
+        x[t] -= dot;
+      }
+    }
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_INVERSE_CORTEXM_H
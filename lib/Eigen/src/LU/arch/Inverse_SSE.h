@@ -0,0 +1,132 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Single precision 4x4 inverse by 2x2 block adjugates.
+//
+// Writing the matrix as M = [A B; C D] with 2x2 blocks and X# for the adjugate of X,
+//   det(M) = |A||D| + |B||C| - tr((A#B)(D#C))
+//   M^-1   = 1/det(M) * [ (|D|A - B(D#C))#   (|B|C - D(A#B)#)# ]
+//                       [ (|C|B - A(D#C)#)#  (|A|D - C(A#B))#  ]
+// Each 2x2 block is held in one packet in the storage order of the matrix.
+// The formula is applied to the outer vectors (columns for column-major) as if
+// they were rows: this yields the inverse of the transpose laid out by rows,
+// i.e. the inverse laid out by columns, so no transposition is needed.
+
+#ifndef EIGEN_INVERSE_SSE_H
+#define EIGEN_INVERSE_SSE_H
+
+namespace Eigen { 
+
+namespace internal {
+
+// a * b for 2x2 blocks stored as [x00 x01 x10 x11]
+EIGEN_STRONG_INLINE Packet4f inverse_sse_mat2_mul(const Packet4f& a, const Packet4f& b)
+{
+  return _mm_add_ps(_mm_mul_ps(a, vec4f_swizzle1(b,0,3,0,3)),
+                    _mm_mul_ps(vec4f_swizzle1(a,1,0,3,2), vec4f_swizzle1(b,2,1,2,1)));
+}
+
+// a# * b
+EIGEN_STRONG_INLINE Packet4f inverse_sse_mat2_adj_mul(const Packet4f& a, const Packet4f& b)
+{
+  return _mm_sub_ps(_mm_mul_ps(vec4f_swizzle1(a,3,3,0,0), b),
+                    _mm_mul_ps(vec4f_swizzle1(a,1,1,2,2), vec4f_swizzle1(b,2,3,0,1)));
+}
+
+// a * b#
+EIGEN_STRONG_INLINE Packet4f inverse_sse_mat2_mul_adj(const Packet4f& a, const Packet4f& b)
+{
+  return _mm_sub_ps(_mm_mul_ps(a, vec4f_swizzle1(b,3,0,3,0)),
+                    _mm_mul_ps(vec4f_swizzle1(a,1,0,3,2), vec4f_swizzle1(b,2,1,2,1)));
+}
+
+template<typename MatrixType, typename ResultType,
+         bool Vectorizable = bool(MatrixType::Flags&ResultType::Flags&PacketAccessBit)
+                          && (int(MatrixType::Flags&RowMajorBit) == int(ResultType::Flags&RowMajorBit))>
+struct compute_inverse_size4_sse_float
+  : compute_inverse_size4<Architecture::Generic, float, MatrixType, ResultType>
+{
+};
+
+template<typename MatrixType, typename ResultType>
+struct compute_inverse_size4_sse_float<MatrixType, ResultType, true>
+{
+  enum {
+    IsRowMajor = bool(MatrixType::Flags&RowMajorBit),
+    MatrixAlignment = bool(MatrixType::Flags&AlignedBit) ? Aligned : Unaligned,
+    ResultAlignment = bool(ResultType::Flags&AlignedBit) ? Aligned : Unaligned
+  };
+
+  static EIGEN_STRONG_INLINE Packet4f load(const MatrixType& matrix, typename MatrixType::Index outer)
+  {
+    return matrix.template packet<MatrixAlignment>(IsRowMajor ? outer : 0, IsRowMajor ? 0 : outer);
+  }
+
+  static EIGEN_STRONG_INLINE void store(ResultType& result, typename ResultType::Index outer, const Packet4f& value)
+  {
+    result.template writePacket<ResultAlignment>(IsRowMajor ? outer : 0, IsRowMajor ? 0 : outer, value);
+  }
+
+  static void run(const MatrixType& matrix, ResultType& result)
+  {
+    Packet4f m0 = load(matrix, 0);
+    Packet4f m1 = load(matrix, 1);
+    Packet4f m2 = load(matrix, 2);
+    Packet4f m3 = load(matrix, 3);
+
+    Packet4f A = _mm_movelh_ps(m0, m1);
+    Packet4f B = _mm_movehl_ps(m1, m0);
+    Packet4f C = _mm_movelh_ps(m2, m3);
+    Packet4f D = _mm_movehl_ps(m3, m2);
+
+    // |A| |B| |C| |D|
+    Packet4f det_sub = _mm_sub_ps(_mm_mul_ps(vec4f_swizzle2(m0,m2,0,2,0,2), vec4f_swizzle2(m1,m3,1,3,1,3)),
+                                  _mm_mul_ps(vec4f_swizzle2(m0,m2,1,3,1,3), vec4f_swizzle2(m1,m3,0,2,0,2)));
+    Packet4f det_a = vec4f_swizzle1(det_sub,0,0,0,0);
+    Packet4f det_b = vec4f_swizzle1(det_sub,1,1,1,1);
+    Packet4f det_c = vec4f_swizzle1(det_sub,2,2,2,2);
+    Packet4f det_d = vec4f_swizzle1(det_sub,3,3,3,3);
+
+    Packet4f d_c = inverse_sse_mat2_adj_mul(D, C);
+    Packet4f a_b = inverse_sse_mat2_adj_mul(A, B);
+
+    Packet4f X = _mm_sub_ps(_mm_mul_ps(det_d, A), inverse_sse_mat2_mul(B, d_c));
+    Packet4f W = _mm_sub_ps(_mm_mul_ps(det_a, D), inverse_sse_mat2_mul(C, a_b));
+    Packet4f Y = _mm_sub_ps(_mm_mul_ps(det_b, C), inverse_sse_mat2_mul_adj(D, a_b));
+    Packet4f Z = _mm_sub_ps(_mm_mul_ps(det_c, B), inverse_sse_mat2_mul_adj(A, d_c));
+
+    // tr((A#B)(D#C))
+    Packet4f trace = _mm_mul_ps(a_b, vec4f_swizzle1(d_c,0,2,1,3));
+    Packet4f det_m = _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c));
+    det_m = _mm_sub_ps(det_m, pset1<Packet4f>(predux(trace)));
+
+    // the sign pattern of the 2x2 adjugates folded into the reciprocal determinant
+    const Packet4f sign = _mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f);
+    Packet4f rdet = _mm_div_ps(sign, det_m);
+    X = _mm_mul_ps(X, rdet);
+    Y = _mm_mul_ps(Y, rdet);
+    Z = _mm_mul_ps(Z, rdet);
+    W = _mm_mul_ps(W, rdet);
+
+    store(result, 0, vec4f_swizzle2(X,Y,3,1,3,1));
+    store(result, 1, vec4f_swizzle2(X,Y,2,0,2,0));
+    store(result, 2, vec4f_swizzle2(Z,W,3,1,3,1));
+    store(result, 3, vec4f_swizzle2(Z,W,2,0,2,0));
+  }
+};
+
+template<typename MatrixType, typename ResultType>
+struct compute_inverse_size4<Architecture::SSE, float, MatrixType, ResultType>
+  : compute_inverse_size4_sse_float<MatrixType, ResultType>
+{
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_INVERSE_SSE_H
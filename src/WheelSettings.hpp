@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include "units/units.hpp"
+
+// ホスト環境のmath.hにはM_SQRT3が無いので補う
+#ifndef M_SQRT3
+#define M_SQRT3 1.73205080756887719318
+#endif
+
+// 車輪の配置。mbedに依存しないのでホスト側のツールからも使える。
+
+struct WheelPositions
+{
+    Position position;
+    // ホイール半径
+    Meter radius;
+};
+
+namespace WheelSettings
+{
+    constexpr Meter TREAD_RAD = 210_mm;
+    constexpr Meter WHEEL_RAD = 30_mm;
+
+    constexpr WheelPositions front{
+        .position = {0_mm, TREAD_RAD, 0_deg},
+        .radius = WHEEL_RAD,
+    };
+    constexpr WheelPositions rear_left{
+        .position = {TREAD_RAD * -M_SQRT3 / 2.0f, -TREAD_RAD / 2.0f, Radian(M_PI * 2.0f / 3.0f)},
+        .radius = WHEEL_RAD,
+    };
+    constexpr WheelPositions rear_right{
+        .position = {TREAD_RAD * +M_SQRT3 / 2.0f, -TREAD_RAD / 2.0f, Radian(M_PI * 4.0f / 3.0f)},
+        .radius = WHEEL_RAD,
+    };
+    // 駆動輪 (main.cppのmotor_wheelsと同じ順)
+    constexpr std::array<WheelPositions, 3> drive_wheels = {front, rear_left, rear_right};
+
+    constexpr WheelPositions measuring_x{
+        .position = {0_mm, 0_mm, 0_deg},
+        .radius = WHEEL_RAD,
+    };
+    constexpr WheelPositions measuring_y{
+        .position = {0_mm, 0_mm, 90_deg},
+        .radius = WHEEL_RAD,
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <mbed.hpp>
+
+// ISection::updateの中で使う、ブロックしない待機の部品
+// 条件が満たされたかを毎周期問い合わせ、満たされるまでRunningを返せばよい。
+
+// 一定時間の経過を待つ
+class AwaitTimer
+{
+public:
+    AwaitTimer() : duration(0) {}
+
+    // 今から待ち始める
+    void start(chrono::microseconds duration)
+    {
+        this->duration = duration;
+        timer.reset();
+        timer.start();
+    }
+
+    bool isElapsed()
+    {
+        return timer.elapsed_time() >= duration;
+    }
+
+private:
+    Timer timer;
+    chrono::microseconds duration;
+};
+
+// EventFlagsのフラグが立つのを待つ (割り込みやスレッドから立てられるもの)
+class AwaitFlags
+{
+public:
+    AwaitFlags(EventFlags &event_flags, uint32_t flags) : event_flags(event_flags), flags(flags) {}
+
+    // いずれかのフラグが立っていればクリアしてtrueを返す
+    bool isSet()
+    {
+        if ((event_flags.get() & flags) == 0)
+        {
+            return false;
+        }
+
+        event_flags.clear(flags);
+        return true;
+    }
+
+private:
+    EventFlags &event_flags;
+    uint32_t flags;
+};
@@ -1,7 +1,19 @@
 #pragma once
 
+enum class SectionStatus
+{
+    Running,  // 実行中。次の制御周期でもupdateを呼ぶ。
+    Finished, // 完了。次のセクションに進む。
+};
+
+// セクションの抽象クラス
+// 制御周期ごとにupdateが呼ばれる協調的なステートマシンとして実装する。
+// updateの中で待機(sleep_forなど)してはいけない。待つ代わりにRunningを返すこと。
 class ISection
 {
 public:
-    virtual void action() = 0;
+    // セクションの開始時に1度だけ呼ばれる
+    virtual void start() {}
+    // 制御周期ごとに呼ばれる
+    virtual SectionStatus update() = 0;
 };
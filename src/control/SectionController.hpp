@@ -1,53 +1,81 @@
 #pragma once
+#include <mbed.hpp>
 #include "ISection.hpp"
 
+// セクションを順番に実行する
+// 専用のスレッドは持たず、制御周期ごとにupdateを呼んでもらう。
+// PositionController::setControlCallbackに登録すれば制御スレッドのスタック上で動き、
+// 位置の更新から1制御周期以内に反応できる。
 template <int N>
 class SectionController
 {
 public:
     SectionController(array<ISection *, N> sections)
-        : sections(sections), is_running(false) {}
+        : sections(sections), current_index(0), is_started(false), is_running(false) {}
 
     void start()
     {
-        if (sections.empty() || is_running)
+        mutex.lock();
+        if (!sections.empty() && !is_running)
         {
-            return;
+            current_index = 0;
+            is_started = false;
+            is_running = true;
         }
-
-        is_running = true;
-        thread.start(callback(this, &SectionController::run));
+        mutex.unlock();
     }
 
     void stop()
     {
+        mutex.lock();
         is_running = false;
-        thread.join();
+        mutex.unlock();
     }
 
     bool isRunning()
     {
+        mutex.lock();
+        bool is_running = this->is_running;
+        mutex.unlock();
+
         return is_running;
     }
 
-private:
-    void run()
+    // 制御周期ごとに呼ぶ
+    void update()
     {
-        for (ISection *section : sections)
+        mutex.lock();
+
+        if (is_running)
         {
-            if (!is_running)
+            ISection *section = sections[current_index];
+
+            if (!is_started)
             {
-                break;
+                section->start();
+                is_started = true;
             }
 
-            section->action();
+            if (section->update() == SectionStatus::Finished)
+            {
+                current_index++;
+                is_started = false;
+
+                // 全てのセクションが完了
+                if (current_index >= N)
+                {
+                    is_running = false;
+                }
+            }
         }
 
-        // 全てのセクションが完了
-        is_running = false;
+        mutex.unlock();
     }
 
+private:
     array<ISection *, N> sections;
-    Thread thread;
+    int current_index;
+    bool is_started;
     bool is_running;
+    Mutex mutex;
 };
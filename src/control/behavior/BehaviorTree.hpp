@@ -0,0 +1,344 @@
+#pragma once
+#include <mbed.hpp>
+#include <array>
+#include "control/ISection.hpp"
+
+enum class NodeStatus
+{
+    Success,
+    Failure,
+    Running,
+};
+
+// ビヘイビアツリーのノードの抽象クラス
+// tickは一定周期で呼ばれ、待機せずにすぐ戻ること。
+class IBehaviorNode
+{
+public:
+    virtual NodeStatus tick() = 0;
+    // 実行中の状態を捨てて最初からやり直せるようにする
+    virtual void reset() {}
+};
+
+// --- 葉ノード ---
+
+// 処理を実行し、その結果を返す
+class ActionNode : public IBehaviorNode
+{
+public:
+    ActionNode(Callback<NodeStatus()> action) : action(action) {}
+
+    NodeStatus tick() override
+    {
+        return action();
+    }
+
+private:
+    Callback<NodeStatus()> action;
+};
+
+// 条件が真ならSuccess、偽ならFailure
+class ConditionNode : public IBehaviorNode
+{
+public:
+    ConditionNode(Callback<bool()> condition) : condition(condition) {}
+
+    NodeStatus tick() override
+    {
+        return condition() ? NodeStatus::Success : NodeStatus::Failure;
+    }
+
+private:
+    Callback<bool()> condition;
+};
+
+// --- 複合ノード ---
+// C: 子ノードの数
+
+// 子を順に実行し、全てSuccessならSuccess。1つでもFailureならFailure。
+template <int C>
+class SequenceNode : public IBehaviorNode
+{
+public:
+    SequenceNode(std::array<IBehaviorNode *, C> children) : children(children), current(0) {}
+
+    NodeStatus tick() override
+    {
+        while (current < C)
+        {
+            NodeStatus status = children[current]->tick();
+
+            if (status == NodeStatus::Running)
+            {
+                return NodeStatus::Running;
+            }
+            if (status == NodeStatus::Failure)
+            {
+                reset();
+                return NodeStatus::Failure;
+            }
+
+            current++;
+        }
+
+        reset();
+        return NodeStatus::Success;
+    }
+
+    void reset() override
+    {
+        for (IBehaviorNode *child : children)
+        {
+            child->reset();
+        }
+        current = 0;
+    }
+
+private:
+    std::array<IBehaviorNode *, C> children;
+    int current;
+};
+
+// 子を順に実行し、1つでもSuccessならSuccess。全てFailureならFailure。
+template <int C>
+class FallbackNode : public IBehaviorNode
+{
+public:
+    FallbackNode(std::array<IBehaviorNode *, C> children) : children(children), current(0) {}
+
+    NodeStatus tick() override
+    {
+        while (current < C)
+        {
+            NodeStatus status = children[current]->tick();
+
+            if (status == NodeStatus::Running)
+            {
+                return NodeStatus::Running;
+            }
+            if (status == NodeStatus::Success)
+            {
+                reset();
+                return NodeStatus::Success;
+            }
+
+            current++;
+        }
+
+        reset();
+        return NodeStatus::Failure;
+    }
+
+    void reset() override
+    {
+        for (IBehaviorNode *child : children)
+        {
+            child->reset();
+        }
+        current = 0;
+    }
+
+private:
+    std::array<IBehaviorNode *, C> children;
+    int current;
+};
+
+// 全ての子を同じtickで実行する。
+// success_threshold個の子がSuccessになればSuccess、それが不可能になればFailure。
+template <int C>
+class ParallelNode : public IBehaviorNode
+{
+public:
+    ParallelNode(std::array<IBehaviorNode *, C> children, int success_threshold = C)
+        : children(children), success_threshold(success_threshold)
+    {
+        reset();
+    }
+
+    NodeStatus tick() override
+    {
+        int success_count = 0;
+        int failure_count = 0;
+
+        for (int i = 0; i < C; i++)
+        {
+            // 完了した子はもう実行しない
+            if (results[i] == NodeStatus::Running)
+            {
+                results[i] = children[i]->tick();
+            }
+
+            success_count += (results[i] == NodeStatus::Success);
+            failure_count += (results[i] == NodeStatus::Failure);
+        }
+
+        if (success_count >= success_threshold)
+        {
+            reset();
+            return NodeStatus::Success;
+        }
+        if (failure_count > C - success_threshold)
+        {
+            reset();
+            return NodeStatus::Failure;
+        }
+
+        return NodeStatus::Running;
+    }
+
+    void reset() override
+    {
+        for (int i = 0; i < C; i++)
+        {
+            children[i]->reset();
+            results[i] = NodeStatus::Running;
+        }
+    }
+
+private:
+    std::array<IBehaviorNode *, C> children;
+    std::array<NodeStatus, C> results;
+    int success_threshold;
+};
+
+// --- デコレーター ---
+
+// 子の結果のSuccessとFailureを反転する
+class InverterNode : public IBehaviorNode
+{
+public:
+    InverterNode(IBehaviorNode *child) : child(child) {}
+
+    NodeStatus tick() override
+    {
+        NodeStatus status = child->tick();
+
+        if (status == NodeStatus::Success)
+        {
+            return NodeStatus::Failure;
+        }
+        if (status == NodeStatus::Failure)
+        {
+            return NodeStatus::Success;
+        }
+
+        return NodeStatus::Running;
+    }
+
+    void reset() override
+    {
+        child->reset();
+    }
+
+private:
+    IBehaviorNode *child;
+};
+
+// 子がcount回Successになるまで繰り返す。途中でFailureになればFailure。
+class RepeatNode : public IBehaviorNode
+{
+public:
+    RepeatNode(IBehaviorNode *child, int count) : child(child), count(count), done(0) {}
+
+    NodeStatus tick() override
+    {
+        NodeStatus status = child->tick();
+
+        if (status == NodeStatus::Failure)
+        {
+            reset();
+            return NodeStatus::Failure;
+        }
+        if (status == NodeStatus::Success && ++done >= count)
+        {
+            reset();
+            return NodeStatus::Success;
+        }
+
+        return NodeStatus::Running;
+    }
+
+    void reset() override
+    {
+        child->reset();
+        done = 0;
+    }
+
+private:
+    IBehaviorNode *child;
+    int count;
+    int done;
+};
+
+// 子がtimeout以内に完了しなければFailure
+class TimeoutNode : public IBehaviorNode
+{
+public:
+    TimeoutNode(IBehaviorNode *child, chrono::microseconds timeout) : child(child), timeout(timeout), is_started(false) {}
+
+    NodeStatus tick() override
+    {
+        if (!is_started)
+        {
+            timer.reset();
+            timer.start();
+            is_started = true;
+        }
+
+        NodeStatus status = child->tick();
+
+        if (status == NodeStatus::Running && timer.elapsed_time() >= timeout)
+        {
+            reset();
+            return NodeStatus::Failure;
+        }
+        if (status != NodeStatus::Running)
+        {
+            is_started = false;
+        }
+
+        return status;
+    }
+
+    void reset() override
+    {
+        child->reset();
+        is_started = false;
+    }
+
+private:
+    IBehaviorNode *child;
+    Timer timer;
+    chrono::microseconds timeout;
+    bool is_started;
+};
+
+// ビヘイビアツリーをセクションとして実行する
+// SectionControllerから制御周期ごとにtickされ、根がSuccessかFailureを返したら完了。
+class BehaviorTreeSection : public ISection
+{
+public:
+    BehaviorTreeSection(IBehaviorNode *root) : root(root), last_status(NodeStatus::Running) {}
+
+    void start() override
+    {
+        root->reset();
+        last_status = NodeStatus::Running;
+    }
+
+    SectionStatus update() override
+    {
+        last_status = root->tick();
+        return last_status == NodeStatus::Running ? SectionStatus::Running : SectionStatus::Finished;
+    }
+
+    // 完了時の結果
+    NodeStatus getLastStatus()
+    {
+        return last_status;
+    }
+
+private:
+    IBehaviorNode *root;
+    NodeStatus last_status;
+};
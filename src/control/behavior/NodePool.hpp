@@ -0,0 +1,40 @@
+#pragma once
+#include <mbed.hpp>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// ビヘイビアツリーのノードを確保する静的メモリプール
+// ノードはプログラム終了まで解放しない前提で、ヒープを使わずに先頭から順に詰めて配置する。
+// Size: プールのバイト数 (コンパイル時に決める)
+template <size_t Size>
+class NodePool
+{
+public:
+    NodePool() : used(0) {}
+
+    // ノードを構築してポインタを返す。容量が足りなければ停止する。
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        size_t offset = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (offset + sizeof(T) > Size)
+        {
+            // assertと違ってNDEBUGでも消えない
+            error("NodePool: out of memory (%u + %u > %u bytes)\n", (unsigned)offset, (unsigned)sizeof(T), (unsigned)Size);
+        }
+
+        used = offset + sizeof(T);
+        return new (&buffer[offset]) T(std::forward<Args>(args)...);
+    }
+
+    // 使用済みのバイト数 (プールの大きさを決めるときに確認する)
+    size_t getUsedBytes() const
+    {
+        return used;
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char buffer[Size];
+    size_t used;
+};
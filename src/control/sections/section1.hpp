@@ -1,58 +1,63 @@
 #pragma once
 #include "control/ISection.hpp"
+#include "control/Await.hpp"
 #include "system/PositionController.hpp"
+#include "control/trajectories/section1_trajectory.hpp"
 #include "driver/ServoMotor.hpp"
 
+// 事前計算した軌道表 (section1_trajectory) を再生して移動する。
+// 軌道表の終端付近からはPositionControllerが終端を目標とした位置制御に引き継ぐ。
 class Section1 : public ISection
 {
 public:
-    Section1(std::unique_ptr<PositionController<5, 3>> &position_controller, Servo &servo, Position target_position)
-        : position_controller(position_controller), servo(servo), target_position(target_position) {};
+    Section1(std::unique_ptr<PositionController<5, 3>> &position_controller, Servo &servo)
+        : position_controller(position_controller), servo(servo),
+          trajectory_player(section1_trajectory, TRAJECTORY_POSITION_GAIN, TRAJECTORY_HEADING_GAIN), is_servo_up(false) {};
 
-    void action() override
+    void start() override
     {
-        position_controller->setTargetPosition(target_position);
-
-        Timer servo_timer;
-        bool is_servo_up = false;
+        trajectory_player.reset();
+        position_controller->followPath(&trajectory_player);
 
+        is_servo_up = false;
         servo.setAngles(0_deg);
-        servo_timer.start();
+        servo_timer.start(1s);
+    }
+
+    // 移動しながらサーボを上下させ、目標位置に着いたら完了
+    SectionStatus update() override
+    {
+        if (position_controller->isTargetReached())
+        {
+            return SectionStatus::Finished;
+        }
 
-        while (!isTargetPositionReached())
+        if (servo_timer.isElapsed())
         {
-            if (servo_timer.elapsed_time() >= 1s)
+            // サーボを上下
+            if (is_servo_up)
             {
-                // サーボを上下
-                if (is_servo_up)
-                {
-                    servo.setAngles(0_deg);
-                }
-                else
-                {
-                    servo.setAngles(45_deg);
-                }
-
-                is_servo_up = !is_servo_up;
-                servo_timer.reset();
+                servo.setAngles(0_deg);
+            }
+            else
+            {
+                servo.setAngles(45_deg);
             }
 
-            ThisThread::sleep_for(10ms);
+            is_servo_up = !is_servo_up;
+            servo_timer.start(1s);
         }
+
+        return SectionStatus::Running;
     }
 
 private:
-    bool isTargetPositionReached()
-    {
-        Position current_position = position_controller->getCurrentPosition();
-        Position error = target_position - current_position;
-
-        return (fabs(error.x.value) < 0.1 &&
-                fabs(error.y.value) < 0.1 &&
-                fabs(error.theta.value) < 0.1);
-    }
+    static constexpr float TRAJECTORY_POSITION_GAIN = 2.0f; // 軌道表からの位置の偏差に対するゲイン[1/s]
+    static constexpr float TRAJECTORY_HEADING_GAIN = 2.0f;  // 軌道表からの角度の偏差に対するゲイン[1/s]
 
     std::unique_ptr<PositionController<5, 3>> &position_controller;
     Servo &servo;
-    Position target_position;
+    TrajectoryPlayer trajectory_player;
+    AwaitTimer servo_timer;
+    bool is_servo_up;
 };
@@ -0,0 +1,252 @@
+#pragma once
+#include "system/TrajectoryPlayer.hpp"
+
+// tools/trajectory_plannerで生成。手で編集しないこと。
+// course: tools/trajectory_planner/courses/section1.txt
+// max_wheel_rps: 3.000, max_duty: 0.800, max_acceleration: 2.000 m/s^2, period: 0.050 s
+// duration: 12.072 s
+constexpr TrajectoryPoint section1_trajectory[] = {
+    {0.000f, {0.0000_m, 0.0000_m, 0.0000_rad}, {0.0000_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.050f, {0.0035_m, 0.0000_m, 0.0000_rad}, {0.1000_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.100f, {0.0100_m, 0.0000_m, 0.0000_rad}, {0.2000_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.150f, {0.0226_m, 0.0000_m, 0.0000_rad}, {0.3000_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.200f, {0.0400_m, 0.0000_m, 0.0000_rad}, {0.4000_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.250f, {0.0619_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.300f, {0.0845_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.350f, {0.1072_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.400f, {0.1298_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.450f, {0.1524_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.500f, {0.1750_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.550f, {0.1976_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.600f, {0.2202_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.650f, {0.2429_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.700f, {0.2655_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.750f, {0.2881_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.800f, {0.3107_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.850f, {0.3333_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.900f, {0.3560_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {0.950f, {0.3786_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.000f, {0.4012_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.050f, {0.4238_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.100f, {0.4464_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.150f, {0.4691_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.200f, {0.4917_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.250f, {0.5143_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.300f, {0.5369_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.350f, {0.5595_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.400f, {0.5822_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.450f, {0.6048_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.500f, {0.6274_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.550f, {0.6500_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.600f, {0.6726_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.650f, {0.6953_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.700f, {0.7179_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.750f, {0.7405_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.800f, {0.7631_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.850f, {0.7857_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.900f, {0.8084_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {1.950f, {0.8310_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.000f, {0.8536_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.050f, {0.8762_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.100f, {0.8988_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.150f, {0.9215_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.200f, {0.9441_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.250f, {0.9667_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.300f, {0.9893_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.350f, {1.0119_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.400f, {1.0346_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.450f, {1.0572_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.500f, {1.0798_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.550f, {1.1024_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.600f, {1.1250_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.650f, {1.1476_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.700f, {1.1703_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.750f, {1.1929_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.800f, {1.2155_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.850f, {1.2381_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.900f, {1.2607_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {2.950f, {1.2834_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.000f, {1.3060_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.050f, {1.3286_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.100f, {1.3512_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.150f, {1.3738_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.200f, {1.3965_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.250f, {1.4191_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.300f, {1.4417_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.350f, {1.4643_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.400f, {1.4869_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.450f, {1.5096_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.500f, {1.5322_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.550f, {1.5548_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.600f, {1.5774_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.650f, {1.6000_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.700f, {1.6227_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.750f, {1.6453_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.800f, {1.6679_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.850f, {1.6905_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.900f, {1.7131_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {3.950f, {1.7358_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.000f, {1.7584_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.050f, {1.7810_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.100f, {1.8036_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.150f, {1.8262_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.200f, {1.8489_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.250f, {1.8715_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.300f, {1.8941_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.350f, {1.9167_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.400f, {1.9393_m, 0.0000_m, 0.0000_rad}, {0.4524_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.450f, {1.9613_m, 0.0000_m, 0.0000_rad}, {0.4015_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.500f, {1.9788_m, 0.0000_m, 0.0000_rad}, {0.3015_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.550f, {1.9913_m, 0.0000_m, 0.0000_rad}, {0.2015_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.600f, {1.9987_m, 0.0000_m, 0.0000_rad}, {0.1015_m_s, 0.0000_m_s, 0.0000_rad_s}},
+    {4.650f, {2.0000_m, 0.0047_m, 0.0037_rad}, {0.0000_m_s, 0.1577_m_s, 0.1239_rad_s}},
+    {4.700f, {2.0000_m, 0.0150_m, 0.0118_rad}, {0.0000_m_s, 0.2577_m_s, 0.2024_rad_s}},
+    {4.750f, {2.0000_m, 0.0304_m, 0.0239_rad}, {0.0000_m_s, 0.3577_m_s, 0.2809_rad_s}},
+    {4.800f, {2.0000_m, 0.0506_m, 0.0398_rad}, {0.0000_m_s, 0.4308_m_s, 0.3383_rad_s}},
+    {4.850f, {2.0000_m, 0.0721_m, 0.0566_rad}, {0.0000_m_s, 0.4276_m_s, 0.3359_rad_s}},
+    {4.900f, {2.0000_m, 0.0934_m, 0.0733_rad}, {0.0000_m_s, 0.4247_m_s, 0.3335_rad_s}},
+    {4.950f, {2.0000_m, 0.1145_m, 0.0900_rad}, {0.0000_m_s, 0.4219_m_s, 0.3313_rad_s}},
+    {5.000f, {2.0000_m, 0.1356_m, 0.1065_rad}, {0.0000_m_s, 0.4192_m_s, 0.3292_rad_s}},
+    {5.050f, {2.0000_m, 0.1565_m, 0.1229_rad}, {0.0000_m_s, 0.4167_m_s, 0.3273_rad_s}},
+    {5.100f, {2.0000_m, 0.1772_m, 0.1392_rad}, {0.0000_m_s, 0.4143_m_s, 0.3254_rad_s}},
+    {5.150f, {2.0000_m, 0.1979_m, 0.1554_rad}, {0.0000_m_s, 0.4120_m_s, 0.3236_rad_s}},
+    {5.200f, {2.0000_m, 0.2184_m, 0.1716_rad}, {0.0000_m_s, 0.4099_m_s, 0.3220_rad_s}},
+    {5.250f, {2.0000_m, 0.2389_m, 0.1876_rad}, {0.0000_m_s, 0.4079_m_s, 0.3204_rad_s}},
+    {5.300f, {2.0000_m, 0.2592_m, 0.2036_rad}, {0.0000_m_s, 0.4060_m_s, 0.3189_rad_s}},
+    {5.350f, {2.0000_m, 0.2795_m, 0.2195_rad}, {0.0000_m_s, 0.4043_m_s, 0.3175_rad_s}},
+    {5.400f, {2.0000_m, 0.2997_m, 0.2354_rad}, {0.0000_m_s, 0.4026_m_s, 0.3162_rad_s}},
+    {5.450f, {2.0000_m, 0.3198_m, 0.2511_rad}, {0.0000_m_s, 0.4010_m_s, 0.3150_rad_s}},
+    {5.500f, {2.0000_m, 0.3398_m, 0.2669_rad}, {0.0000_m_s, 0.3996_m_s, 0.3138_rad_s}},
+    {5.550f, {2.0000_m, 0.3597_m, 0.2825_rad}, {0.0000_m_s, 0.3982_m_s, 0.3128_rad_s}},
+    {5.600f, {2.0000_m, 0.3796_m, 0.2981_rad}, {0.0000_m_s, 0.3970_m_s, 0.3118_rad_s}},
+    {5.650f, {2.0000_m, 0.3994_m, 0.3137_rad}, {0.0000_m_s, 0.3958_m_s, 0.3109_rad_s}},
+    {5.700f, {2.0000_m, 0.4192_m, 0.3292_rad}, {0.0000_m_s, 0.3947_m_s, 0.3100_rad_s}},
+    {5.750f, {2.0000_m, 0.4389_m, 0.3447_rad}, {0.0000_m_s, 0.3937_m_s, 0.3092_rad_s}},
+    {5.800f, {2.0000_m, 0.4586_m, 0.3601_rad}, {0.0000_m_s, 0.3928_m_s, 0.3085_rad_s}},
+    {5.850f, {2.0000_m, 0.4782_m, 0.3756_rad}, {0.0000_m_s, 0.3920_m_s, 0.3079_rad_s}},
+    {5.900f, {2.0000_m, 0.4978_m, 0.3909_rad}, {0.0000_m_s, 0.3913_m_s, 0.3073_rad_s}},
+    {5.950f, {2.0000_m, 0.5173_m, 0.4063_rad}, {0.0000_m_s, 0.3906_m_s, 0.3068_rad_s}},
+    {6.000f, {2.0000_m, 0.5368_m, 0.4216_rad}, {0.0000_m_s, 0.3901_m_s, 0.3064_rad_s}},
+    {6.050f, {2.0000_m, 0.5563_m, 0.4369_rad}, {0.0000_m_s, 0.3896_m_s, 0.3060_rad_s}},
+    {6.100f, {2.0000_m, 0.5758_m, 0.4522_rad}, {0.0000_m_s, 0.3892_m_s, 0.3057_rad_s}},
+    {6.150f, {2.0000_m, 0.5952_m, 0.4675_rad}, {0.0000_m_s, 0.3889_m_s, 0.3054_rad_s}},
+    {6.200f, {2.0000_m, 0.6147_m, 0.4828_rad}, {0.0000_m_s, 0.3886_m_s, 0.3052_rad_s}},
+    {6.250f, {2.0000_m, 0.6341_m, 0.4980_rad}, {0.0000_m_s, 0.3884_m_s, 0.3051_rad_s}},
+    {6.300f, {2.0000_m, 0.6535_m, 0.5133_rad}, {0.0000_m_s, 0.3884_m_s, 0.3050_rad_s}},
+    {6.350f, {2.0000_m, 0.6729_m, 0.5285_rad}, {0.0000_m_s, 0.3883_m_s, 0.3050_rad_s}},
+    {6.400f, {2.0000_m, 0.6924_m, 0.5438_rad}, {0.0000_m_s, 0.3884_m_s, 0.3051_rad_s}},
+    {6.450f, {2.0000_m, 0.7118_m, 0.5590_rad}, {0.0000_m_s, 0.3885_m_s, 0.3052_rad_s}},
+    {6.500f, {2.0000_m, 0.7312_m, 0.5743_rad}, {0.0000_m_s, 0.3888_m_s, 0.3053_rad_s}},
+    {6.550f, {2.0000_m, 0.7507_m, 0.5896_rad}, {0.0000_m_s, 0.3891_m_s, 0.3056_rad_s}},
+    {6.600f, {2.0000_m, 0.7701_m, 0.6048_rad}, {0.0000_m_s, 0.3894_m_s, 0.3059_rad_s}},
+    {6.650f, {2.0000_m, 0.7896_m, 0.6201_rad}, {0.0000_m_s, 0.3899_m_s, 0.3062_rad_s}},
+    {6.700f, {2.0000_m, 0.8091_m, 0.6355_rad}, {0.0000_m_s, 0.3904_m_s, 0.3066_rad_s}},
+    {6.750f, {2.0000_m, 0.8286_m, 0.6508_rad}, {0.0000_m_s, 0.3911_m_s, 0.3071_rad_s}},
+    {6.800f, {2.0000_m, 0.8482_m, 0.6662_rad}, {0.0000_m_s, 0.3918_m_s, 0.3077_rad_s}},
+    {6.850f, {2.0000_m, 0.8678_m, 0.6816_rad}, {0.0000_m_s, 0.3925_m_s, 0.3083_rad_s}},
+    {6.900f, {2.0000_m, 0.8875_m, 0.6970_rad}, {0.0000_m_s, 0.3934_m_s, 0.3090_rad_s}},
+    {6.950f, {2.0000_m, 0.9072_m, 0.7125_rad}, {0.0000_m_s, 0.3944_m_s, 0.3097_rad_s}},
+    {7.000f, {2.0000_m, 0.9269_m, 0.7280_rad}, {0.0000_m_s, 0.3954_m_s, 0.3106_rad_s}},
+    {7.050f, {2.0000_m, 0.9467_m, 0.7435_rad}, {0.0000_m_s, 0.3965_m_s, 0.3114_rad_s}},
+    {7.100f, {2.0000_m, 0.9664_m, 0.7590_rad}, {0.0000_m_s, 0.3756_m_s, 0.2950_rad_s}},
+    {7.150f, {2.0000_m, 0.9826_m, 0.7717_rad}, {0.0000_m_s, 0.2756_m_s, 0.2165_rad_s}},
+    {7.200f, {2.0000_m, 0.9938_m, 0.7806_rad}, {0.0000_m_s, 0.1756_m_s, 0.1379_rad_s}},
+    {7.250f, {2.0004_m, 1.0000_m, 0.7855_rad}, {0.0879_m_s, 0.0000_m_s, 0.0345_rad_s}},
+    {7.300f, {2.0073_m, 1.0000_m, 0.7883_rad}, {0.1879_m_s, 0.0000_m_s, 0.0738_rad_s}},
+    {7.350f, {2.0191_m, 1.0000_m, 0.7929_rad}, {0.2879_m_s, 0.0000_m_s, 0.1130_rad_s}},
+    {7.400f, {2.0360_m, 1.0000_m, 0.7995_rad}, {0.3879_m_s, 0.0000_m_s, 0.1523_rad_s}},
+    {7.450f, {2.0570_m, 1.0000_m, 0.8078_rad}, {0.4292_m_s, 0.0000_m_s, 0.1686_rad_s}},
+    {7.500f, {2.0784_m, 1.0000_m, 0.8162_rad}, {0.4284_m_s, 0.0000_m_s, 0.1682_rad_s}},
+    {7.550f, {2.0998_m, 1.0000_m, 0.8246_rad}, {0.4277_m_s, 0.0000_m_s, 0.1679_rad_s}},
+    {7.600f, {2.1212_m, 1.0000_m, 0.8330_rad}, {0.4269_m_s, 0.0000_m_s, 0.1677_rad_s}},
+    {7.650f, {2.1425_m, 1.0000_m, 0.8414_rad}, {0.4262_m_s, 0.0000_m_s, 0.1674_rad_s}},
+    {7.700f, {2.1638_m, 1.0000_m, 0.8497_rad}, {0.4256_m_s, 0.0000_m_s, 0.1671_rad_s}},
+    {7.750f, {2.1851_m, 1.0000_m, 0.8581_rad}, {0.4249_m_s, 0.0000_m_s, 0.1669_rad_s}},
+    {7.800f, {2.2063_m, 1.0000_m, 0.8664_rad}, {0.4243_m_s, 0.0000_m_s, 0.1666_rad_s}},
+    {7.850f, {2.2275_m, 1.0000_m, 0.8747_rad}, {0.4237_m_s, 0.0000_m_s, 0.1664_rad_s}},
+    {7.900f, {2.2487_m, 1.0000_m, 0.8830_rad}, {0.4232_m_s, 0.0000_m_s, 0.1662_rad_s}},
+    {7.950f, {2.2698_m, 1.0000_m, 0.8914_rad}, {0.4227_m_s, 0.0000_m_s, 0.1660_rad_s}},
+    {8.000f, {2.2909_m, 1.0000_m, 0.8996_rad}, {0.4222_m_s, 0.0000_m_s, 0.1658_rad_s}},
+    {8.050f, {2.3120_m, 1.0000_m, 0.9079_rad}, {0.4217_m_s, 0.0000_m_s, 0.1656_rad_s}},
+    {8.100f, {2.3331_m, 1.0000_m, 0.9162_rad}, {0.4213_m_s, 0.0000_m_s, 0.1654_rad_s}},
+    {8.150f, {2.3542_m, 1.0000_m, 0.9245_rad}, {0.4208_m_s, 0.0000_m_s, 0.1653_rad_s}},
+    {8.200f, {2.3752_m, 1.0000_m, 0.9327_rad}, {0.4205_m_s, 0.0000_m_s, 0.1651_rad_s}},
+    {8.250f, {2.3962_m, 1.0000_m, 0.9410_rad}, {0.4201_m_s, 0.0000_m_s, 0.1650_rad_s}},
+    {8.300f, {2.4172_m, 1.0000_m, 0.9492_rad}, {0.4198_m_s, 0.0000_m_s, 0.1648_rad_s}},
+    {8.350f, {2.4382_m, 1.0000_m, 0.9575_rad}, {0.4195_m_s, 0.0000_m_s, 0.1647_rad_s}},
+    {8.400f, {2.4592_m, 1.0000_m, 0.9657_rad}, {0.4192_m_s, 0.0000_m_s, 0.1646_rad_s}},
+    {8.450f, {2.4801_m, 1.0000_m, 0.9739_rad}, {0.4190_m_s, 0.0000_m_s, 0.1645_rad_s}},
+    {8.500f, {2.5010_m, 1.0000_m, 0.9822_rad}, {0.4187_m_s, 0.0000_m_s, 0.1644_rad_s}},
+    {8.550f, {2.5220_m, 1.0000_m, 0.9904_rad}, {0.4185_m_s, 0.0000_m_s, 0.1644_rad_s}},
+    {8.600f, {2.5429_m, 1.0000_m, 0.9986_rad}, {0.4184_m_s, 0.0000_m_s, 0.1643_rad_s}},
+    {8.650f, {2.5638_m, 1.0000_m, 1.0068_rad}, {0.4182_m_s, 0.0000_m_s, 0.1642_rad_s}},
+    {8.700f, {2.5847_m, 1.0000_m, 1.0150_rad}, {0.4181_m_s, 0.0000_m_s, 0.1642_rad_s}},
+    {8.750f, {2.6056_m, 1.0000_m, 1.0232_rad}, {0.4180_m_s, 0.0000_m_s, 0.1642_rad_s}},
+    {8.800f, {2.6265_m, 1.0000_m, 1.0314_rad}, {0.4180_m_s, 0.0000_m_s, 0.1641_rad_s}},
+    {8.850f, {2.6474_m, 1.0000_m, 1.0396_rad}, {0.4179_m_s, 0.0000_m_s, 0.1641_rad_s}},
+    {8.900f, {2.6683_m, 1.0000_m, 1.0478_rad}, {0.4179_m_s, 0.0000_m_s, 0.1641_rad_s}},
+    {8.950f, {2.6892_m, 1.0000_m, 1.0561_rad}, {0.4179_m_s, 0.0000_m_s, 0.1641_rad_s}},
+    {9.000f, {2.7101_m, 1.0000_m, 1.0643_rad}, {0.4180_m_s, 0.0000_m_s, 0.1641_rad_s}},
+    {9.050f, {2.7310_m, 1.0000_m, 1.0725_rad}, {0.4180_m_s, 0.0000_m_s, 0.1642_rad_s}},
+    {9.100f, {2.7519_m, 1.0000_m, 1.0807_rad}, {0.4181_m_s, 0.0000_m_s, 0.1642_rad_s}},
+    {9.150f, {2.7728_m, 1.0000_m, 1.0889_rad}, {0.4183_m_s, 0.0000_m_s, 0.1643_rad_s}},
+    {9.200f, {2.7938_m, 1.0000_m, 1.0971_rad}, {0.4184_m_s, 0.0000_m_s, 0.1643_rad_s}},
+    {9.250f, {2.8147_m, 1.0000_m, 1.1053_rad}, {0.4186_m_s, 0.0000_m_s, 0.1644_rad_s}},
+    {9.300f, {2.8356_m, 1.0000_m, 1.1135_rad}, {0.4188_m_s, 0.0000_m_s, 0.1645_rad_s}},
+    {9.350f, {2.8566_m, 1.0000_m, 1.1218_rad}, {0.4190_m_s, 0.0000_m_s, 0.1645_rad_s}},
+    {9.400f, {2.8775_m, 1.0000_m, 1.1300_rad}, {0.4193_m_s, 0.0000_m_s, 0.1646_rad_s}},
+    {9.450f, {2.8985_m, 1.0000_m, 1.1382_rad}, {0.4195_m_s, 0.0000_m_s, 0.1647_rad_s}},
+    {9.500f, {2.9195_m, 1.0000_m, 1.1465_rad}, {0.4198_m_s, 0.0000_m_s, 0.1649_rad_s}},
+    {9.550f, {2.9405_m, 1.0000_m, 1.1547_rad}, {0.4202_m_s, 0.0000_m_s, 0.1650_rad_s}},
+    {9.600f, {2.9615_m, 1.0000_m, 1.1630_rad}, {0.4205_m_s, 0.0000_m_s, 0.1651_rad_s}},
+    {9.650f, {2.9825_m, 1.0000_m, 1.1712_rad}, {0.4209_m_s, 0.0000_m_s, 0.1653_rad_s}},
+    {9.700f, {3.0036_m, 1.0000_m, 1.1795_rad}, {0.4213_m_s, 0.0000_m_s, 0.1655_rad_s}},
+    {9.750f, {3.0246_m, 1.0000_m, 1.1878_rad}, {0.4218_m_s, 0.0000_m_s, 0.1656_rad_s}},
+    {9.800f, {3.0457_m, 1.0000_m, 1.1961_rad}, {0.4222_m_s, 0.0000_m_s, 0.1658_rad_s}},
+    {9.850f, {3.0669_m, 1.0000_m, 1.2044_rad}, {0.4227_m_s, 0.0000_m_s, 0.1660_rad_s}},
+    {9.900f, {3.0880_m, 1.0000_m, 1.2127_rad}, {0.4233_m_s, 0.0000_m_s, 0.1662_rad_s}},
+    {9.950f, {3.1092_m, 1.0000_m, 1.2210_rad}, {0.4238_m_s, 0.0000_m_s, 0.1664_rad_s}},
+    {10.000f, {3.1304_m, 1.0000_m, 1.2293_rad}, {0.4244_m_s, 0.0000_m_s, 0.1667_rad_s}},
+    {10.050f, {3.1516_m, 1.0000_m, 1.2376_rad}, {0.4250_m_s, 0.0000_m_s, 0.1669_rad_s}},
+    {10.100f, {3.1729_m, 1.0000_m, 1.2460_rad}, {0.4257_m_s, 0.0000_m_s, 0.1672_rad_s}},
+    {10.150f, {3.1942_m, 1.0000_m, 1.2544_rad}, {0.4263_m_s, 0.0000_m_s, 0.1674_rad_s}},
+    {10.200f, {3.2155_m, 1.0000_m, 1.2627_rad}, {0.4271_m_s, 0.0000_m_s, 0.1677_rad_s}},
+    {10.250f, {3.2369_m, 1.0000_m, 1.2711_rad}, {0.4278_m_s, 0.0000_m_s, 0.1680_rad_s}},
+    {10.300f, {3.2583_m, 1.0000_m, 1.2795_rad}, {0.4286_m_s, 0.0000_m_s, 0.1683_rad_s}},
+    {10.350f, {3.2798_m, 1.0000_m, 1.2880_rad}, {0.4294_m_s, 0.0000_m_s, 0.1686_rad_s}},
+    {10.400f, {3.3013_m, 1.0000_m, 1.2964_rad}, {0.4302_m_s, 0.0000_m_s, 0.1689_rad_s}},
+    {10.450f, {3.3228_m, 1.0000_m, 1.3049_rad}, {0.4311_m_s, 0.0000_m_s, 0.1693_rad_s}},
+    {10.500f, {3.3444_m, 1.0000_m, 1.3133_rad}, {0.4320_m_s, 0.0000_m_s, 0.1696_rad_s}},
+    {10.550f, {3.3660_m, 1.0000_m, 1.3218_rad}, {0.4329_m_s, 0.0000_m_s, 0.1700_rad_s}},
+    {10.600f, {3.3877_m, 1.0000_m, 1.3303_rad}, {0.4339_m_s, 0.0000_m_s, 0.1704_rad_s}},
+    {10.650f, {3.4094_m, 1.0000_m, 1.3389_rad}, {0.4349_m_s, 0.0000_m_s, 0.1708_rad_s}},
+    {10.700f, {3.4311_m, 1.0000_m, 1.3474_rad}, {0.4359_m_s, 0.0000_m_s, 0.1712_rad_s}},
+    {10.750f, {3.4530_m, 1.0000_m, 1.3560_rad}, {0.4370_m_s, 0.0000_m_s, 0.1716_rad_s}},
+    {10.800f, {3.4749_m, 1.0000_m, 1.3646_rad}, {0.4381_m_s, 0.0000_m_s, 0.1721_rad_s}},
+    {10.850f, {3.4968_m, 1.0000_m, 1.3732_rad}, {0.4393_m_s, 0.0000_m_s, 0.1725_rad_s}},
+    {10.900f, {3.5188_m, 1.0000_m, 1.3818_rad}, {0.4405_m_s, 0.0000_m_s, 0.1730_rad_s}},
+    {10.950f, {3.5408_m, 1.0000_m, 1.3905_rad}, {0.4417_m_s, 0.0000_m_s, 0.1735_rad_s}},
+    {11.000f, {3.5630_m, 1.0000_m, 1.3992_rad}, {0.4430_m_s, 0.0000_m_s, 0.1740_rad_s}},
+    {11.050f, {3.5851_m, 1.0000_m, 1.4079_rad}, {0.4443_m_s, 0.0000_m_s, 0.1745_rad_s}},
+    {11.100f, {3.6074_m, 1.0000_m, 1.4166_rad}, {0.4457_m_s, 0.0000_m_s, 0.1750_rad_s}},
+    {11.150f, {3.6297_m, 1.0000_m, 1.4254_rad}, {0.4471_m_s, 0.0000_m_s, 0.1756_rad_s}},
+    {11.200f, {3.6521_m, 1.0000_m, 1.4342_rad}, {0.4486_m_s, 0.0000_m_s, 0.1762_rad_s}},
+    {11.250f, {3.6746_m, 1.0000_m, 1.4430_rad}, {0.4501_m_s, 0.0000_m_s, 0.1767_rad_s}},
+    {11.300f, {3.6971_m, 1.0000_m, 1.4519_rad}, {0.4516_m_s, 0.0000_m_s, 0.1774_rad_s}},
+    {11.350f, {3.7197_m, 1.0000_m, 1.4607_rad}, {0.4532_m_s, 0.0000_m_s, 0.1780_rad_s}},
+    {11.400f, {3.7424_m, 1.0000_m, 1.4697_rad}, {0.4549_m_s, 0.0000_m_s, 0.1786_rad_s}},
+    {11.450f, {3.7652_m, 1.0000_m, 1.4786_rad}, {0.4566_m_s, 0.0000_m_s, 0.1793_rad_s}},
+    {11.500f, {3.7881_m, 1.0000_m, 1.4876_rad}, {0.4583_m_s, 0.0000_m_s, 0.1800_rad_s}},
+    {11.550f, {3.8111_m, 1.0000_m, 1.4966_rad}, {0.4601_m_s, 0.0000_m_s, 0.1807_rad_s}},
+    {11.600f, {3.8341_m, 1.0000_m, 1.5056_rad}, {0.4620_m_s, 0.0000_m_s, 0.1814_rad_s}},
+    {11.650f, {3.8573_m, 1.0000_m, 1.5147_rad}, {0.4639_m_s, 0.0000_m_s, 0.1822_rad_s}},
+    {11.700f, {3.8805_m, 1.0000_m, 1.5239_rad}, {0.4659_m_s, 0.0000_m_s, 0.1830_rad_s}},
+    {11.750f, {3.9038_m, 1.0000_m, 1.5330_rad}, {0.4679_m_s, 0.0000_m_s, 0.1838_rad_s}},
+    {11.800f, {3.9273_m, 1.0000_m, 1.5422_rad}, {0.4701_m_s, 0.0000_m_s, 0.1846_rad_s}},
+    {11.850f, {3.9506_m, 1.0000_m, 1.5514_rad}, {0.4443_m_s, 0.0000_m_s, 0.1745_rad_s}},
+    {11.900f, {3.9703_m, 1.0000_m, 1.5592_rad}, {0.3443_m_s, 0.0000_m_s, 0.1352_rad_s}},
+    {11.950f, {3.9851_m, 1.0000_m, 1.5649_rad}, {0.2443_m_s, 0.0000_m_s, 0.0959_rad_s}},
+    {12.000f, {3.9948_m, 1.0000_m, 1.5687_rad}, {0.1443_m_s, 0.0000_m_s, 0.0567_rad_s}},
+    {12.050f, {3.9984_m, 1.0000_m, 1.5702_rad}, {0.0443_m_s, 0.0000_m_s, 0.0174_rad_s}},
+    {12.072f, {4.0000_m, 1.0000_m, 1.5708_rad}, {0.0000_m_s, 0.0000_m_s, 0.0000_rad_s}},
+};
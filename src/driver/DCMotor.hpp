@@ -1,50 +1,223 @@
 #pragma once
 #include <mbed.hpp>
 #include <cmath>
+#include "pwm/MbedPwmBackend.hpp"
+#include "pwm/Stm32PwmBackend.hpp"
+#include "units/units.hpp"
 
-class DCMotor
+// duty比の整形 (既定値はすべて無効で、指令をそのまま出力する)
+struct DCMotorDriveConfig
+{
+    float max_slew_rate = 0.0f; // duty比の変化率の上限[1/s] (0で無効)。+1 -> -1 の反転を数周期かけて行い、突入電流を抑える。
+    float deadband = 0.0f;      // これより小さい指令は0にする (停止付近のチャタリング防止)。MAX_DEADBANDまでに制限する。
+    float stiction_duty = 0.0f; // 静止摩擦を越えるのに必要なduty比。deadband以上の指令はこの値から1までに割り当てる。
+};
+
+// モーターの電気モデル (電流制限用、既定値は無効)
+// 電流 I = (duty * V - Ke * ω) / R をduty比と回転速度から推定する。シャント抵抗なしで電流を制限できる。
+struct DCMotorModel
+{
+    float supply_voltage = 0.0f;    // 電源電圧[V] (0でモデル無効)
+    float resistance = 1.0f;        // 巻線抵抗[Ω]
+    float back_emf_constant = 0.0f; // 逆起電力定数[V/(rad/s)] (モーター軸)
+    float max_current = 0.0f;       // 電流の上限[A] (0で制限しない)
+};
+
+// PwmBackend: PWMの出力方法 (MbedPwmBackend, Stm32PwmBackend, FakePwmBackend)
+template <typename PwmBackend>
+class DCMotorT
 {
 public:
-    DCMotor(PinName pwm_pin, PinName dir_pin, bool is_clockwise = true, float pwm_freq = 16000 /* Hz */)
-        : pwm(pwm_pin), dir(dir_pin), is_clockwise(is_clockwise), last_duty(0.0f)
+    DCMotorT(PinName pwm_pin, PinName dir_pin, bool is_clockwise = true, float pwm_freq = 16000 /* Hz */)
+        : pwm(pwm_pin, chrono::microseconds((int)(1000000 / pwm_freq))), dir(dir_pin), is_clockwise(is_clockwise), last_duty(0.0f), dir_state(FORWARD_DIR_STATE),
+          pwm_period((int)(1000000 / pwm_freq)), is_reversing(false), applied_duty(0.0f), speed(0.0f), last_update(HighResClock::now())
     {
-        pwm.period(1.0 / pwm_freq); // PWM周期を設定
-        stop();                     // デューティ比を初期化
+        dir.write(dir_state);
+        stop(); // デューティ比を初期化
     }
 
     // duty比を設定
+    // 整形(デッドバンド、電流制限、変化率制限)を設定していれば、それを通した値を出力する。
+    // 回転方向が変わるときは、duty比0をREVERSE_HOLD_PERIODS周期以上出力してから次の呼び出しで向きを変える
+    // (その間のgetAppliedDutyは0)。制御周期で呼ぶなら、反転は1制御周期遅れる。
     void setDuty(float duty)
     {
         last_duty = duty;
+        write(shapeDuty(duty));
+    }
 
-        if (!is_clockwise)
+    // duty比を取得 (指令値)
+    float getDuty() const
+    {
+        return last_duty;
+    }
+
+    // 実際に出力しているduty比 (整形後)
+    float getAppliedDuty() const
+    {
+        return applied_duty;
+    }
+
+    // 整形を通さずにすぐ止める
+    void stop()
+    {
+        last_duty = 0.0f;
+        write(0.0f);
+    }
+
+    void setDriveConfig(DCMotorDriveConfig config)
+    {
+        // deadbandが1だとshapeDutyで0除算になるので、範囲に収める
+        config.max_slew_rate = fmax(config.max_slew_rate, 0.0f);
+        config.deadband = fmax(0.0f, fmin(config.deadband, MAX_DEADBAND));
+        config.stiction_duty = fmax(0.0f, fmin(config.stiction_duty, 1.0f));
+        drive_config = config;
+        last_update = HighResClock::now();
+    }
+
+    void setModel(DCMotorModel model)
+    {
+        this->model = model;
+    }
+
+    // エンコーダーで測ったモーター軸の回転速度を渡す (電流の推定に使う)
+    // 正のduty比で回る向きを正とする。
+    void setMeasuredSpeed(RadPerSecond speed)
+    {
+        this->speed = speed.value;
+    }
+
+    // 出力中のduty比と回転速度から推定した電流[A] (モデル無効なら0)
+    float getEstimatedCurrent() const
+    {
+        if (model.supply_voltage <= 0.0f)
         {
-            duty = -duty; // 逆回転の場合はデューティ比を反転
+            return 0.0f;
         }
 
-        pwm.write(fabs(duty));                                       // デューティ比を設定
-        dir.write(duty > 0 ? FORWARD_DIR_STATE : REVERSE_DIR_STATE); // 回転方向を設定
+        return (applied_duty * model.supply_voltage - model.back_emf_constant * speed) / model.resistance;
     }
 
-    // duty比を取得
-    float getDuty() const
+    // テスト・計測用
+    PwmBackend &getPwmBackend()
     {
-        return last_duty;
+        return pwm;
     }
 
-    void stop()
+    // テスト・計測用 (方向ピンに出力中の値)
+    int readDirPin()
     {
-        setDuty(0.0);
+        return dir.read();
     }
 
 private:
-    PwmOut pwm;
+    PwmBackend pwm;
     DigitalOut dir;
     // 回転方向
     bool is_clockwise;
     float last_duty;
+    int dir_state; // 方向ピンに出力中の値 (ピンを読み返さずに済むよう保持)
+
+    // 回転方向の切り替え
+    // CCRはプリロードされるので、0を書いてもPWM周期の境界(更新イベント)までは前のduty比で駆動し続ける。
+    // 0が反映されてから1周期以上経ったことを時刻で確かめてから方向ピンを変える。
+    static constexpr int REVERSE_HOLD_PERIODS = 2; // 更新イベントまでの最大1周期 + 0で保持する1周期
+    chrono::microseconds pwm_period;
+    bool is_reversing;                    // 向きを変えるためにduty比0で保持中
+    HighResClock::time_point reverse_start; // duty比0を書いた時刻
+
+    DCMotorDriveConfig drive_config;
+    DCMotorModel model;
+    float applied_duty;
+    float speed; // モーター軸の回転速度[rad/s]
+    HighResClock::time_point last_update;
+
+    static constexpr float MAX_DEADBAND = 0.9f;
 
     // モータードライバーの仕様に合わせて定義（例：0が正転、1が逆転）
     static constexpr int FORWARD_DIR_STATE = 0;
     static constexpr int REVERSE_DIR_STATE = 1;
+
+    // 指令値 -> 出力するduty比
+    float shapeDuty(float duty)
+    {
+        // デッドバンドと静止摩擦の補償
+        float magnitude = fabs(duty);
+        if (magnitude <= drive_config.deadband)
+        {
+            duty = 0.0f;
+        }
+        else if (drive_config.stiction_duty > 0.0f)
+        {
+            float ratio = (fmin(magnitude, 1.0f) - drive_config.deadband) / (1.0f - drive_config.deadband);
+            duty = copysign(drive_config.stiction_duty + (1.0f - drive_config.stiction_duty) * ratio, duty);
+        }
+
+        // 電流制限: |duty * V - Ke * ω| <= R * I_max となるduty比の範囲に収める
+        if (model.supply_voltage > 0.0f && model.max_current > 0.0f)
+        {
+            float back_emf_duty = model.back_emf_constant * speed / model.supply_voltage;
+            float margin = model.resistance * model.max_current / model.supply_voltage;
+            duty = fmax(back_emf_duty - margin, fmin(back_emf_duty + margin, duty));
+        }
+
+        // 変化率制限
+        if (drive_config.max_slew_rate > 0.0f)
+        {
+            HighResClock::time_point now = HighResClock::now();
+            float max_step = drive_config.max_slew_rate * chrono::duration<float>(now - last_update).count();
+            last_update = now;
+            duty = applied_duty + fmax(-max_step, fmin(max_step, duty - applied_duty));
+        }
+
+        return duty;
+    }
+
+    void write(float duty)
+    {
+        applied_duty = duty;
+
+        if (!is_clockwise)
+        {
+            duty = -duty; // 逆回転の場合はデューティ比を反転
+        }
+
+        // duty比0では向きを変えない
+        int next_dir_state = duty > 0 ? FORWARD_DIR_STATE : duty < 0 ? REVERSE_DIR_STATE
+                                                                      : dir_state;
+        if (next_dir_state == dir_state)
+        {
+            is_reversing = false;
+        }
+        else
+        {
+            HighResClock::time_point now = HighResClock::now();
+            if (!is_reversing)
+            {
+                // まずduty比0にする。向きは次の呼び出しで変える。
+                is_reversing = true;
+                reverse_start = now;
+                applied_duty = 0.0f;
+                pwm.write(0.0f);
+                return;
+            }
+
+            if (now - reverse_start < pwm_period * REVERSE_HOLD_PERIODS)
+            {
+                // 0がまだ出力に反映されていないかもしれない
+                applied_duty = 0.0f;
+                return;
+            }
+
+            // 0を1周期以上出力しているので、PWMの途中でも方向ピンを変えてよい
+            is_reversing = false;
+            dir_state = next_dir_state;
+            dir.write(dir_state); // 回転方向を設定
+        }
+
+        pwm.write(fabs(duty)); // デューティ比を設定
+    }
 };
+
+// レジスタを直接書く場合は DCMotorT<Stm32PwmBackend> にする
+using DCMotor = DCMotorT<MbedPwmBackend>;
@@ -1,5 +1,6 @@
 #pragma once
 #include <mbed.hpp>
+#include "units/fastMath.hpp"
 
 /**
  * @brief 3軸データを格納する構造体
@@ -121,13 +122,8 @@ public:
         float yaw = yaw_ - yaw_offset_;
         data_mutex_.unlock();
 
-        // -180度から180度の範囲に正規化
-        while (yaw > 180.0)
-            yaw -= 360.0;
-        while (yaw <= -180.0)
-            yaw += 360.0;
-
-        return yaw;
+        // -180度から180度の範囲に正規化 (360度の倍数を丸めで求めるので、値によらず一定時間)
+        return FastMath::wrapDegree(yaw);
     }
 
     /**
@@ -209,6 +205,17 @@ public:
         printf("Yaw offset reset to: %.2f degrees\n", yaw_offset_);
     }
 
+    /**
+     * @brief センサーが出力したヨー角を設定する（シミュレーション・ログ再生用）
+     * @param yaw ヨー角 [deg] (BNO055の出力と同じく0.0 ~ 360.0)
+     */
+    void setYaw(float yaw)
+    {
+        data_mutex_.lock();
+        yaw_ = yaw;
+        data_mutex_.unlock();
+    }
+
 private:
     // BNO055レジスタアドレス定義
     static constexpr uint8_t BNO055_ADDRESS = 0x28 << 1; // I2Cアドレス（7bitを8bitに変換）
@@ -1,5 +1,15 @@
 #pragma once
 #include <mbed.hpp>
+#include <optional>
+
+/**
+ * @brief リミットスイッチの状態変化イベント
+ */
+struct LimitSwitchEvent
+{
+    bool pressed;                       // true: 押された, false: 離された
+    HighResClock::time_point timestamp; // 最初のエッジを検出した時刻
+};
 
 /**
  * @brief OMRON SS-10GL13 マイクロスイッチドライバクラス
@@ -21,7 +31,8 @@ public:
      * @brief コンストラクタ
      * @param pin SS-10GL13のCOM端子を接続するMbedピン
      */
-    LimitSwitch(PinName pin) : digitalIn(pin), lastState(false), currentState(false), lastEdgeState(false)
+    LimitSwitch(PinName pin) : pin(pin), digitalIn(pin), lastState(false), currentState(false), lastEdgeState(false),
+                               interruptState(false), isLockedOut(false), pressCount(0), lastPressCount(0), eventHead(0), eventTail(0), eventSignal(0)
     {
         debounceTimer.start();
     }
@@ -56,6 +67,63 @@ public:
         debounceTimer.reset();
     }
 
+    /**
+     * @brief 割り込みモードを有効化
+     *
+     * init()の後に呼ぶ。以降はポーリングではなくInterruptInのエッジで状態を確定する。
+     * - 最初のエッジの時刻を割り込み内で記録し、すぐに状態を確定 (検出遅れはマイクロ秒単位)
+     * - その後DEBOUNCE_TIMEの間はエッジを無視 (ロックアウト)
+     * - ロックアウト明けに状態が変わっていれば、その変化も確定
+     * 確定した変化はsubscribeした処理に通知スレッドから通知する。
+     * 通知スレッドは割り込みモードの全スイッチで1つを共有する (スタックはDISPATCH_STACK_SIZE)。
+     *
+     * @note STM32のEXTIは同じピン番号で1本しかない。他のInterruptIn(エンコーダーなど)と
+     *       ピン番号が重なるスイッチでは使えない。
+     */
+    void enableInterrupt()
+    {
+        if (interruptIn)
+        {
+            return;
+        }
+
+        interruptIn.emplace(pin);
+        interruptIn->mode(PullUp);
+        interruptState = interruptIn->read();
+
+        registerDispatch();
+
+        interruptIn->rise(callback(this, &LimitSwitch::onEdge));
+        interruptIn->fall(callback(this, &LimitSwitch::onEdge));
+    }
+
+    /**
+     * @brief 状態変化の通知先を登録 (割り込みモード用)
+     *
+     * 通知は割り込みではなく通知スレッドから呼ばれるので、Mutexを使う処理(オドメトリの補正など)も登録できる。
+     * 通知スレッドは全スイッチで共有しているので、中で長く待たないこと。
+     *
+     * @param subscriber 状態変化時に呼ばれる処理
+     * @return true: 登録成功, false: 登録数の上限(MAX_SUBSCRIBERS)に達している
+     */
+    bool subscribe(Callback<void(LimitSwitchEvent)> subscriber)
+    {
+        subscriberMutex.lock();
+        bool isRegistered = false;
+        for (Callback<void(LimitSwitchEvent)> &slot : subscribers)
+        {
+            if (!slot)
+            {
+                slot = subscriber;
+                isRegistered = true;
+                break;
+            }
+        }
+        subscriberMutex.unlock();
+
+        return isRegistered;
+    }
+
     /**
      * @brief スイッチ押下状態取得
      *
@@ -65,6 +133,12 @@ public:
      */
     bool isPressed()
     {
+        // 割り込みモードでは割り込みで確定した状態を返す
+        if (interruptIn)
+        {
+            return interruptState;
+        }
+
         // 生入力値取得
         bool rawState = digitalIn.read();
 
@@ -82,6 +156,15 @@ public:
      */
     bool isPressedEdge()
     {
+        // 割り込みモードでは前回の呼び出し以降に押されたかを返す (ポーリング間の押下も取りこぼさない)
+        if (interruptIn)
+        {
+            uint32_t count = pressCount;
+            bool edge = count != lastPressCount;
+            lastPressCount = count;
+            return edge;
+        }
+
         bool currentPressed = isPressed();
 
         // 立ち上がりエッジ検出 (false → true)
@@ -103,17 +186,174 @@ public:
         return digitalIn.read();
     }
 
+    static constexpr int MAX_SUBSCRIBERS = 4;          // 通知先の最大数
+    static constexpr int MAX_INTERRUPT_SWITCHES = 8;   // 割り込みモードにできるスイッチの最大数
+    static constexpr uint32_t DISPATCH_STACK_SIZE = 1536; // 通知スレッドのスタック[B] (通知先の処理が深くなるなら増やす)
+
 private:
+    PinName pin;
     DigitalIn digitalIn; // デジタル入力ピン
     bool lastState;      // 前回のデバウンス後状態
     bool currentState;   // 現在のデバウンス後状態
     bool lastEdgeState;  // エッジ検出用前回状態
     Timer debounceTimer; // デバウンス用タイマー
 
+    // 割り込みモード用
+    std::optional<InterruptIn> interruptIn; // enableInterrupt()まで構築しない (EXTIの競合を避けるため)
+    Timeout lockoutTimeout;                 // ロックアウト終了用のハードウェアタイマー
+    volatile bool interruptState;           // 割り込みで確定した状態
+    volatile bool isLockedOut;              // ロックアウト中
+    volatile uint32_t pressCount;           // 押された回数 (isPressedEdge用)
+    uint32_t lastPressCount;                // isPressedEdgeで前回読んだ押された回数
+
+    // 割り込み -> 通知スレッドのイベントキュー (割り込みが書き込み、スレッドが読み出す)
+    static constexpr uint32_t EVENT_QUEUE_SIZE = 8;
+    LimitSwitchEvent events[EVENT_QUEUE_SIZE];
+    volatile uint32_t eventHead; // 次に書き込む位置 (割り込みのみが更新)
+    volatile uint32_t eventTail; // 次に読み出す位置 (スレッドのみが更新)
+    uint32_t eventSignal;        // 通知スレッドに知らせるフラグ (スイッチごとに1ビット)
+
+    // 全スイッチで共有する通知スレッド
+    static inline Thread dispatchThread{osPriorityNormal, DISPATCH_STACK_SIZE};
+    static inline EventFlags dispatchFlags;
+    static inline Mutex dispatchMutex;
+    static inline LimitSwitch *interruptSwitches[MAX_INTERRUPT_SWITCHES] = {};
+    static inline int interruptSwitchCount = 0;
+
+    Mutex subscriberMutex;
+    Callback<void(LimitSwitchEvent)> subscribers[MAX_SUBSCRIBERS];
+
     // SS-10GL13に最適化された定数
     static constexpr chrono::milliseconds DEBOUNCE_TIME = 30ms;   // デバウンス時間
     static constexpr chrono::milliseconds STABILIZE_TIME = 100ms; // 初期化時安定化時間
 
+    /**
+     * @brief エッジ割り込み (ISR)
+     */
+    void onEdge()
+    {
+        // バウンス中のエッジは無視
+        if (isLockedOut)
+        {
+            return;
+        }
+
+        HighResClock::time_point now = HighResClock::now();
+        bool rawState = interruptIn->read();
+        if (rawState == interruptState)
+        {
+            return;
+        }
+
+        commitState(rawState, now);
+    }
+
+    /**
+     * @brief ロックアウト終了 (ISR)
+     */
+    void onLockoutEnd()
+    {
+        isLockedOut = false;
+
+        // ロックアウト中に状態が変わっていれば、その変化を確定
+        bool rawState = interruptIn->read();
+        if (rawState != interruptState)
+        {
+            commitState(rawState, HighResClock::now());
+        }
+    }
+
+    /**
+     * @brief 状態を確定してイベントを積み、ロックアウトを開始 (ISR)
+     */
+    void commitState(bool rawState, HighResClock::time_point timestamp)
+    {
+        interruptState = rawState;
+        if (rawState)
+        {
+            pressCount = pressCount + 1;
+        }
+
+        // キューが一杯なら最新のイベントを捨てる (状態自体はinterruptStateに残る)
+        uint32_t head = eventHead;
+        if (head - eventTail < EVENT_QUEUE_SIZE)
+        {
+            events[head % EVENT_QUEUE_SIZE] = {rawState, timestamp};
+            eventHead = head + 1;
+            dispatchFlags.set(eventSignal);
+        }
+
+        isLockedOut = true;
+        lockoutTimeout.attach(callback(this, &LimitSwitch::onLockoutEnd), DEBOUNCE_TIME);
+    }
+
+    /**
+     * @brief 共有の通知スレッドに登録する (最初のスイッチでスレッドを起動)
+     */
+    void registerDispatch()
+    {
+        dispatchMutex.lock();
+
+        if (interruptSwitchCount >= MAX_INTERRUPT_SWITCHES)
+        {
+            error("LimitSwitch: more than %d switches in interrupt mode\n", MAX_INTERRUPT_SWITCHES);
+        }
+
+        eventSignal = 1u << interruptSwitchCount;
+        interruptSwitches[interruptSwitchCount] = this;
+        interruptSwitchCount++;
+
+        if (interruptSwitchCount == 1)
+        {
+            dispatchThread.start(callback(&LimitSwitch::dispatchAll));
+        }
+
+        dispatchMutex.unlock();
+    }
+
+    /**
+     * @brief 全スイッチのイベントを通知先に配送するスレッド
+     */
+    static void dispatchAll()
+    {
+        const uint32_t allSignals = (1u << MAX_INTERRUPT_SWITCHES) - 1;
+
+        while (true)
+        {
+            uint32_t signals = dispatchFlags.wait_any(allSignals);
+
+            for (int i = 0; i < MAX_INTERRUPT_SWITCHES; i++)
+            {
+                if (signals & (1u << i))
+                {
+                    interruptSwitches[i]->dispatchEvents();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief このスイッチのイベントを通知先に配送する (通知スレッドから呼ばれる)
+     */
+    void dispatchEvents()
+    {
+        while (eventTail != eventHead)
+        {
+            LimitSwitchEvent event = events[eventTail % EVENT_QUEUE_SIZE];
+            eventTail = eventTail + 1;
+
+            subscriberMutex.lock();
+            for (Callback<void(LimitSwitchEvent)> &subscriber : subscribers)
+            {
+                if (subscriber)
+                {
+                    subscriber(event);
+                }
+            }
+            subscriberMutex.unlock();
+        }
+    }
+
     /**
      * @brief SS-10GL13専用デバウンス処理
      *
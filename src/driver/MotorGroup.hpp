@@ -0,0 +1,69 @@
+#pragma once
+#include <mbed.hpp>
+#include "DCMotor.hpp"
+
+// 複数のDCモーターのduty比をまとめて反映する
+// duty比を1つずつsetDutyすると、間にスレッドの切り替えや割り込みが入って車輪ごとに反映される時刻がずれる。
+// stageでduty比を溜めておき、commitでクリティカルセクションの中で一度に書き込む。
+// Stm32PwmBackendのモーターならCCRのプリロードにより、同じタイマーのチャンネルは次のPWM周期の境界で同時に切り替わる。
+// N: モーターの数, Motor: DCMotorT<PwmBackend>
+template <int N, typename Motor = DCMotor>
+class MotorGroup
+{
+public:
+    MotorGroup(const array<Motor *, N> &motors) : motors(motors), is_staged(false)
+    {
+        staged_duty.fill(0.0f);
+    }
+
+    // index番目のモーターのduty比を予約する (commitまで反映しない)
+    void stage(int index, float duty)
+    {
+        staged_duty[index] = duty;
+        is_staged = true;
+    }
+
+    // 全モーターのduty比を予約する (commitまで反映しない)
+    void stage(const array<float, N> &duty)
+    {
+        staged_duty = duty;
+        is_staged = true;
+    }
+
+    // 予約したduty比をまとめて反映する
+    void commit()
+    {
+        if (!is_staged)
+        {
+            return;
+        }
+
+        {
+            CriticalSectionLock lock;
+            for (int i = 0; i < N; i++)
+            {
+                motors[i]->setDuty(staged_duty[i]);
+            }
+        }
+
+        is_staged = false;
+    }
+
+    // 全モーターをまとめて止める
+    void stop()
+    {
+        staged_duty.fill(0.0f);
+        is_staged = true;
+        commit();
+    }
+
+    float getStagedDuty(int index) const
+    {
+        return staged_duty[index];
+    }
+
+private:
+    array<Motor *, N> motors;
+    array<float, N> staged_duty;
+    bool is_staged;
+};
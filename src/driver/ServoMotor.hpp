@@ -1,26 +1,28 @@
 #pragma once
 #include <mbed.hpp>
+#include <cassert>
 #include <cmath>
 #include "units/units.hpp"
+#include "pwm/MbedPwmBackend.hpp"
+#include "pwm/Stm32PwmBackend.hpp"
 
-class Servo
+// PwmBackend: PWMの出力方法 (MbedPwmBackend, Stm32PwmBackend, FakePwmBackend)
+template <typename PwmBackend>
+class ServoT
 {
 public:
-    PwmOut pwm;
+    PwmBackend pwm;
     chrono::microseconds min_pulse_width;
     chrono::microseconds max_pulse_width;
 
-    Servo(PinName pwm_pin, chrono::microseconds min_pulse_width, chrono::microseconds max_pulse_width, chrono::milliseconds pwm_period = 20ms)
-        : pwm(pwm_pin), min_pulse_width(min_pulse_width), max_pulse_width(max_pulse_width)
-    {
-        pwm.period_ms(pwm_period.count());
-    }
+    ServoT(PinName pwm_pin, chrono::microseconds min_pulse_width, chrono::microseconds max_pulse_width, chrono::milliseconds pwm_period = 20ms)
+        : pwm(pwm_pin, pwm_period), min_pulse_width(min_pulse_width), max_pulse_width(max_pulse_width) {}
 
     // @param pulse_width chrono::microseconds 目標のパルス幅[us]。
     void setPulseWidth(chrono::microseconds pulse_width)
     {
         assert(min_pulse_width <= pulse_width && pulse_width <= max_pulse_width);
-        pwm.pulsewidth_us(pulse_width.count());
+        pwm.writePulseWidth(pulse_width);
     }
 
     // @param angles Radian 目標の角度
@@ -36,3 +38,6 @@ public:
         setPulseWidth(pulse_width);
     }
 };
+
+// レジスタを直接書く場合は ServoT<Stm32PwmBackend> にする
+using Servo = ServoT<MbedPwmBackend>;
@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// ホストでの確認用のPWMバックエンド
+// タイマーのレジスタ(ARR, CCRのプリロードと実際の値)を模擬し、書き込みと更新イベントを数える。
+// 実機のタイマーと同じく、writeはプリロードに書くだけで、updateEventを呼ぶまで出力(active)は変わらない。
+class FakePwmBackend
+{
+public:
+    static constexpr uint32_t COUNTS_PER_US = 90; // 模擬するタイマーのクロック (90MHz)
+
+    template <typename Pin>
+    FakePwmBackend(Pin, std::chrono::microseconds period)
+        : period_counts((uint32_t)period.count() * COUNTS_PER_US), duty_scale((float)period_counts),
+          preload_compare(0), active_compare(0), write_count(0), update_count(0) {}
+
+    // @param duty 0~1
+    void write(float duty)
+    {
+        preload_compare = (uint32_t)(duty * duty_scale);
+        write_count++;
+    }
+
+    void writePulseWidth(std::chrono::microseconds pulse_width)
+    {
+        preload_compare = (uint32_t)pulse_width.count() * COUNTS_PER_US;
+        write_count++;
+    }
+
+    // タイマーの更新イベント (PWM周期の境界) を模擬する
+    void updateEvent()
+    {
+        active_compare = preload_compare;
+        update_count++;
+    }
+
+    uint32_t getPeriodCounts() const { return period_counts; }
+    uint32_t getPreloadCompare() const { return preload_compare; }
+    uint32_t getActiveCompare() const { return active_compare; }
+    uint32_t getWriteCount() const { return write_count; }
+    uint32_t getUpdateCount() const { return update_count; }
+
+private:
+    uint32_t period_counts;
+    float duty_scale;
+    uint32_t preload_compare;
+    uint32_t active_compare;
+    uint32_t write_count;
+    uint32_t update_count;
+};
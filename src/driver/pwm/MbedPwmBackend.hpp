@@ -0,0 +1,27 @@
+#pragma once
+#include <mbed.hpp>
+
+// mbedのPwmOutを使うPWMバックエンド (どのターゲットでも動く)
+// DCMotorT, ServoTのテンプレート引数に渡す。
+class MbedPwmBackend
+{
+public:
+    MbedPwmBackend(PinName pin, chrono::microseconds period) : pwm(pin)
+    {
+        pwm.period_us(period.count());
+    }
+
+    // @param duty 0~1
+    void write(float duty)
+    {
+        pwm.write(duty);
+    }
+
+    void writePulseWidth(chrono::microseconds pulse_width)
+    {
+        pwm.pulsewidth_us(pulse_width.count());
+    }
+
+private:
+    PwmOut pwm;
+};
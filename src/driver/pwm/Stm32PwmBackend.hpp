@@ -0,0 +1,93 @@
+#pragma once
+#include <mbed.hpp>
+
+#ifdef TARGET_STM
+#include "pinmap.h"
+#include "PeripheralPins.h"
+
+// STM32のタイマーのレジスタを直接書くPWMバックエンド
+// ピンとタイマーの初期化(クロック供給、オルタネート機能)はmbedのPwmOutに任せ、
+// 構築時にタイマーのクロックから周期のカウント数を計算し直してPSC, ARRを設定する。
+// 以降の書き込みはCCRへの整数の書き込みだけで、HALを通らない。
+//
+// mbedは1us刻みで周期を設定するので、16kHzでは62段階しかないが、ここではタイマーのクロックそのままで数える。
+// CCRはプリロードを有効にするので、書き込みは次のPWM周期の境界(更新イベント)で反映される。
+// 同じタイマーのチャンネル(例えばMotorGroupでまとめて書いた駆動輪)は同じ境界で同時に切り替わる。
+// PSC, ARRも同じく次の更新イベントで反映する。UGで更新イベントを起こすとカウンターが0に戻り、
+// 同じタイマーで動いている他のチャンネルのPWM周期が途中で切れるので、起こさない
+// (構築の直後は、最大でmbedが設定した周期1回分だけ元の周期で動く)。
+class Stm32PwmBackend
+{
+public:
+    Stm32PwmBackend(PinName pin, chrono::microseconds period) : pwm(pin)
+    {
+        pwm.period_us(period.count());
+
+        timer = (TIM_TypeDef *)(uintptr_t)pinmap_peripheral(pin, PinMap_PWM);
+        int channel = STM_PIN_CHANNEL(pinmap_function(pin, PinMap_PWM));
+        compare = &timer->CCR1 + (channel - 1); // CCR1~CCR4は連続している
+
+        // 分解能が最大になるように、周期のカウント数がARRに収まる最小のプリスケーラを選ぶ
+        uint64_t total_counts = (uint64_t)getTimerClock() * period.count() / 1000000;
+        uint64_t max_counts = isTimer32Bit() ? 0x100000000ULL : 0x10000ULL;
+        uint32_t prescaler = (uint32_t)((total_counts - 1) / max_counts + 1);
+        period_counts = (uint32_t)(total_counts / prescaler);
+        duty_scale = (float)period_counts;
+        counts_per_us = (float)period_counts / period.count();
+
+        // CCRのプリロードを有効化
+        volatile uint32_t *ccmr = channel <= 2 ? &timer->CCMR1 : &timer->CCMR2;
+        *ccmr |= (channel % 2 == 1) ? TIM_CCMR1_OC1PE : TIM_CCMR1_OC2PE;
+
+        timer->CR1 |= TIM_CR1_ARPE; // ARRもプリロードして、周期の途中で縮めてもカウンターが追い越さないようにする
+        timer->PSC = prescaler - 1;
+        timer->ARR = period_counts - 1;
+        *compare = 0;
+    }
+
+    // @param duty 0~1 (1でCCR = ARR + 1 となり常にHIGH)
+    void write(float duty)
+    {
+        *compare = (uint32_t)(duty * duty_scale);
+    }
+
+    void writePulseWidth(chrono::microseconds pulse_width)
+    {
+        *compare = (uint32_t)(pulse_width.count() * counts_per_us);
+    }
+
+    uint32_t getPeriodCounts() const
+    {
+        return period_counts;
+    }
+
+private:
+    PwmOut pwm; // ピンとタイマーの初期化用。デストラクタでPWMを止める。
+    TIM_TypeDef *timer;
+    volatile uint32_t *compare;
+    uint32_t period_counts;
+    float duty_scale;
+    float counts_per_us;
+
+    // タイマーのクロック[Hz]
+    uint32_t getTimerClock() const
+    {
+        // TIM1, TIM8~TIM11はAPB2、それ以外はAPB1
+        bool is_apb2 = (uintptr_t)timer >= APB2PERIPH_BASE;
+        uint32_t pclk = is_apb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+        bool is_apb_divided = is_apb2 ? (RCC->CFGR & RCC_CFGR_PPRE2_2) != 0 : (RCC->CFGR & RCC_CFGR_PPRE1_2) != 0;
+
+        // APBを分周しているときはタイマーのクロックはPCLKの2倍 (RCC_DCKCFGRのTIMPREは初期値の0を想定)
+        return is_apb_divided ? pclk * 2 : pclk;
+    }
+
+    bool isTimer32Bit() const
+    {
+#if defined(TIM2) && defined(TIM5)
+        return timer == TIM2 || timer == TIM5;
+#else
+        return false;
+#endif
+    }
+};
+#endif
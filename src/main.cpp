@@ -65,6 +65,14 @@ int main()
     PIDGain position_pid_gain = {0.1f, 0.0f, 0.0f, frequency};
     constexpr MeterPerSecond max_speed = 10_m_s;
 
+    // 目標の近くではゲインを上げて最後の数cmを詰める (偏差が1m以上ならposition_pid_gainと同じ)
+    static constexpr GainSchedule<3> position_gain_schedule = {{
+        {0.00f, 0.3f, 0.05f, 0.0f}, // 最終位置合わせ
+        {0.10f, 0.2f, 0.0f, 0.0f},
+        {1.00f, 0.1f, 0.0f, 0.0f}, // 巡航
+    }};
+    static_assert(isGainScheduleSorted(position_gain_schedule), "keys must be strictly increasing");
+
     array<MeasuringWheel, 5> measuring_wheels = {
         wheels.front.measuring_wheel,
         wheels.rear_left.measuring_wheel,
@@ -85,7 +93,11 @@ int main()
     // auto odometry = std::make_unique<ImuWheelOdometry<5>>(measuring_wheels, imu);
 
     // メモリのスタック領域に入り切らないのでunique_ptrを使ってヒープ領域に配置。
-    auto position_controller = std::make_unique<PositionController<5, 3>>(odometry, motor_wheels, position_pid_gain, max_speed);
+    auto position_controller = std::make_unique<PositionController<5, 3>>(odometry, motor_wheels, position_pid_gain, max_speed, 5ms, &position_gain_schedule);
+
+    // 目標位置への位置制御をPIDの代わりにMPCで行う場合 (duty比の上下限を陽に扱う)
+    // auto mpc_controller = std::make_unique<MpcController<3>>(WheelSettings::drive_wheels, 3.0f, 5ms, MpcWeight{1.0f, 0.5f, 0.01f}, 0.8f);
+    // position_controller->setMpcController(mpc_controller.get());
 
     position_controller->setTargetPosition({10_m, 0_m, 0_deg});
 
@@ -102,10 +114,12 @@ int main()
     }
 
     // Servo servo(PA_0, 1s, 1s);
-    // Section1 section1(position_controller, servo, {10_m, 0_m, 90_deg});
+    // Section1 section1(position_controller, servo); // section1_trajectoryを再生して(4m, 1m, 90deg)まで移動
     // array<ISection *, 1> sections = {&section1};
     // SectionController<1> section_controller(sections);
 
+    // セクションは位置制御と同じ制御スレッドで毎周期更新する
+    // position_controller->setControlCallback(callback(&section_controller, &SectionController<1>::update));
     // section_controller.start();
 
     // while (section_controller.isRunning())
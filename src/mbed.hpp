@@ -30,7 +30,7 @@
 // #include <time.h>
 
 // mbed Debug libraries
-// #include "platform/mbed_error.h"
+#include "platform/mbed_error.h"
 // #include "platform/mbed_interface.h"
 // #include "platform/mbed_assert.h"
 // #include "platform/mbed_debug.h"
@@ -63,10 +63,10 @@
 
 // mbed Internal components
 // #include "drivers/ResetReason.h"
-// #include "drivers/HighResClock.h"
+#include "drivers/HighResClock.h"
 #include "drivers/Timer.h"
 #include "drivers/Ticker.h"
-// #include "drivers/Timeout.h"
+#include "drivers/Timeout.h"
 // #include "drivers/LowPowerClock.h"
 // #include "drivers/LowPowerTimeout.h"
 // #include "drivers/LowPowerTicker.h"
@@ -85,7 +85,7 @@
 // #include "platform/FileSystemHandle.h"
 // #include "platform/FileHandle.h"
 // #include "platform/DirHandle.h"
-// #include "platform/CriticalSectionLock.h"
+#include "platform/CriticalSectionLock.h"
 // #include "platform/DeepSleepLock.h"
 // #include "platform/ScopedRomWriteLock.h"
 // #include "platform/ScopedRamExecutionLock.h"
@@ -31,7 +31,7 @@ public:
     float getCurrentRps()
     {
         mutex.lock();
-        int current_rps = this->current_rps;
+        float current_rps = this->current_rps;
         mutex.unlock();
 
         return current_rps;
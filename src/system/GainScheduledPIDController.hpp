@@ -0,0 +1,150 @@
+#pragma once
+#include <mbed.hpp>
+#include <array>
+#include "PIDController.hpp"
+
+// ゲインスケジュールの1点
+// スケジューリング変数(偏差の大きさ、車輪速度など)がkeyのときのゲイン
+struct GainSchedulePoint
+{
+    float key; // スケジューリング変数
+    float kp;  // Pゲイン
+    float ki;  // Iゲイン
+    float kd;  // Dゲイン
+};
+
+// ゲインスケジュール表。keyは狭義の昇順に並べること (同じkeyがあると補間で0除算になる)。
+// constexprで定義すればフラッシュに配置され、isGainScheduleSortedをstatic_assertで確かめられる。
+//
+// ### example
+// constexpr GainSchedule<3> position_schedule = {{
+//     {0.00f, 2.0f, 0.5f, 0.0f}, // 最終位置合わせ
+//     {0.10f, 1.0f, 0.0f, 0.0f},
+//     {1.00f, 0.5f, 0.0f, 0.0f}, // 巡航
+// }};
+// static_assert(isGainScheduleSorted(position_schedule), "keys must be strictly increasing");
+template <int K>
+using GainSchedule = std::array<GainSchedulePoint, K>;
+
+// keyが狭義の昇順か
+template <size_t K>
+constexpr bool isGainScheduleSorted(const std::array<GainSchedulePoint, K> &schedule)
+{
+    for (size_t i = 1; i < K; i++)
+    {
+        if (!(schedule[i - 1].key < schedule[i].key))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// スケジューリング変数に応じてゲインを線形補間するPID制御器
+// K: ゲインスケジュール表の点数
+//
+// バンプレスなのは積分項だけ。積分項はゲインを掛けた後の値で持つので、kiが変わっても出力は連続になる。
+// P項とD項は今のゲインを掛けるので、ゲインが変わった周期に (ゲインの変化) * 偏差 だけ出力が変わる。
+// 補間しているので、スケジューリング変数が連続に変われば1周期あたりのゲインの変化も小さい。
+// 積分の扱いはPIDControllerと同じで、今回の偏差は次の周期から積分項に入る。
+template <typename T, int K>
+class GainScheduledPIDController
+{
+    static_assert(K >= 2, "K must be greater than 1.");
+
+public:
+    // 表はコピーせずに参照するので、呼び出し側でconstexprなどの寿命の長い変数として定義すること。
+    GainScheduledPIDController(const GainSchedule<K> &schedule, int frequency)
+        : schedule(schedule), frequency(frequency), gain({schedule[0].kp, schedule[0].ki, schedule[0].kd, frequency})
+    {
+        if (!isGainScheduleSorted(schedule))
+        {
+            error("GainScheduledPIDController: schedule keys must be strictly increasing\n");
+        }
+    };
+
+    // 偏差とスケジューリング変数を与えると操作量を返す。
+    T calculate(T error, float schedule_value)
+    {
+        gain = interpolate(schedule_value);
+
+        // restart直後は前回の偏差がないので微分項を0にする
+        if (!has_prev_error)
+        {
+            prevError = error;
+            has_prev_error = true;
+        }
+
+        T output = error * gain.kp +
+                   integral +
+                   (error - prevError) * (gain.kd * frequency);
+        prevError = error; // 前回の偏差を更新
+
+        // 積分項はゲインを掛けた後の値で保持する。
+        // ゲインが切り替わっても積分項の出力が連続になる(バンプレス切り替え)。
+        integral += error * (gain.ki / frequency);
+
+        return output;
+    };
+
+    // 積分値をリセット
+    void reset()
+    {
+        integral = T{};
+    };
+
+    // 積分値と前回の偏差を捨てて制御をやり直す (PIDController::restartと同じ)
+    void restart()
+    {
+        integral = T{};
+        prevError = T{};
+        has_prev_error = false;
+    };
+
+    // 周波数を取得
+    int getFrequency()
+    {
+        return frequency;
+    };
+
+    // 直前のcalculateで使用したゲインを取得
+    PIDGain getGain()
+    {
+        return gain;
+    };
+
+private:
+    const GainSchedule<K> &schedule;
+    int frequency; // 制御頻度
+    PIDGain gain;  // 現在のゲイン
+
+    T integral = T{};           // 積分項 (ゲイン適用済み)
+    T prevError = T{};          // 前回の偏差
+    bool has_prev_error = true; // 前回の偏差があるか。restartの後だけfalse
+
+    // スケジューリング変数からゲインを補間する
+    PIDGain interpolate(float schedule_value)
+    {
+        // 比較結果の総和で区間を求める。Kは小さいので分岐なしの加算の方が二分探索より速い。
+        int index = 0;
+        for (int i = 1; i < K - 1; i++)
+        {
+            index += (schedule_value >= schedule[i].key);
+        }
+
+        const GainSchedulePoint &lower = schedule[index];
+        const GainSchedulePoint &upper = schedule[index + 1];
+
+        // 表の範囲外は端の値で飽和させる
+        float ratio = (schedule_value - lower.key) / (upper.key - lower.key);
+        ratio = ratio < 0.0f ? 0.0f : (ratio > 1.0f ? 1.0f : ratio);
+
+        return PIDGain{
+            lower.kp + (upper.kp - lower.kp) * ratio,
+            lower.ki + (upper.ki - lower.ki) * ratio,
+            lower.kd + (upper.kd - lower.kd) * ratio,
+            frequency,
+        };
+    }
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <ControlMath.h>
+
+// 固定長の小さい最小二乗の解
+template <typename Scalar, int N, int M>
+struct LeastSquaresSolution
+{
+    Eigen::Matrix<Scalar, M, N> pseudo_inverse; // 疑似逆行列 (A^T A)^-1 A^T
+    Scalar condition_number;                    // Aの条件数 (最大特異値 / 最小特異値)。ランク落ちなら無限大
+    bool used_eigendecomposition;               // 条件数が大きいのでA^T Aの固有値分解で解いたか
+};
+
+// 対称行列を固有値分解する (巡回Jacobi法)
+// matrix = eigenvectors * diag(eigenvalues) * eigenvectors^T。固有値は並べ替えない。
+// SVDやEigenvaluesのモジュールを使わずに済むよう、Coreだけで書いてある。小さい行列に起動時に使う程度の速さ。
+template <typename Scalar, int M>
+void decomposeSymmetric(Eigen::Matrix<Scalar, M, M> matrix, Eigen::Matrix<Scalar, M, 1> &eigenvalues, Eigen::Matrix<Scalar, M, M> &eigenvectors)
+{
+    constexpr int MAX_SWEEPS = 30; // 普通は数回で収束する
+
+    eigenvectors.setIdentity();
+    Scalar epsilon = Eigen::NumTraits<Scalar>::epsilon();
+    Scalar threshold = epsilon * epsilon * matrix.squaredNorm();
+
+    for (int sweep = 0; sweep < MAX_SWEEPS; sweep++)
+    {
+        Scalar off_diagonal = 0;
+        for (int p = 0; p < M; p++)
+        {
+            for (int q = p + 1; q < M; q++)
+            {
+                off_diagonal += matrix(p, q) * matrix(p, q);
+            }
+        }
+        if (off_diagonal <= threshold)
+        {
+            break;
+        }
+
+        for (int p = 0; p < M; p++)
+        {
+            for (int q = p + 1; q < M; q++)
+            {
+                if (matrix(p, q) == 0)
+                {
+                    continue;
+                }
+
+                // (p, q)成分を0にする回転 J。matrix = J^T matrix J
+                Scalar theta = (matrix(q, q) - matrix(p, p)) / (2 * matrix(p, q));
+                Scalar t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                Scalar c = 1 / std::sqrt(t * t + 1);
+                Scalar s = t * c;
+
+                for (int k = 0; k < M; k++)
+                {
+                    Scalar row_p = matrix(p, k);
+                    Scalar row_q = matrix(q, k);
+                    matrix(p, k) = c * row_p - s * row_q;
+                    matrix(q, k) = s * row_p + c * row_q;
+                }
+                for (int k = 0; k < M; k++)
+                {
+                    Scalar column_p = matrix(k, p);
+                    Scalar column_q = matrix(k, q);
+                    matrix(k, p) = c * column_p - s * column_q;
+                    matrix(k, q) = s * column_p + c * column_q;
+
+                    Scalar vector_p = eigenvectors(k, p);
+                    Scalar vector_q = eigenvectors(k, q);
+                    eigenvectors(k, p) = c * vector_p - s * vector_q;
+                    eigenvectors(k, q) = s * vector_p + c * vector_q;
+                }
+            }
+        }
+    }
+
+    eigenvalues = matrix.diagonal();
+}
+
+// N本の式でM個の未知数を決める最小二乗 A x = b (N >= M) の疑似逆行列を求める
+// 車輪の配置から機体速度を求める行列など、起動時に1度だけ解くものに使う。
+//
+// 条件数は正規方程式の行列 A^T A (M x M) の固有値から sqrt(最大 / 最小) で求める。
+// A^T A は条件数が2乗になるので、固有値分解はdoubleで行う。
+// 条件数がNORMAL_EQUATIONS_MAX_CONDITION以下なら、正規方程式 A^T A X = A^T をLDLTで解く (N == Mなら逆行列そのもの)。
+// 超えたら、固有値分解から A^+ = V Λ^-1 V^T A^T で解き、小さすぎる固有値は0とみなして捨てる
+// (特異値が最大特異値 * N * Scalarのepsilon以下。このときは条件数も無限大として返す)。
+// 条件数を返すので、呼び出し側で配置の良し悪しを確かめられる。
+template <typename Scalar, int N, int M>
+LeastSquaresSolution<Scalar, N, M> solveLeastSquares(const Eigen::Matrix<Scalar, N, M> &matrix)
+{
+    static_assert(N >= M, "N must be greater than or equal to M.");
+    constexpr Scalar NORMAL_EQUATIONS_MAX_CONDITION = 100; // floatで正規方程式の相対誤差が1e-3程度に収まる条件数
+
+    using PseudoInverse = Eigen::Matrix<Scalar, M, N>;
+
+    LeastSquaresSolution<Scalar, N, M> solution;
+
+    Eigen::Matrix<double, N, M> matrix_double = matrix.template cast<double>();
+    Eigen::Matrix<double, M, M> normal_matrix_double = matrix_double.transpose() * matrix_double;
+    Eigen::Matrix<double, M, 1> eigenvalues;
+    Eigen::Matrix<double, M, M> eigenvectors;
+    decomposeSymmetric<double, M>(normal_matrix_double, eigenvalues, eigenvectors);
+
+    double max_eigenvalue = eigenvalues.maxCoeff();
+    double min_eigenvalue = eigenvalues.minCoeff();
+    double tolerance = std::sqrt(std::fmax(max_eigenvalue, 0.0)) * N * Eigen::NumTraits<Scalar>::epsilon(); // 特異値の許容値
+    solution.condition_number = min_eigenvalue > tolerance * tolerance ? (Scalar)std::sqrt(max_eigenvalue / min_eigenvalue) : std::numeric_limits<Scalar>::infinity();
+
+    solution.used_eigendecomposition = !(solution.condition_number <= NORMAL_EQUATIONS_MAX_CONDITION);
+    if (!solution.used_eigendecomposition)
+    {
+        // コンパイル時にif文を処理してEigenのstatic_assertを回避。c++17以降。
+        if constexpr (N == M)
+        {
+            solution.pseudo_inverse = matrix.inverse();
+        }
+        else
+        {
+            Eigen::Matrix<Scalar, M, M> normal_matrix = matrix.transpose() * matrix;
+            PseudoInverse transposed = matrix.transpose();
+            solution.pseudo_inverse = normal_matrix.ldlt().solve(transposed);
+        }
+
+        return solution;
+    }
+
+    // A^T A = V Λ V^T のとき A^+ = V Λ^+ V^T A^T
+    Eigen::Matrix<double, M, N> pseudo_inverse = Eigen::Matrix<double, M, N>::Zero();
+    for (int i = 0; i < M; i++)
+    {
+        if (eigenvalues(i) > tolerance * tolerance)
+        {
+            pseudo_inverse += eigenvectors.col(i) * ((matrix_double * eigenvectors.col(i)).transpose() / eigenvalues(i));
+        }
+    }
+    solution.pseudo_inverse = pseudo_inverse.template cast<Scalar>();
+
+    return solution;
+}
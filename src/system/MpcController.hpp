@@ -0,0 +1,172 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <ControlMath.h>
+#include "WheelSettings.hpp"
+#include "WheelVector.hpp"
+#include "LeastSquares.hpp"
+#include "units/units.hpp"
+#include "units/eigenMap.hpp"
+
+// MPCの重み
+struct MpcWeight
+{
+    float position; // 位置偏差[m]に対する重み (x, y共通)
+    float heading;  // 角度偏差[rad]に対する重み
+    float duty;     // duty比に対する重み
+};
+
+// 全方向移動ロボットの線形モデル予測制御
+// 各駆動輪のduty比を直接操作量とし、duty比の上下限を制約として陽に扱う。
+// WheelControllerのように全輪を同じ比率で縮めるのではなく、余っているモーターのトルクも使い切る。
+//
+// モデル: ロボット座標系の偏差 e に対して e[k+1] = e[k] - period * B * duty[k]
+//         (duty比に比例して車輪が回るとし、車輪速度から機体速度への変換をBとする)
+// 予測区間中の旋回は無視する。x, yの重みを共通にすると評価関数がthetaに依存しなくなり、
+// QPのヘッセ行列は構築時に一度だけ分解すればよい。
+// QPはADMMで解く。反復回数を固定しているので最悪実行時間が一定で、ヒープも使わない。
+//
+// 行列が大きいので、PositionControllerと同様にunique_ptrでヒープに配置すること。
+// PositionController::setMpcControllerで渡すと、目標位置への位置制御に使われる。
+//
+// 1回のcalculateDutyの演算回数はgetSolveFlopsで決まり、偏差によらない (M = 3, H = 10, 30回の反復で約6.1万回)。
+// Cortex-M4Fの単精度のロードと積和は1演算あたり数サイクルなので、ループの分を多めに見て5サイクル/演算としても
+// 約31万サイクル、F446の180MHzで約1.7msで、5msの制御周期に収まる。
+// 実機のサイクル数はtools/target_benchで、ホストでの時間はtools/micro_benchのmpc/solveで測る。
+// M: 駆動輪の数, H: 予測ホライズン
+template <int M, int H = 10>
+class MpcController
+{
+    static constexpr int U = M * H; // 決定変数の数
+
+    using Hessian = Eigen::Matrix<float, U, U>;
+    using DecisionVector = Eigen::Matrix<float, U, 1>;
+    using InputMatrix = Eigen::Matrix<float, 3, M>;
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    // wheel_positions: 駆動輪の配置
+    // max_wheel_rps: duty比1での車輪の回転数[rps]
+    // period: 制御周期
+    // iterations: 1回の制御周期でのADMMの反復回数
+    MpcController(const std::array<WheelPositions, M> &wheel_positions, float max_wheel_rps, std::chrono::microseconds period, MpcWeight weight, float max_duty = 1.0f, int iterations = 30)
+        : max_duty(max_duty), iterations(iterations)
+    {
+        float dt = std::chrono::duration<float>(period).count();
+
+        // 車輪の回転数 -> 機体速度の変換行列 (M>3なら最小二乗)
+        Eigen::Matrix<float, M, 3> wheel_matrix;
+        for (int i = 0; i < M; i++)
+        {
+            WheelVector wheel_vector = getWheelVector(wheel_positions[i]);
+            wheel_matrix(i, 0) = wheel_vector.x;
+            wheel_matrix(i, 1) = wheel_vector.y;
+            wheel_matrix(i, 2) = wheel_vector.theta;
+        }
+        InputMatrix input_matrix = solveLeastSquares(wheel_matrix).pseudo_inverse * max_wheel_rps;
+
+        Eigen::Vector3f state_weight(weight.position, weight.position, weight.heading);
+
+        // duty[i]はe[i+1]..e[H]に効くので、
+        // ヘッセ行列の(i, j)ブロックは (H - max(i, j)) * dt^2 * B^T Q B
+        // 線形項のiブロックは -(H - i) * dt * B^T Q e0
+        Eigen::Matrix<float, M, M> input_cost = dt * dt * input_matrix.transpose() * state_weight.asDiagonal() * input_matrix;
+        gradient_matrix = -dt * input_matrix.transpose() * state_weight.asDiagonal();
+
+        for (int i = 0; i < H; i++)
+        {
+            for (int j = 0; j < H; j++)
+            {
+                factor.template block<M, M>(i * M, j * M) = (float)(H - std::max(i, j)) * input_cost;
+            }
+        }
+        factor.diagonal().array() += weight.duty;
+
+        // ADMMのペナルティはヘッセ行列の対角成分の平均程度にする
+        rho = factor.trace() / U;
+        factor.diagonal().array() += rho;
+
+        // (P + rho * I) をその場でコレスキー分解 (LLTオブジェクトを使うと行列のコピーが増えるため)
+        Eigen::internal::llt_inplace<float, Eigen::Lower>::blocked(factor);
+
+        reset();
+    }
+
+    // 1回のcalculateDutyの浮動小数点演算の回数
+    // 反復1回あたり、前進・後退の三角行列の解きで2 * U^2、ベクトルの更新とクランプで8 * U。
+    // 反復の前に、線形項の計算で2 * 3 * M + U。
+    static constexpr long getSolveFlops(int iterations)
+    {
+        return (long)iterations * (2L * U * U + 8L * U) + 2L * 3 * M + U;
+    }
+
+    // 前回の解を捨てる
+    void reset()
+    {
+        z.setZero();
+        y.setZero();
+    }
+
+    // error: フィールド座標系での偏差
+    // current_theta: 現在の機体の向き
+    // 戻り値: 各駆動輪のduty比
+    std::array<float, M> calculateDuty(Position error, Radian current_theta)
+    {
+        Position body_error = Pose2::rotation(current_theta).inverseRotate(error);
+
+        Eigen::Matrix<float, M, 1> gradient = gradient_matrix * asEigen(body_error);
+        for (int i = 0; i < H; i++)
+        {
+            q.template segment<M>(i * M) = (float)(H - i) * gradient;
+        }
+
+        // 前回の解を1ステップずらして初期値にする (ウォームスタート)
+        shiftSolution(z);
+        shiftSolution(y);
+
+        for (int k = 0; k < iterations; k++)
+        {
+            // x = (P + rho * I)^-1 (rho * (z - y) - q)
+            x = rho * (z - y) - q;
+            factor.template triangularView<Eigen::Lower>().solveInPlace(x);
+            factor.template triangularView<Eigen::Lower>().adjoint().solveInPlace(x);
+
+            // z = clamp(x + y)
+            z = (x + y).cwiseMax(-max_duty).cwiseMin(max_duty);
+
+            y += x - z;
+        }
+
+        // zは必ず制約を満たす
+        std::array<float, M> duty;
+        for (int i = 0; i < M; i++)
+        {
+            duty[i] = z(i);
+        }
+
+        return duty;
+    }
+
+private:
+    Hessian factor; // (P + rho * I) のコレスキー因子 (下三角)
+    Eigen::Matrix<float, M, 3> gradient_matrix;
+    float rho;
+    float max_duty;
+    int iterations;
+
+    // ADMMの変数
+    DecisionVector x;
+    DecisionVector z;
+    DecisionVector y;
+    DecisionVector q;
+
+    static void shiftSolution(DecisionVector &vector)
+    {
+        for (int i = 0; i < H - 1; i++)
+        {
+            vector.template segment<M>(i * M) = vector.template segment<M>((i + 1) * M);
+        }
+    }
+};
@@ -25,6 +25,13 @@ public:
     // 偏差を与えると操作量を返す。
     T calculate(T error)
     {
+        // restart直後は前回の偏差がないので微分項を0にする
+        if (!has_prev_error)
+        {
+            prevError = error;
+            has_prev_error = true;
+        }
+
         // 周波数を考慮
         T output = error * gain.kp +
                    integral * (gain.ki / gain.frequency) +
@@ -42,6 +49,15 @@ public:
         integral = T{};
     };
 
+    // 積分値と前回の偏差を捨てて制御をやり直す
+    // 次のcalculateの微分項は0になる。別の制御から切り替えたときに微分項が跳ねないように使う。
+    void restart()
+    {
+        integral = T{};
+        prevError = T{};
+        has_prev_error = false;
+    };
+
     // 周波数を変更
     void setFrequency(int frequency)
     {
@@ -69,7 +85,8 @@ public:
     };
 
 private:
-    T integral = T{};  // 積分値
-    T prevError = T{}; // 前回の偏差
-    PIDGain gain;      // ゲイン
+    T integral = T{};           // 積分値
+    T prevError = T{};          // 前回の偏差
+    bool has_prev_error = true; // 前回の偏差があるか。restartの後だけfalse (初期状態は前回の偏差0として扱う)
+    PIDGain gain;               // ゲイン
 };
@@ -0,0 +1,187 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include "units/units.hpp"
+
+// 経路追従の抽象クラス
+// PositionControllerの制御周期ごとに呼び出される。
+class IPathFollower
+{
+public:
+    // 現在位置からフィールド座標系の目標速度を計算する
+    virtual Velocity calculate(Position current_position) = 0;
+    // 経路の終端付近に到達し、位置制御に引き継ぐべきか
+    virtual bool isFinished() = 0;
+    // 経路の終端の位置
+    virtual Position getFinalPosition() = 0;
+};
+
+// 全方向移動ロボット用のPure Pursuit
+// 経路上で現在位置から先読み距離だけ進んだ点に向かう速度を出力する。
+// 向きは並進とは独立に、先読み点での目標角度に追従させる。
+// K: 経由点の数
+template <int K>
+class PurePursuit : public IPathFollower
+{
+    static_assert(K > 1, "K must be greater than 1.");
+
+public:
+    // waypoints: 経由点 (最初の点は開始位置)
+    // lookahead: 先読み距離
+    // cruise_speed: 巡航速度
+    // max_acceleration: 終端での減速に使う加速度
+    // heading_gain: 角度偏差に対する角速度のゲイン[1/s]
+    PurePursuit(const std::array<Position, K> &waypoints, Meter lookahead, MeterPerSecond cruise_speed, MeterPerSecondSquared max_acceleration, float heading_gain)
+        : waypoints(waypoints), lookahead(lookahead.value), cruise_speed(cruise_speed.value), max_acceleration(max_acceleration.value), heading_gain(heading_gain)
+    {
+        cumulative_lengths[0] = 0.0f;
+        for (int i = 1; i < K; i++)
+        {
+            float dx = waypoints[i].x.value - waypoints[i - 1].x.value;
+            float dy = waypoints[i].y.value - waypoints[i - 1].y.value;
+            cumulative_lengths[i] = cumulative_lengths[i - 1] + std::hypot(dx, dy);
+        }
+
+        reset();
+    }
+
+    // 経路の最初から追従し直す
+    void reset()
+    {
+        segment = 0;
+        progress = 0.0f;
+    }
+
+    Velocity calculate(Position current_position) override
+    {
+        updateProgress(current_position);
+
+        Position target = getPointAt(progress + lookahead);
+        float dx = target.x.value - current_position.x.value;
+        float dy = target.y.value - current_position.y.value;
+        float distance = std::hypot(dx, dy);
+
+        // 終端で止まれるように残り距離から速度を制限
+        float remaining = cumulative_lengths[K - 1] - progress;
+        float speed = std::fmin(cruise_speed, std::sqrt(2.0f * max_acceleration * remaining));
+
+        float vx = 0.0f;
+        float vy = 0.0f;
+        if (distance > 1e-6f)
+        {
+            vx = speed * dx / distance;
+            vy = speed * dy / distance;
+        }
+
+        Radian heading_error = normalizeAngle(target.theta - current_position.theta);
+
+        return Velocity{
+            MeterPerSecond(vx),
+            MeterPerSecond(vy),
+            RadPerSecond(heading_gain * heading_error.value),
+        };
+    }
+
+    bool isFinished() override
+    {
+        // 先読み点が終端に達したら、残りは位置制御に任せる
+        return cumulative_lengths[K - 1] - progress <= lookahead;
+    }
+
+    Position getFinalPosition() override
+    {
+        return waypoints[K - 1];
+    }
+
+private:
+    std::array<Position, K> waypoints;
+    std::array<float, K> cumulative_lengths; // 始点から各経由点までの経路長
+    float lookahead;
+    float cruise_speed;
+    float max_acceleration;
+    float heading_gain;
+
+    int segment;    // 現在追従している区間 (waypoints[segment] -> waypoints[segment + 1])
+    float progress; // 経路上の現在位置 (始点からの経路長)
+
+    static constexpr float MIN_SEGMENT_LENGTH = 1e-4f; // これより短い区間(その場での回転など)は射影に使わない[m]
+
+    // 現在位置を経路に射影して進捗を更新する。
+    // 現在の区間と次の区間を探索し、射影が区間の終点を越えている間はさらに先の区間も探す
+    // (短い区間を1周期で通り過ぎても止まらないように)。
+    // 射影が区間の中に入ったらそれより先は探さないので、交差する経路で先に飛んだり、後戻りしたりしない。
+    void updateProgress(Position current_position)
+    {
+        float best_distance = INFINITY;
+        float best_progress = progress;
+        int best_segment = segment;
+        int searched = 0;
+
+        for (int i = segment; i < K - 1; i++)
+        {
+            float x0 = waypoints[i].x.value;
+            float y0 = waypoints[i].y.value;
+            float dx = waypoints[i + 1].x.value - x0;
+            float dy = waypoints[i + 1].y.value - y0;
+            float length_sq = dx * dx + dy * dy;
+            if (length_sq < MIN_SEGMENT_LENGTH * MIN_SEGMENT_LENGTH)
+            {
+                continue;
+            }
+
+            float t = ((current_position.x.value - x0) * dx + (current_position.y.value - y0) * dy) / length_sq;
+            bool passed = t >= 1.0f; // 射影が区間の終点を越えている
+            t = std::fmin(std::fmax(t, 0.0f), 1.0f);
+
+            float px = x0 + t * dx - current_position.x.value;
+            float py = y0 + t * dy - current_position.y.value;
+            float distance = px * px + py * py;
+
+            if (distance < best_distance)
+            {
+                best_distance = distance;
+                best_segment = i;
+                best_progress = cumulative_lengths[i] + t * (cumulative_lengths[i + 1] - cumulative_lengths[i]);
+            }
+
+            searched++;
+            if (searched >= 2 && !passed)
+            {
+                break;
+            }
+        }
+
+        // 進捗は単調増加
+        if (best_progress >= progress)
+        {
+            segment = best_segment;
+            progress = best_progress;
+        }
+    }
+
+    // 経路長sの位置にある経路上の点を返す
+    Position getPointAt(float s) const
+    {
+        if (s >= cumulative_lengths[K - 1])
+        {
+            return waypoints[K - 1];
+        }
+
+        int i = segment;
+        while (i < K - 2 && cumulative_lengths[i + 1] < s)
+        {
+            i++;
+        }
+
+        float length = cumulative_lengths[i + 1] - cumulative_lengths[i];
+        float t = length > 0.0f ? (s - cumulative_lengths[i]) / length : 1.0f;
+
+        const Position &from = waypoints[i];
+        const Position &to = waypoints[i + 1];
+
+        return Position(
+            from.x + (to.x - from.x) * t,
+            from.y + (to.y - from.y) * t,
+            from.theta + normalizeAngle(to.theta - from.theta) * t);
+    }
+};
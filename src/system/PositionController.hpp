@@ -2,13 +2,28 @@
 #include "odometry/IOdometry.hpp"
 #include "WheelController.hpp"
 #include "PIDController.hpp"
+#include "PathFollower.hpp"
+#include "MpcController.hpp"
+#include "RealTimeSection.hpp"
+
+// 目標位置に到達したとみなす条件
+struct TargetTolerance
+{
+    Meter position;                   // 位置の偏差
+    Radian heading;                   // 角度の偏差
+    MeterPerSecond velocity;          // 並進速度
+    chrono::milliseconds settle_time; // 上の条件を満たし続ける時間
+};
 
 template <int N, int M>
 class PositionController
 {
 public:
-    PositionController(IOdometry<N> &odometry, array<MotorWheel, M> &motor_wheels, PIDGain &pid_gain, MeterPerSecond max_speed, chrono::microseconds odometry_update_interval = 5ms)
-        : odometry(odometry), wheel_controller(motor_wheels, pid_gain, max_speed), target_position(0_m, 0_m, 0_rad)
+    // position_gain_schedule: 並進の偏差の大きさ[m]で位置制御のゲインを補間する表 (nullptrならpid_gainで固定)
+    PositionController(IOdometry<N> &odometry, array<MotorWheel, M> &motor_wheels, PIDGain &pid_gain, MeterPerSecond max_speed, chrono::microseconds odometry_update_interval = 5ms,
+                       const GainSchedule<WheelController<M>::POSITION_GAIN_POINTS> *position_gain_schedule = nullptr)
+        : odometry(odometry), wheel_controller(motor_wheels, pid_gain, max_speed, 1.0f, position_gain_schedule), target_position(0_m, 0_m, 0_rad), path_follower(nullptr), was_following_path(false),
+          frequency(pid_gain.frequency), tolerance({0.1_m, 0.1_rad, 0.05_m_s, 0ms}), is_settling(false), last_position(0_m, 0_m, 0_rad)
     {
         odometry_ticker.attach(callback(this, &PositionController::updatePositionFlagSet), odometry_update_interval);
         odometry_thread.start(callback(this, &PositionController::updatePosition));
@@ -18,21 +33,97 @@ public:
 
     void setCurrentPosition(Position current_position)
     {
-        odometry->setCurrentPosition(current_position);
+        odometry.setCurrentPosition(current_position);
     }
 
     void setTargetPosition(Position target_position)
     {
         mutex.lock();
         this->target_position = target_position;
+        path_follower = nullptr;
+        clearTargetReached();
+        mutex.unlock();
+    }
+
+    // 経路追従を開始する。経路の終端付近からはsetTargetPositionと同じ位置制御に切り替わる。
+    // path_followerは追従が終わるまで呼び出し側で保持すること。
+    void followPath(IPathFollower *path_follower)
+    {
+        mutex.lock();
+        this->path_follower = path_follower;
+        clearTargetReached();
         mutex.unlock();
     }
 
+    bool isFollowingPath()
+    {
+        mutex.lock();
+        bool is_following = path_follower != nullptr;
+        mutex.unlock();
+
+        return is_following;
+    }
+
     Position getCurrentPosition()
     {
         return odometry.getCurrentPosition();
     }
 
+    // 到達判定の条件を設定
+    void setTargetTolerance(TargetTolerance tolerance)
+    {
+        mutex.lock();
+        this->tolerance = tolerance;
+        clearTargetReached();
+        mutex.unlock();
+    }
+
+    // 目標位置(経路追従中は経路の終端)に到達しているか
+    bool isTargetReached()
+    {
+        return (target_flag.get() & TARGET_REACHED_SIGNAL) != 0;
+    }
+
+    // 目標位置に到達するまで待つ。到達したらtrue、タイムアウトしたらfalseを返す。
+    bool waitTargetReached(Kernel::Clock::duration_u32 timeout = Kernel::wait_for_u32_forever)
+    {
+        uint32_t flags = target_flag.wait_any_for(TARGET_REACHED_SIGNAL, timeout, false);
+        return (flags & osFlagsError) == 0 && (flags & TARGET_REACHED_SIGNAL) != 0;
+    }
+
+    // 目標位置に到達した瞬間に1度だけ呼ばれる処理を登録する
+    // 制御スレッド上で実行されるので、中で待機してはいけない。
+    void setTargetReachedCallback(Callback<void()> target_reached_callback)
+    {
+        mutex.lock();
+        this->target_reached_callback = target_reached_callback;
+        mutex.unlock();
+    }
+
+    // 目標位置への位置制御をMPCで行う (nullptrに戻すとWheelControllerのPIDで行う)
+    // 経路追従中はPathFollowerが優先される。
+    // mpc_controllerは使い終わるまで呼び出し側で保持すること (行列が大きいのでunique_ptrでヒープに配置する)。
+    void setMpcController(MpcController<M> *mpc_controller)
+    {
+        if (mpc_controller != nullptr)
+        {
+            mpc_controller->reset();
+        }
+
+        mutex.lock();
+        this->mpc_controller = mpc_controller;
+        mutex.unlock();
+    }
+
+    // 制御周期ごとにモーターの更新後に呼ばれる処理を登録する (SectionController::updateなど)
+    // 制御スレッド上で実行されるので、中で待機してはいけない。
+    void setControlCallback(Callback<void()> control_callback)
+    {
+        mutex.lock();
+        this->control_callback = control_callback;
+        mutex.unlock();
+    }
+
 private:
     Ticker odometry_ticker;
     Thread odometry_thread;
@@ -48,16 +139,119 @@ private:
 
     Mutex mutex;
     Position target_position;
+    IPathFollower *path_follower;
+    MpcController<M> *mpc_controller = nullptr; // nullptrならPID
+    bool was_following_path; // 前回の制御周期で経路追従していたか (制御スレッドだけが触る)
+    Callback<void()> control_callback;
+
+    // 到達判定
+    int frequency;
+    TargetTolerance tolerance;
+    EventFlags target_flag;
+    static constexpr uint32_t TARGET_REACHED_SIGNAL = 1;
+    Callback<void()> target_reached_callback;
+    Timer settle_timer;
+    bool is_settling;
+    Position last_position;
+
+    // mutexをロックした状態で呼ぶ
+    void clearTargetReached()
+    {
+        target_flag.clear(TARGET_REACHED_SIGNAL);
+        is_settling = false;
+    }
 
-    Position getError()
+    // 条件を満たした状態がsettle_time続いたら到達フラグを立てる
+    void updateTargetReached(Position current_position)
+    {
+        float dx = current_position.x.value - last_position.x.value;
+        float dy = current_position.y.value - last_position.y.value;
+        float speed = hypot(dx, dy) * frequency;
+        last_position = current_position;
+
+        mutex.lock();
+
+        bool is_in_tolerance = false;
+        if (path_follower == nullptr)
+        {
+            Position error = getError(current_position);
+            is_in_tolerance = hypot(error.x.value, error.y.value) <= tolerance.position.value &&
+                              fabs(error.theta.value) <= tolerance.heading.value &&
+                              speed <= tolerance.velocity.value;
+        }
+
+        Callback<void()> reached_callback = nullptr;
+
+        if (!is_in_tolerance)
+        {
+            is_settling = false;
+        }
+        else if ((target_flag.get() & TARGET_REACHED_SIGNAL) == 0)
+        {
+            if (!is_settling)
+            {
+                is_settling = true;
+                settle_timer.reset();
+                settle_timer.start();
+            }
+
+            if (settle_timer.elapsed_time() >= tolerance.settle_time)
+            {
+                target_flag.set(TARGET_REACHED_SIGNAL);
+                reached_callback = target_reached_callback;
+            }
+        }
+
+        mutex.unlock();
+
+        if (reached_callback)
+        {
+            reached_callback();
+        }
+    }
+
+    // フィールド座標系での偏差を返す
+    Position getError(Position current_position)
     {
         mutex.lock();
         Position target_position = this->target_position;
         mutex.unlock();
 
-        Position current_position = odometry.getCurrentPosition();
+        Position error = target_position - current_position;
+        // 遠回りしないように角度の偏差を[-π, π]に正規化
+        error.theta = normalizeAngle(error.theta);
 
-        return target_position - current_position;
+        return error;
+    }
+
+    // 経路追従中なら速度を指令してtrueを返す
+    bool updatePathFollower(Position current_position)
+    {
+        mutex.lock();
+        IPathFollower *path_follower = this->path_follower;
+        mutex.unlock();
+
+        if (path_follower == nullptr)
+        {
+            return false;
+        }
+
+        if (!path_follower->isFinished())
+        {
+            wheel_controller.updateMotors(path_follower->calculate(current_position), current_position.theta);
+            return true;
+        }
+
+        // 経路の終端付近に来たら終端を目標とした位置制御に引き継ぐ
+        mutex.lock();
+        if (this->path_follower == path_follower)
+        {
+            target_position = path_follower->getFinalPosition();
+            this->path_follower = nullptr;
+        }
+        mutex.unlock();
+
+        return false;
     }
 
     void updatePositionFlagSet()
@@ -71,6 +265,7 @@ private:
         {
             odometry_flag.wait_any(ODOMETRY_UPDATE_SIGNAL);
 
+            RealTimeSection section;
             odometry.updatePosition();
         }
     }
@@ -86,7 +281,48 @@ private:
         {
             wheel_controller_flag.wait_any(WHEEL_CONTROLLER_UPDATE_SIGNAL);
 
-            wheel_controller.updateMotors(getError());
+            // 制御周期の中ではヒープを使わない (コールバックのセクションの処理も含む)
+            RealTimeSection section;
+            Position current_position = odometry.getCurrentPosition();
+
+            bool is_following_path = updatePathFollower(current_position);
+            if (!is_following_path)
+            {
+                mutex.lock();
+                MpcController<M> *mpc_controller = this->mpc_controller;
+                mutex.unlock();
+
+                // 経路追従から位置制御に切り替わったら、積分値と前回の偏差(MPCなら前回の解)を捨てる (微分項が跳ねないように)
+                if (was_following_path)
+                {
+                    wheel_controller.restartPid();
+                    if (mpc_controller != nullptr)
+                    {
+                        mpc_controller->reset();
+                    }
+                }
+
+                if (mpc_controller != nullptr)
+                {
+                    wheel_controller.updateMotors(mpc_controller->calculateDuty(getError(current_position), current_position.theta));
+                }
+                else
+                {
+                    wheel_controller.updateMotors(getError(current_position), current_position.theta);
+                }
+            }
+            was_following_path = is_following_path;
+
+            updateTargetReached(current_position);
+
+            mutex.lock();
+            Callback<void()> control_callback = this->control_callback;
+            mutex.unlock();
+
+            if (control_callback)
+            {
+                control_callback();
+            }
         }
     }
 };
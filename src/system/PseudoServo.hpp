@@ -0,0 +1,270 @@
+#pragma once
+#include <mbed.hpp>
+#include "PIDController.hpp"
+#include "driver/DCMotor.hpp"
+#include "driver/Encoder.hpp"
+#include "driver/LimitSwitch.hpp"
+#include "units/units.hpp"
+
+struct PseudoServoConfig
+{
+    PIDGain position_pid_gain;           // 位置ループ (出力: 角速度[rad/s])。frequencyは制御周期として使う。
+    PIDGain velocity_pid_gain;           // 速度ループ (出力: duty比)
+    RadPerSecond max_velocity;           // 台形プロファイルの最高角速度
+    float max_acceleration;              // 台形プロファイルの角加速度[rad/s^2]
+    float max_duty;                      // duty比の上限
+    float homing_duty;                   // 原点復帰でリミットスイッチへ向かうときのduty比 (符号で向きを指定)
+    Radian home_angle;                   // リミットスイッチが押された位置の角度
+    Radian tolerance;                    // 到達とみなす角度の偏差
+    chrono::milliseconds homing_timeout; // この時間内にリミットスイッチが押されなければ故障とみなす
+};
+
+// DCモーター + エンコーダー + リミットスイッチで位置制御するサーボ
+// 台形速度プロファイルで目標角度への軌道を作り、位置PID -> 速度PID の2段で追従する。
+// 制御周期(position_pid_gain.frequency)ごとにupdateを呼ぶこと。
+// PositionController::setControlCallbackなどに登録すれば、走行と同じスレッドで動かせる。
+// 原点復帰(home)が完了するまでは目標角度を受け付けない。
+// Motor: DCMotorT<PwmBackend> (ホストの確認ではFakePwmBackend)
+template <typename Motor>
+class PseudoServoT
+{
+public:
+    PseudoServoT(Motor &motor, Encoder &encoder, LimitSwitch &limit_switch, PseudoServoConfig config)
+        : motor(motor), encoder(encoder), limit_switch(limit_switch), config(config),
+          position_pid(config.position_pid_gain), velocity_pid(config.velocity_pid_gain),
+          state(State::Unhomed), target(0_rad), reference(0_rad), reference_velocity(0.0f), last_angle(0_rad) {}
+
+    // リミットスイッチに当たるまで動かして原点を合わせる (故障からの復帰にも使う)
+    void home()
+    {
+        mutex.lock();
+        state = State::Homing;
+        homing_timer.reset();
+        homing_timer.start();
+        flags.clear(REACHED_SIGNAL);
+        mutex.unlock();
+    }
+
+    // 目標角度を設定する。原点復帰が完了していなければ何もせずfalseを返す。
+    bool setTarget(Radian target)
+    {
+        mutex.lock();
+
+        if (state != State::Idle && state != State::Moving)
+        {
+            mutex.unlock();
+            return false;
+        }
+
+        // 停止中から動き出すときは、古いプロファイルと積分値を捨てて今の角度から始める
+        if (state == State::Idle)
+        {
+            startFromCurrentAngle();
+            state = State::Moving;
+        }
+        this->target = target;
+        flags.clear(REACHED_SIGNAL);
+
+        mutex.unlock();
+        return true;
+    }
+
+    bool isHomed()
+    {
+        mutex.lock();
+        bool is_homed = state == State::Idle || state == State::Moving;
+        mutex.unlock();
+
+        return is_homed;
+    }
+
+    // 原点復帰がタイムアウトした (リミットスイッチの断線など)。homeで再試行する。
+    bool isFault()
+    {
+        mutex.lock();
+        bool is_fault = state == State::Fault;
+        mutex.unlock();
+
+        return is_fault;
+    }
+
+    Radian getAngle()
+    {
+        return config.home_angle + encoder.getAngles();
+    }
+
+    bool isReached()
+    {
+        return (flags.get() & REACHED_SIGNAL) != 0;
+    }
+
+    // 目標角度に到達するまで待つ。到達したらtrue、タイムアウトしたらfalseを返す。
+    bool waitReached(Kernel::Clock::duration_u32 timeout = Kernel::wait_for_u32_forever)
+    {
+        uint32_t result = flags.wait_any_for(REACHED_SIGNAL, timeout, false);
+        return (result & osFlagsError) == 0 && (result & REACHED_SIGNAL) != 0;
+    }
+
+    void stop()
+    {
+        mutex.lock();
+        if (state == State::Moving)
+        {
+            state = State::Idle;
+        }
+        else if (state == State::Homing)
+        {
+            state = State::Unhomed;
+        }
+        motor.stop();
+        mutex.unlock();
+    }
+
+    // 制御周期ごとに呼ぶ
+    void update()
+    {
+        mutex.lock();
+
+        switch (state)
+        {
+        case State::Unhomed:
+        case State::Idle:
+        case State::Fault:
+            break;
+
+        case State::Homing:
+            updateHoming();
+            break;
+
+        case State::Moving:
+            updateMoving();
+            break;
+        }
+
+        mutex.unlock();
+    }
+
+private:
+    // ホストのツールが内部の状態を直接読むためのアクセサー (tools/pseudo_servo_check)
+    template <typename>
+    friend struct PseudoServoAccess;
+
+    enum class State
+    {
+        Unhomed, // 原点未確定
+        Homing,  // 原点復帰中
+        Idle,    // 原点確定済みで停止中
+        Moving,  // 目標角度へ移動中・保持中
+        Fault,   // 原点復帰に失敗して停止中
+    };
+
+    Motor &motor;
+    Encoder &encoder;
+    LimitSwitch &limit_switch;
+    PseudoServoConfig config;
+    PIDController<float> position_pid;
+    PIDController<float> velocity_pid;
+
+    Mutex mutex;
+    EventFlags flags;
+    static constexpr uint32_t REACHED_SIGNAL = 1;
+
+    State state;
+    Radian target;
+    Radian reference;         // プロファイル上の現在の目標角度
+    float reference_velocity; // プロファイル上の現在の目標角速度[rad/s]
+    Radian last_angle;
+    Timer homing_timer;
+
+    // mutexをロックした状態で呼ぶ
+    void startFromCurrentAngle()
+    {
+        last_angle = getAngle();
+        reference = last_angle;
+        reference_velocity = 0.0f;
+        // 止まっている間の偏差が残っていると、動き始めに微分項が跳ねるので捨てる
+        position_pid.restart();
+        velocity_pid.restart();
+    }
+
+    void updateHoming()
+    {
+        if (!limit_switch.isPressed())
+        {
+            if (homing_timer.elapsed_time() >= config.homing_timeout)
+            {
+                // 押されないまま回し続けるとモーターが拘束されて焼けるので止める
+                motor.stop();
+                state = State::Fault;
+                return;
+            }
+
+            motor.setDuty(config.homing_duty);
+            return;
+        }
+
+        motor.stop();
+        encoder.reset();
+
+        // 原点の位置で保持する
+        startFromCurrentAngle();
+        target = reference;
+        state = State::Moving;
+    }
+
+    void updateMoving()
+    {
+        const float dt = 1.0f / config.position_pid_gain.frequency;
+
+        Radian angle = getAngle();
+        float velocity = (angle - last_angle).value / dt;
+        last_angle = angle;
+
+        updateProfile(dt);
+
+        // 位置ループの出力をプロファイルの速度に足してフィードフォワードにする
+        float velocity_command = reference_velocity + position_pid.calculate((reference - angle).value);
+        float duty = velocity_pid.calculate(velocity_command - velocity);
+        duty = fmax(-config.max_duty, fmin(config.max_duty, duty));
+        motor.setDuty(duty);
+
+        bool is_profile_done = reference == target && reference_velocity == 0.0f;
+        if (is_profile_done && fabs((target - angle).value) <= config.tolerance.value)
+        {
+            flags.set(REACHED_SIGNAL);
+        }
+    }
+
+    // 台形速度プロファイルを1周期進める
+    // 速度も加速度も制限を超えないよう、制御周期の刻みで止まれる速度を目指す。
+    void updateProfile(float dt)
+    {
+        float distance = (target - reference).value;
+        float max_step = config.max_acceleration * dt;
+
+        // 残り距離で止まれる速度と最高速度の小さい方を目指す
+        // 1周期ごとにmax_stepずつ減速すると、速度vから止まるまでに v * (v + max_step) / (2 * max_acceleration) 進む。
+        // それが残り距離に等しくなるvを解く (連続時間の sqrt(2 * a * d) だと最後の周期で減速しきれない)。
+        float stoppable = 0.5f * (sqrt(max_step * max_step + 8.0f * config.max_acceleration * fabs(distance)) - max_step);
+        float desired = copysign(fmin(config.max_velocity.value, stoppable), distance);
+
+        float previous_velocity = reference_velocity;
+        reference_velocity += fmax(-max_step, fmin(max_step, desired - reference_velocity));
+
+        // 目標を越える向きに進み、かつ前の周期の速度から1周期で止まれるときだけ目標で止める。
+        // 止まれないとき(動いている途中で目標を手前に変えたときなど)は越えてから戻る (加速度の上限を守るため)。
+        float step = reference_velocity * dt;
+        bool crosses = distance >= 0.0f ? step >= distance : step <= distance;
+        if (crosses && fabs(previous_velocity) <= max_step)
+        {
+            reference = target;
+            reference_velocity = 0.0f;
+        }
+        else
+        {
+            reference += Radian(step);
+        }
+    }
+};
+
+using PseudoServo = PseudoServoT<DCMotor>;
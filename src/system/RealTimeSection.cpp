@@ -0,0 +1,89 @@
+// RealTimeSectionの確保のフック
+// リンカーの--wrapでmalloc, calloc, reallocを__wrap_*に差し替え、確保の前に検査する。
+// operator new (mbed-osのmbed_retarget.cpp、ホストではlibstdc++)もEigenもmallocで確保するので、まとめて検出できる。
+// operator newを置き換えるとmbed-osの定義と重複するので、置き換えない。
+//
+// リンクに必要なフラグ (platformio.iniのbuild_flagsに入れてある)
+//   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+// ホストでは-DREALTIME_SECTION_HOSTを付け、libstdc++の中のoperator newからの呼び出しも差し替えるように-static-libstdc++も付ける。
+// mbed-osのGCC_ARMは_malloc_rなどを--wrapしている(ヒープの統計用)が、newlibのmallocは_malloc_rを呼ぶだけなので両立する。
+#include "RealTimeSection.hpp"
+#include <cstdio>
+#include <cstdlib>
+#ifdef REALTIME_SECTION_HOST
+#include <execinfo.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    std::atomic<bool> trap_enabled(true);
+    std::atomic<int> violation_count(0);
+
+    void checkAllocation(const char *source, size_t size)
+    {
+        if (RealTimeSection::isInside())
+        {
+            RealTimeSection::reportAllocation(source, size);
+        }
+    }
+}
+
+void RealTimeSection::reportAllocation(const char *source, size_t size)
+{
+    violation_count.fetch_add(1, std::memory_order_relaxed);
+
+    // 報告の途中の確保(バックトレースなど)で再び報告しないよう、最初の1回でトラップを外す
+    if (!trap_enabled.exchange(false, std::memory_order_relaxed))
+    {
+        return;
+    }
+
+#ifndef REALTIME_SECTION_HOST
+    // errorは表示して停止する
+    error("heap allocation in real-time section: %s, %u bytes\n", source, (unsigned)size);
+#else
+    // ホストではどこで確保したかを表示する (-rdynamicでリンクすると関数名が出る)
+    fprintf(stderr, "heap allocation in real-time section: %s, %zu bytes\n", source, size);
+    void *frames[32];
+    int depth = backtrace(frames, 32);
+    backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+    abort();
+#endif
+}
+
+void RealTimeSection::setTrap(bool trap)
+{
+    trap_enabled.store(trap, std::memory_order_relaxed);
+}
+
+int RealTimeSection::getViolationCount()
+{
+    return violation_count.load(std::memory_order_relaxed);
+}
+
+extern "C"
+{
+    // --wrapで本来のmalloc, calloc, reallocを指す
+    void *__real_malloc(size_t size);
+    void *__real_calloc(size_t count, size_t size);
+    void *__real_realloc(void *pointer, size_t size);
+
+    void *__wrap_malloc(size_t size)
+    {
+        checkAllocation("malloc", size);
+        return __real_malloc(size);
+    }
+
+    void *__wrap_calloc(size_t count, size_t size)
+    {
+        checkAllocation("calloc", count * size);
+        return __real_calloc(count, size);
+    }
+
+    void *__wrap_realloc(void *pointer, size_t size)
+    {
+        checkAllocation("realloc", size);
+        return __real_realloc(pointer, size);
+    }
+}
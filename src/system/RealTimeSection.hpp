@@ -0,0 +1,119 @@
+#pragma once
+#include <mbed.hpp>
+#include <atomic>
+#include <cstddef>
+
+// 実時間区間 (制御周期の1周分の処理) の中でのヒープ確保を検出する
+// 区間の中でmalloc (operator newやEigenの動的確保を含む)が呼ばれたら報告して停止する (setTrap(false)なら数えるだけ)。
+// ヒープ確保は時間が読めず、RAMの少ないマイコンでは断片化で失敗することもあるので、制御周期の中では禁止する。
+//
+// 確保のフックはRealTimeSection.cppにある。リンカーの--wrapでmalloc, calloc, reallocを差し替えるので、
+// リンクにはplatformio.iniのbuild_flagsの-Wl,--wrap=...が要る。
+//
+// 区間はスレッドごとに数える(入れ子にできる)。区間の外のスレッド(printfするメインループなど)の確保は対象外。
+// ホストのツール(tools/realtime_check)は-DREALTIME_SECTION_HOSTでビルドし、スレッドの区別とバックトレースにOSの機能を使う。
+//
+// ### example
+// while (true)
+// {
+//     flags.wait_any(UPDATE_SIGNAL);
+//
+//     RealTimeSection section;
+//     odometry.updatePosition();
+// }
+class RealTimeSection
+{
+public:
+    static constexpr int MAX_THREADS = 8; // 同時に区間に入れるスレッドの最大数
+
+    RealTimeSection()
+    {
+        ThreadEntry *entry = findEntry(currentThread());
+        if (entry == nullptr)
+        {
+            entry = claimEntry(currentThread());
+        }
+        entry->depth++;
+    }
+
+    ~RealTimeSection()
+    {
+        ThreadEntry *entry = findEntry(currentThread());
+        if (--entry->depth == 0)
+        {
+            entry->thread.store(nullptr, std::memory_order_release);
+        }
+    }
+
+    RealTimeSection(const RealTimeSection &) = delete;
+    RealTimeSection &operator=(const RealTimeSection &) = delete;
+
+    // 呼び出したスレッドが区間の中にいるか
+    static bool isInside()
+    {
+        return findEntry(currentThread()) != nullptr;
+    }
+
+    // 区間の中での確保を報告する (確保のフックから呼ばれる)
+    // source: 確保した関数 ("malloc", "calloc", "realloc"), size: バイト数
+    static void reportAllocation(const char *source, size_t size);
+
+    // true: 報告したら停止する (既定), false: 数えるだけ
+    static void setTrap(bool trap);
+
+    // これまでに区間の中で確保した回数
+    static int getViolationCount();
+
+private:
+    struct ThreadEntry
+    {
+        std::atomic<const void *> thread; // 区間に入っているスレッド (空きはnullptr)
+        int depth;                        // 入れ子の深さ (そのスレッドだけが書き換える)
+    };
+
+    // スレッドごとの状態は表で持つ
+    // (mbedのRTXはthread_localに対応していないため)
+    static inline ThreadEntry entries[MAX_THREADS] = {};
+
+#ifdef REALTIME_SECTION_HOST
+    static const void *currentThread()
+    {
+        static thread_local char marker;
+        return &marker;
+    }
+#else
+    static const void *currentThread()
+    {
+        return ThisThread::get_id();
+    }
+#endif
+
+    static ThreadEntry *findEntry(const void *thread)
+    {
+        for (ThreadEntry &entry : entries)
+        {
+            if (entry.thread.load(std::memory_order_acquire) == thread)
+            {
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static ThreadEntry *claimEntry(const void *thread)
+    {
+        for (ThreadEntry &entry : entries)
+        {
+            const void *empty = nullptr;
+            if (entry.thread.compare_exchange_strong(empty, thread, std::memory_order_acq_rel))
+            {
+                entry.depth = 0;
+                return &entry;
+            }
+        }
+
+        // MAX_THREADSを増やすこと (NDEBUGでも止める)
+        error("RealTimeSection: more than %d threads in real-time sections\n", MAX_THREADS);
+    }
+};
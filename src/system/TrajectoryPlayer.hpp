@@ -0,0 +1,107 @@
+#pragma once
+#include <mbed.hpp>
+#include "units/units.hpp"
+#include "PathFollower.hpp"
+
+// 軌道表の1点 (フィールド座標系)
+struct TrajectoryPoint
+{
+    float time;        // 開始からの時刻[s]
+    Position position; // 目標位置
+    Velocity velocity; // 目標速度
+};
+
+// tools/trajectory_plannerで事前計算した軌道表を再生する
+// 表の速度をフィードフォワードとし、位置の偏差だけをP制御で補正する。
+// 経路計画はオフラインで済んでいるので、制御周期ごとの処理は表の線形補間のみ。
+class TrajectoryPlayer : public IPathFollower
+{
+public:
+    // points: constexprで定義した軌道表 (フラッシュに配置される)
+    // position_gain: 位置偏差に対するゲイン[1/s]
+    // heading_gain: 角度偏差に対するゲイン[1/s]
+    template <int K>
+    TrajectoryPlayer(const TrajectoryPoint (&points)[K], float position_gain, float heading_gain)
+        : points(points), size(K), position_gain(position_gain), heading_gain(heading_gain)
+    {
+        static_assert(K > 1, "K must be greater than 1.");
+        reset();
+    }
+
+    // 最初から再生し直す。時刻は次のcalculateから数え始める。
+    void reset()
+    {
+        cursor = 0;
+        is_started = false;
+        timer.stop();
+        timer.reset();
+    }
+
+    Velocity calculate(Position current_position) override
+    {
+        if (!is_started)
+        {
+            timer.start();
+            is_started = true;
+        }
+
+        TrajectoryPoint reference = getPointAt(chrono::duration<float>(timer.elapsed_time()).count());
+
+        float error_x = reference.position.x.value - current_position.x.value;
+        float error_y = reference.position.y.value - current_position.y.value;
+        Radian error_theta = normalizeAngle(reference.position.theta - current_position.theta);
+
+        return Velocity{
+            MeterPerSecond(reference.velocity.x.value + position_gain * error_x),
+            MeterPerSecond(reference.velocity.y.value + position_gain * error_y),
+            RadPerSecond(reference.velocity.theta.value + heading_gain * error_theta.value),
+        };
+    }
+
+    bool isFinished() override
+    {
+        return is_started && chrono::duration<float>(timer.elapsed_time()).count() >= points[size - 1].time;
+    }
+
+    Position getFinalPosition() override
+    {
+        return points[size - 1].position;
+    }
+
+private:
+    const TrajectoryPoint *points;
+    int size;
+    float position_gain;
+    float heading_gain;
+
+    Timer timer;
+    bool is_started;
+    int cursor; // 前回参照した区間 (時刻は単調増加なので前から順に進めるだけでよい)
+
+    // 時刻tの目標を表から線形補間する
+    TrajectoryPoint getPointAt(float t)
+    {
+        while (cursor < size - 2 && points[cursor + 1].time <= t)
+        {
+            cursor++;
+        }
+
+        const TrajectoryPoint &from = points[cursor];
+        const TrajectoryPoint &to = points[cursor + 1];
+
+        float ratio = (t - from.time) / (to.time - from.time);
+        ratio = ratio < 0.0f ? 0.0f : (ratio > 1.0f ? 1.0f : ratio);
+
+        return TrajectoryPoint{
+            t,
+            Position(
+                from.position.x + (to.position.x - from.position.x) * ratio,
+                from.position.y + (to.position.y - from.position.y) * ratio,
+                from.position.theta + normalizeAngle(to.position.theta - from.position.theta) * ratio),
+            Velocity(
+                from.velocity.x + (to.velocity.x - from.velocity.x) * ratio,
+                from.velocity.y + (to.velocity.y - from.velocity.y) * ratio,
+                from.velocity.theta + (to.velocity.theta - from.velocity.theta) * ratio),
+        };
+    }
+};
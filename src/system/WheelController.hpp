@@ -1,25 +1,37 @@
 #pragma once
+#include <optional>
 #include "WheelConfig.hpp"
 #include "WheelVector.hpp"
 #include "DutyController.hpp"
+#include "GainScheduledPIDController.hpp"
+#include "driver/MotorGroup.hpp"
 #include "units/units.hpp"
+#include "RealTimeSection.hpp"
 
 // N: 駆動輪の数
 template <int N>
 class WheelController
 {
 public:
-    WheelController(array<MotorWheel, N> &motor_wheels, PIDGain &pid_gain, MeterPerSecond max_speed, float max_duty = 1.0f)
-        : pid_controller(pid_gain), max_speed(max_speed), max_duty(max_duty)
+    static constexpr int POSITION_GAIN_POINTS = 3; // 位置制御のゲインスケジュール表の点数
+
+    // position_gain_schedule: 並進の偏差の大きさ[m]で位置制御のゲインを補間する表 (nullptrならpid_gainで固定)
+    //                         表は参照するので、constexprなどの寿命の長い変数にすること。
+    WheelController(array<MotorWheel, N> &motor_wheels, PIDGain &pid_gain, MeterPerSecond max_speed, float max_duty = 1.0f,
+                    const GainSchedule<POSITION_GAIN_POINTS> *position_gain_schedule = nullptr)
+        : pid_controller(pid_gain), motor_group(getMotors(motor_wheels)), max_speed(max_speed), max_duty(max_duty)
     {
+        if (position_gain_schedule != nullptr)
+        {
+            scheduled_pid_controller.emplace(*position_gain_schedule, pid_gain.frequency);
+        }
+
         for (int i = 0; i < N; i++)
         {
             MeasuringWheel &measuring_wheel = motor_wheels[i].measuring_wheel;
-            DCMotor &dc_motor = motor_wheels[i].dc_motor;
             PIDGain pid_gain = motor_wheels[i].pid_gain;
 
             wheel_vectors[i] = getWheelVector(measuring_wheel.positions);
-            dc_motors[i] = &dc_motor;
             duty_controllers[i] = std::make_unique<DutyController>(measuring_wheel.encoder, pid_gain);
 
             // clang-format off
@@ -33,19 +45,61 @@ public:
         thread.start(callback(this, &WheelController::updateCurrentRps));
     }
 
-    void updateMotors(Position error)
+    // error: フィールド座標系での偏差
+    // current_theta: 現在の機体の向き (フィールド座標系からロボット座標系への変換に使う)
+    void updateMotors(Position error, Radian current_theta)
     {
-        array<float, N> duty = getTargetMotorDuty(error);
-        for (int i = 0; i < N; i++)
+        updateMotors(getTargetFieldVelocity(error), current_theta);
+    }
+
+    // 経路追従などで速度を直接指令する
+    // field_velocity: フィールド座標系での目標速度
+    void updateMotors(Velocity field_velocity, Radian current_theta)
+    {
+        array<float, N> duty = getTargetMotorDuty(fieldToBodyVelocity(field_velocity, current_theta));
+
+        // 全輪のduty比を同時に反映する
+        motor_group.stage(duty);
+        motor_group.commit();
+    }
+
+    // 各駆動輪のduty比を直接指令する (MpcControllerの出力など)
+    void updateMotors(const array<float, N> &duty)
+    {
+        motor_group.stage(duty);
+        motor_group.commit();
+    }
+
+    // 位置制御のPIDの積分値と前回の偏差を捨てて、次の更新からやり直す (経路追従から位置制御に切り替えるとき用)
+    void restartPid()
+    {
+        pid_controller.restart();
+        if (scheduled_pid_controller)
         {
-            dc_motors[i]->setDuty(duty[i]);
+            scheduled_pid_controller->restart();
         }
     }
 
 private:
+    // ホストのツールが内部の計算を直接呼ぶためのアクセサー (tools/micro_bench, tools/position_sim)
+    template <int>
+    friend struct WheelControllerAccess;
+
+    static array<DCMotor *, N> getMotors(array<MotorWheel, N> &motor_wheels)
+    {
+        array<DCMotor *, N> motors;
+        for (int i = 0; i < N; i++)
+        {
+            motors[i] = &motor_wheels[i].dc_motor;
+        }
+
+        return motors;
+    }
+
     PIDController<Position> pid_controller;
+    std::optional<GainScheduledPIDController<Position, POSITION_GAIN_POINTS>> scheduled_pid_controller; // 表を渡したときだけ使う
     array<WheelVector, N> wheel_vectors;
-    array<DCMotor *, N> dc_motors;
+    MotorGroup<N> motor_group;
     // array<DutyController, N>にした場合、理由は不明だが(DutyControllerのメンバ変数であるMutexがコピーできないため?)、
     // 配列初期化時にデフォルトコンストラクタ、配列代入時にコピーコンストラクタが必要になる。
     // ここでコピーコンストラクタを実装してしまうと他の場所でもDutyControllerをコピーできるようになってしまう。
@@ -58,9 +112,8 @@ private:
     MeterPerSecond max_speed;
     float max_duty;
 
-    array<float, N> getTargetMotorDuty(Position error)
+    array<float, N> getTargetMotorDuty(Velocity target_body_velocity)
     {
-        Velocity target_body_velocity = getTargetBodyVelocity(error);
         array<MeterPerSecond, N> target_motor_velocity = bodyVelocityToMotorSpeeds(target_body_velocity);
 
         array<float, N> motor_duty;
@@ -87,10 +140,14 @@ private:
         return motor_duty;
     }
 
-    Velocity getTargetBodyVelocity(Position error)
+    Velocity getTargetFieldVelocity(Position error)
     {
-        Position result = pid_controller.calculate(error);
-        // 返ってくるのは操作量 = 速度なので型変換
+        // 並進と回転はそれぞれ独立にフィールド座標系でPID制御する。
+        // ロボット座標系で積分すると旋回中に積分値の向きがずれるため。
+        // 表があれば並進の偏差の大きさでゲインを切り替える (遠くでは巡航、近くでは最終位置合わせ)
+        Position result = scheduled_pid_controller ? scheduled_pid_controller->calculate(error, hypot(error.x.value, error.y.value))
+                                                   : pid_controller.calculate(error);
+        // 返ってくるのは操作量 = フィールド座標系の速度なので型変換
         return Velocity{
             MeterPerSecond(result.x.value),
             MeterPerSecond(result.y.value),
@@ -98,6 +155,13 @@ private:
         };
     }
 
+    // フィールド座標系の速度を-thetaだけ回転させてロボット座標系に変換
+    Velocity fieldToBodyVelocity(Velocity field_velocity, Radian current_theta)
+    {
+        return Pose2::rotation(current_theta).inverseRotate(field_velocity);
+    }
+
+    // ロボット座標系の速度から各駆動輪の速度を求める (max_speedを超える輪があれば全輪を同じ比で減速する)
     array<MeterPerSecond, N> bodyVelocityToMotorSpeeds(const Velocity velocity)
     {
         array<MeterPerSecond, N> speeds;
@@ -139,6 +203,7 @@ private:
             {
                 update_current_rps_flags.wait_any(update_current_rps_signals[i]);
 
+                RealTimeSection section;
                 this->duty_controllers[i]->updateCurrentRps();
             }
         }
@@ -1,5 +1,6 @@
 #pragma once
-#include "WheelConfig.hpp"
+#include "WheelSettings.hpp"
+#include "units/fastMath.hpp"
 
 struct WheelVector
 {
@@ -17,14 +18,16 @@ struct WheelVectorInv
 
 // 車輪の位置から車輪のベクトル(vx, vy, omegaそれぞれの係数)を計算する
 // 車輪の速度ベクトルが(vx, vy) + omega * (-wheel_y, wheel_x)で、これの車輪の方向(cos(theta), sin(theta))との内積を取り、そのvx, vy, omegaの係数を求める
+// FastMathのsincosを使うので、車輪の配置が定数ならコンパイル時に求まる
 constexpr WheelVector getWheelVector(const WheelPositions wheel_position)
 {
     Position wheel_pos = wheel_position.position;
     Meter wheel_radius = wheel_position.radius;
 
     float wheel_circumference = 2 * (float)M_PI * wheel_radius.value;
-    float x = cos(wheel_pos.theta.value) / wheel_circumference;
-    float y = sin(wheel_pos.theta.value) / wheel_circumference;
+    FastMath::SinCos direction = FastMath::sincos(wheel_pos.theta.value);
+    float x = direction.cos / wheel_circumference;
+    float y = direction.sin / wheel_circumference;
     float theta = (wheel_pos.x.value * y - wheel_pos.y.value * x);
 
     return WheelVector{
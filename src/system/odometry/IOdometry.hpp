@@ -1,6 +1,10 @@
+#pragma once
+#include <mbed.hpp>
 #include "units/units.hpp"
 #include "system/WheelVector.hpp"
-#include <Dense.h>
+#include "system/LeastSquares.hpp"
+#include "PoseHistory.hpp"
+#include <ControlMath.h>
 
 // Odometryの抽象クラス
 // Imu, LimitSwitch, TOFなどで拡張した具象クラスをつくってね。
@@ -11,9 +15,47 @@ public:
     virtual Position getCurrentPosition() = 0;
     virtual void setCurrentPosition(Position current_position) = 0;
     virtual void updatePosition() = 0;
+    // 現在の姿勢と姿勢履歴に剛体変換correctionを掛ける (壁との接触による補正など)
+    // setCurrentPositionと違い、センサーの基準(IMUのヨーなど)はリセットしない。
+    virtual void applyCorrection(const Pose2 &correction) = 0;
+
+    // timestampの時点の姿勢を履歴から補間して返す
+    // ロックフリーなので、割り込み以外ならどのスレッドからでも呼べる。
+    // 戻り値: true: 取得できた, false: 履歴より古い時刻
+    bool getPositionAt(HighResClock::time_point timestamp, Position &position) const
+    {
+        return pose_history.find(timestamp, position);
+    }
+
+    // 車輪の配置の条件数 (1に近いほど良い)
+    // 大きいと、エンコーダーの誤差が機体速度に拡大されて伝わる。
+    float getWheelConditionNumber() const
+    {
+        return wheel_condition_number;
+    }
 
 protected:
-    static array<WheelVectorInv, N> getWheelVectorInv(const array<WheelPositions, N> &wheel_position)
+    static constexpr int POSE_HISTORY_SIZE = 64;                 // 姿勢履歴の長さ (5ms周期で320ms)
+    static constexpr float MAX_WHEEL_CONDITION_NUMBER = 1000.0f; // これより悪い配置は起動時に止める
+
+    // 具象クラスはupdatePositionのたびに、位置を更新したMutexの中で呼ぶこと
+    void recordPose(Position position)
+    {
+        pose_history.push(HighResClock::now(), position);
+    }
+
+    // setCurrentPositionで座標系が変わったときに、位置を更新するMutexの中で呼ぶこと
+    void clearPoseHistory()
+    {
+        pose_history.clear();
+    }
+
+    PoseHistory<HighResClock::time_point, POSE_HISTORY_SIZE> pose_history;
+    float wheel_condition_number = 1.0f;
+
+    // 車輪の回転数 -> 機体速度 の行列を求め、配置の条件数を記録する
+    // 配置が悪い(ランク落ちに近い)ときは起動時にerrorで止める (NDEBUGでも止める)。
+    array<WheelVectorInv, N> getWheelVectorInv(const array<WheelPositions, N> &wheel_position)
     {
         Eigen::Matrix<float, N, 3> wheel_matrix; // 車輪のベクトルを格納する行列
         for (int i = 0; i < N; i++)
@@ -24,16 +66,14 @@ protected:
             wheel_matrix(i, 2) = wheel_vector.theta;
         }
 
-        Eigen::Matrix<float, 3, N> wheel_matrix_inv; // 逆行列 (N>=4のときMoore-Penroseの疑似逆行列)
-        // コンパイル時にif文を処理してEigenのstatic_assertを回避。c++17以降。
-        if constexpr (N == 3)
-        {
-            wheel_matrix_inv = wheel_matrix.inverse();
-        }
-        else
+        // 逆行列 (N>=4のときは最小二乗の疑似逆行列 (A^T A)^-1 A^T)
+        LeastSquaresSolution<float, N, 3> solution = solveLeastSquares(wheel_matrix);
+        wheel_condition_number = solution.condition_number;
+        if (!(wheel_condition_number <= MAX_WHEEL_CONDITION_NUMBER))
         {
-            wheel_matrix_inv = wheel_matrix.transpose() * (wheel_matrix * wheel_matrix.transpose()).inverse();
+            error("wheel layout is ill-conditioned: condition number %f > %f\n", wheel_condition_number, MAX_WHEEL_CONDITION_NUMBER);
         }
+        const Eigen::Matrix<float, 3, N> &wheel_matrix_inv = solution.pseudo_inverse;
 
         array<WheelVectorInv, N> wheel_vectors_inv; // 車輪のベクトルの逆行列
         for (int i = 0; i < N; i++)
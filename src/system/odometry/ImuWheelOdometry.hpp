@@ -1,9 +1,10 @@
 #pragma once
 #include "WheelConfig.hpp"
-#include "system/wheelVector.hpp"
+#include "IOdometry.hpp"
+#include "system/WheelVector.hpp"
 #include "driver/Encoder.hpp"
 #include "driver/Imu.hpp"
-#include <Dense.h>
+#include <ControlMath.h>
 
 // ヨーだけImuに任せたオドメトリ
 template <int N>
@@ -12,7 +13,7 @@ class ImuWheelOdometry : public IOdometry<N>
     static_assert(N > 2, "N must be greater than 2.");
 
 public:
-    ImuWheelOdometry(array<MeasuringWheel, N> &measuring_wheels, Imu &imu) : imu(imu), position(0_m, 0_m, 0_rad)
+    ImuWheelOdometry(array<MeasuringWheel, N> &measuring_wheels, Imu &imu) : imu(imu)
     {
         array<WheelPositions, N> wheel_positions;
         for (int i = 0; i < N; i++)
@@ -29,7 +30,7 @@ public:
     Position getCurrentPosition() override
     {
         mutex.lock();
-        Position position = this->position;
+        Position position = pose.getPosition();
         mutex.unlock();
 
         return position;
@@ -38,7 +39,8 @@ public:
     void setCurrentPosition(Position current_position) override
     {
         mutex.lock();
-        position = current_position;
+        pose = Pose2(current_position);
+        this->clearPoseHistory();
 
         // ヨーはcurrent_position.thetaを0として計算
         imu.resetYaw();
@@ -46,6 +48,19 @@ public:
         mutex.unlock();
     }
 
+    void applyCorrection(const Pose2 &correction) override
+    {
+        mutex.lock();
+        Radian theta = pose.getPosition().theta;
+        pose = correction.compose(pose);
+        this->pose_history.transform([&](Position position)
+                                     { return correction.transformPoint(position); });
+
+        // IMUはresetYawせず、向きの補正はyaw_offsetに足す (IMUの基準とキャリブレーションはそのまま)
+        yaw_offset += normalizeAngle(pose.getPosition().theta - theta).value;
+        mutex.unlock();
+    }
+
     void updatePosition() override
     {
         array<int, N> encoder_counts;
@@ -57,7 +72,9 @@ public:
         float delta_x = 0.0;
         float delta_y = 0.0;
         // float delta_theta = 0.0;
-        float delta_theta = imu.getYaw() + yaw_offset - position.theta.value;
+        // getYawは度で[-180, 180]に折り返されるので、ラジアンに直してから前回の向きとの差を[-π, π]に正規化する
+        Radian yaw = Radian(yaw_offset) + Degree(imu.getYaw());
+        float delta_theta = normalizeAngle(yaw - pose.getPosition().theta).value;
 
         for (int i = 0; i < N; i++)
         {
@@ -69,15 +86,12 @@ public:
             // delta_theta += encoder_delta * wheel_vectors_inv[i].theta;
         }
 
-        // ロボット座標系からフィールド座標系への変換を含む位置と姿勢の更新
-        float theta = position.theta.value;
-        float delta_x_abs = delta_x * cos(theta + delta_theta / 2) - delta_y * sin(theta + delta_theta / 2); // x方向の移動量 (フィールド座標系)
-        float delta_y_abs = delta_x * sin(theta + delta_theta / 2) + delta_y * cos(theta + delta_theta / 2); // y方向の移動量 (フィールド座標系)
+        // ロボット座標系での移動を一定の速度で進んだ円弧とみなして、フィールド座標系の姿勢に合成する
+        Pose2 step = Pose2::exp(Position(Meter(delta_x), Meter(delta_y), Radian(delta_theta)));
 
         mutex.lock();
-        position.x += Meter(delta_x_abs);
-        position.y += Meter(delta_y_abs);
-        position.theta += Radian(delta_theta);
+        pose = pose.compose(step);
+        this->recordPose(pose.getPosition());
         mutex.unlock();
     }
 
@@ -89,5 +103,5 @@ private:
     array<WheelVectorInv, N> wheel_vectors_inv;
     Imu &imu;
     float yaw_offset;
-    Position position;
+    Pose2 pose; // 現在の姿勢 (向きのcos, sinを持つので、更新のたびに三角関数を呼ばずに済む)
 };
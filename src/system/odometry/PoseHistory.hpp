@@ -0,0 +1,218 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include "units/units.hpp"
+
+// 時刻付きの姿勢の履歴 (固定長リングバッファ)
+// 書き込みは1スレッドずつ(オドメトリのMutexの中)、読み出しはロックフリーでどのスレッドからでもできる。
+//
+// 各スロットに「何番目に書かれた姿勢か」を表すシーケンス番号を持たせる (書き込み中は奇数)。
+// 読み出し側はコピーの前後でシーケンス番号が期待した値のままかを確認し、
+// 途中で上書きされていたらやり直す (seqlock)。
+//
+// 時刻は単調増加なので二分探索でO(log Size)で引ける。前後の姿勢の間はSE(2)上で補間する。
+// TimePoint: 時刻の型 (std::chrono::time_point)
+template <typename TimePoint, int Size>
+class PoseHistory
+{
+    static_assert(Size > 1, "Size must be greater than 1.");
+
+public:
+    PoseHistory() : write_count(0), start_count(0)
+    {
+        for (Slot &slot : slots)
+        {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 姿勢を追加する (書き込み側)
+    void push(TimePoint timestamp, Position position)
+    {
+        uint32_t index = write_count.load(std::memory_order_relaxed);
+        Slot &slot = slots[index % Size];
+
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timestamp = timestamp;
+        slot.position = position;
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+
+        write_count.store(index + 1, std::memory_order_release);
+    }
+
+    // 履歴を空にする (書き込み側)。座標系が変わったときに使う。
+    void clear()
+    {
+        start_count.store(write_count.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    // 履歴の姿勢すべてにfunctionを掛ける (書き込み側)。オドメトリの補正に使う。
+    template <typename Function>
+    void transform(Function function)
+    {
+        uint32_t end = write_count.load(std::memory_order_relaxed);
+        for (uint32_t index = getBegin(end); index != end; index++)
+        {
+            Slot &slot = slots[index % Size];
+
+            slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.position = function(slot.position);
+            slot.sequence.store(index * 2 + 2, std::memory_order_release);
+        }
+    }
+
+    // timestampの姿勢を補間して返す (読み出し側)
+    // 最新より新しい時刻は最新の姿勢を返す。履歴より古い時刻、または履歴が空ならfalse。
+    bool find(TimePoint timestamp, Position &position) const
+    {
+        // 探索中に古い方のスロットが上書きされたらやり直す
+        for (int retry = 0; retry < MAX_RETRIES; retry++)
+        {
+            Result result = tryFind(timestamp, position);
+            if (result != Result::Overwritten)
+            {
+                return result == Result::Found;
+            }
+        }
+
+        return false;
+    }
+
+    // 保持している姿勢の数 (読み出し側)
+    int size() const
+    {
+        uint32_t end = write_count.load(std::memory_order_acquire);
+        return (int)(end - getBegin(end));
+    }
+
+    // aとbの間をratio(0~1)でSE(2)上で補間する
+    // 並進と回転を別々に線形補間すると、旋回しながら進んだ区間で弦の上の点になってしまう。
+    // aから見たbの相対姿勢をlogで一定の速度(ツイスト)に直し、ratio倍してexpで戻す。
+    // logとexpの並進の部分は回転と拡大の合成で向きの回転と可換なので、aの向きで回さずにフィールド座標系の差のまま計算できる。
+    // 隣り合う履歴の間は回転角が小さく、log, expとも級数で済むので三角関数を呼ばない。
+    static Position interpolate(Position a, Position b, float ratio)
+    {
+        Position twist = Pose2::log(b - a);
+
+        return a + Pose2::exp(twist * ratio).getPosition();
+    }
+
+private:
+    static constexpr int MAX_RETRIES = 4;
+
+    struct Slot
+    {
+        std::atomic<uint32_t> sequence; // index * 2 + 2: 書き込み済み, index * 2 + 1: 書き込み中
+        TimePoint timestamp;
+        Position position;
+    };
+
+    struct Sample
+    {
+        TimePoint timestamp;
+        Position position;
+    };
+
+    enum class Result
+    {
+        Found,
+        NotFound,
+        Overwritten,
+    };
+
+    Slot slots[Size];
+    std::atomic<uint32_t> write_count; // これまでに書き込んだ数 (次に書き込む番号)
+    std::atomic<uint32_t> start_count; // clear()した時点のwrite_count
+
+    uint32_t getBegin(uint32_t end) const
+    {
+        uint32_t start = start_count.load(std::memory_order_acquire);
+        uint32_t oldest = end > (uint32_t)Size ? end - Size : 0;
+        // start_countはwrite_count以下なので、差で比べればオーバーフローしても正しい
+        return end - start < end - oldest ? start : oldest;
+    }
+
+    // index番目の姿勢を読む。上書きされていたらfalse。
+    bool read(uint32_t index, Sample &sample) const
+    {
+        const Slot &slot = slots[index % Size];
+        uint32_t expected = index * 2 + 2;
+
+        if (slot.sequence.load(std::memory_order_acquire) != expected)
+        {
+            return false;
+        }
+        sample.timestamp = slot.timestamp;
+        sample.position = slot.position;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        return slot.sequence.load(std::memory_order_relaxed) == expected;
+    }
+
+    Result tryFind(TimePoint timestamp, Position &position) const
+    {
+        uint32_t end = write_count.load(std::memory_order_acquire);
+        uint32_t begin = getBegin(end);
+        if (begin == end)
+        {
+            return Result::NotFound;
+        }
+
+        Sample newest;
+        if (!read(end - 1, newest))
+        {
+            return Result::Overwritten;
+        }
+        if (timestamp >= newest.timestamp)
+        {
+            position = newest.position;
+            return Result::Found;
+        }
+
+        Sample oldest;
+        if (!read(begin, oldest))
+        {
+            return Result::Overwritten;
+        }
+        if (timestamp < oldest.timestamp)
+        {
+            return Result::NotFound;
+        }
+
+        // timestamp(low) <= timestamp < timestamp(high) となる区間を二分探索
+        uint32_t low = begin;
+        uint32_t high = end - 1;
+        Sample low_sample = oldest;
+        Sample high_sample = newest;
+        while (high - low > 1)
+        {
+            uint32_t middle = low + (high - low) / 2;
+            Sample sample;
+            if (!read(middle, sample))
+            {
+                return Result::Overwritten;
+            }
+
+            if (sample.timestamp <= timestamp)
+            {
+                low = middle;
+                low_sample = sample;
+            }
+            else
+            {
+                high = middle;
+                high_sample = sample;
+            }
+        }
+
+        float interval = std::chrono::duration<float>(high_sample.timestamp - low_sample.timestamp).count();
+        float ratio = interval > 0.0f ? std::chrono::duration<float>(timestamp - low_sample.timestamp).count() / interval : 0.0f;
+        position = interpolate(low_sample.position, high_sample.position, ratio);
+
+        return Result::Found;
+    }
+};
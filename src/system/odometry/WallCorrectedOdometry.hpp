@@ -0,0 +1,228 @@
+#pragma once
+#include <mbed.hpp>
+#include <cmath>
+#include "IOdometry.hpp"
+#include "driver/LimitSwitch.hpp"
+#include "units/units.hpp"
+
+// 壁の向き
+enum class WallAxis
+{
+    X, // x = coordinate の壁 (y軸に平行)
+    Y, // y = coordinate の壁 (x軸に平行)
+};
+
+// 壁との接触(またはTOFの検知)で分かる拘束
+struct WallContact
+{
+    WallAxis axis;        // 接触した壁
+    Meter coordinate;     // 壁の座標
+    Position sensor;      // ロボット座標系でのセンサーの位置。thetaは検知する方向。
+    Meter range;          // センサーの位置から検知点までの距離 (リミットスイッチは0、TOFは検知距離)
+    bool snap_heading;    // 接触時は壁に正対しているとみなして角度も補正するか
+    Radian heading;       // snap_headingのときの機体の向き
+    Meter max_correction; // これより大きくずれていたら誤検知として捨てる
+};
+
+// 壁との接触でオドメトリのずれを補正するオドメトリ
+// 補正後の姿勢を時刻付きで履歴(IOdometryの姿勢履歴)に残しておき、
+// 接触イベントの時刻の姿勢を履歴から引いて、壁に合わせた補正量を現在の姿勢に反映する。
+// 検知から処理までの間に進んだ分もそのまま残るので、減速して突き当てなくても補正できる。
+//
+// PositionControllerには内側のオドメトリの代わりにこれを渡す。
+template <int N>
+class WallCorrectedOdometry : public IOdometry<N>
+{
+public:
+    static constexpr int MAX_LIMIT_SWITCHES = 4; // 登録できるリミットスイッチの最大数
+    static constexpr int MAX_POLLED_SENSORS = 4; // 登録できるポーリングセンサーの最大数
+
+    WallCorrectedOdometry(IOdometry<N> &odometry)
+        : odometry(odometry), listener_size(0), polled_size(0), correction_count(0) {}
+
+    Position getCurrentPosition() override
+    {
+        return odometry.getCurrentPosition();
+    }
+
+    void setCurrentPosition(Position current_position) override
+    {
+        mutex.lock();
+        odometry.setCurrentPosition(current_position);
+        // 履歴は古い座標系なので捨てる
+        this->clearPoseHistory();
+        mutex.unlock();
+    }
+
+    void applyCorrection(const Pose2 &correction) override
+    {
+        mutex.lock();
+        odometry.applyCorrection(correction);
+        this->pose_history.transform([&](Position position)
+                                     { return correction.transformPoint(position); });
+        mutex.unlock();
+    }
+
+    void updatePosition() override
+    {
+        mutex.lock();
+        odometry.updatePosition();
+        this->recordPose(odometry.getCurrentPosition());
+        mutex.unlock();
+
+        pollSensors();
+    }
+
+    // リミットスイッチが押されたら補正する
+    // limit_switchはenableInterrupt()しておくこと。
+    // 戻り値: true: 登録成功, false: 登録数の上限に達している
+    bool addLimitSwitch(LimitSwitch &limit_switch, WallContact contact)
+    {
+        if (listener_size >= MAX_LIMIT_SWITCHES)
+        {
+            return false;
+        }
+
+        ContactListener &listener = listeners[listener_size];
+        listener.odometry = this;
+        listener.contact = contact;
+        if (!limit_switch.subscribe(callback(&listener, &ContactListener::onEvent)))
+        {
+            return false;
+        }
+
+        listener_size++;
+        return true;
+    }
+
+    // 検知の立ち上がりで補正するセンサーを登録する (TimeOfFlightSensorなど)
+    // updatePositionのたびにポーリングするので、検知時刻の誤差はオドメトリの更新周期以内。
+    // 例: addPolledSensor(callback(&tof, &TimeOfFlightSensor::isDetecting_1), contact)
+    bool addPolledSensor(Callback<bool()> detector, WallContact contact)
+    {
+        if (polled_size >= MAX_POLLED_SENSORS)
+        {
+            return false;
+        }
+
+        polled_sensors[polled_size] = {detector, contact, detector()};
+        polled_size++;
+        return true;
+    }
+
+    // timestampの時点でcontactの壁に接触していたとして補正する
+    // 戻り値: true: 補正した, false: 履歴が足りない、またはずれが大きすぎて捨てた
+    bool correct(const WallContact &contact, HighResClock::time_point timestamp)
+    {
+        mutex.lock();
+
+        Position past;
+        if (!this->pose_history.find(timestamp, past))
+        {
+            mutex.unlock();
+            return false;
+        }
+
+        Position corrected = snapToWall(contact, past);
+        float error = contact.axis == WallAxis::X ? (corrected.x - past.x).value : (corrected.y - past.y).value;
+        if (fabs(error) > contact.max_correction.value)
+        {
+            mutex.unlock();
+            return false;
+        }
+
+        // 接触時の姿勢 past を corrected に移す剛体変換を、現在の姿勢と履歴すべてに掛ける
+        // 内側のオドメトリはsetCurrentPositionだとIMUのヨーをリセットしてしまうので、applyCorrectionで補正する
+        Pose2 correction = Pose2(corrected).compose(Pose2(past).inverse());
+        odometry.applyCorrection(correction);
+        this->pose_history.transform([&](Position position)
+                                     { return correction.transformPoint(position); });
+
+        correction_count++;
+        mutex.unlock();
+
+        return true;
+    }
+
+    // これまでに補正した回数
+    int getCorrectionCount()
+    {
+        return correction_count;
+    }
+
+private:
+    // リミットスイッチのイベントを受け取ってcorrectを呼ぶ
+    struct ContactListener
+    {
+        WallCorrectedOdometry *odometry;
+        WallContact contact;
+
+        void onEvent(LimitSwitchEvent event)
+        {
+            if (event.pressed)
+            {
+                odometry->correct(contact, event.timestamp);
+            }
+        }
+    };
+
+    struct PolledSensor
+    {
+        Callback<bool()> detector;
+        WallContact contact;
+        bool last_state;
+    };
+
+    // 上位クラスでtickerを用いることを想定しているため、Mutexを使用し排他制御する。
+    // 補正はリミットスイッチの通知スレッドから呼ばれるので、内側のオドメトリの更新と補正もこのMutexで直列化する。
+    Mutex mutex;
+    IOdometry<N> &odometry;
+
+    ContactListener listeners[MAX_LIMIT_SWITCHES];
+    int listener_size;
+    PolledSensor polled_sensors[MAX_POLLED_SENSORS];
+    int polled_size;
+
+    int correction_count;
+
+    // 接触時の姿勢を、センサーの検知点が壁の上に来るように動かす
+    static Position snapToWall(const WallContact &contact, Position past)
+    {
+        Radian theta = contact.snap_heading ? contact.heading : past.theta;
+
+        // ロボット座標系での検知点
+        Position point = Pose2(contact.sensor).transformPoint(Position(contact.range, 0_m, 0_rad));
+
+        // フィールド座標系での機体中心から検知点までのベクトル
+        Position offset = Pose2::rotation(theta).rotate(point);
+
+        Position corrected = past;
+        corrected.theta = past.theta + normalizeAngle(theta - past.theta);
+        if (contact.axis == WallAxis::X)
+        {
+            corrected.x = contact.coordinate - offset.x;
+        }
+        else
+        {
+            corrected.y = contact.coordinate - offset.y;
+        }
+
+        return corrected;
+    }
+
+    // ポーリングセンサーの立ち上がりを検出して補正する
+    void pollSensors()
+    {
+        HighResClock::time_point now = HighResClock::now();
+        for (int i = 0; i < polled_size; i++)
+        {
+            PolledSensor &sensor = polled_sensors[i];
+            bool state = sensor.detector();
+            if (state && !sensor.last_state)
+            {
+                correct(sensor.contact, now);
+            }
+            sensor.last_state = state;
+        }
+    }
+};
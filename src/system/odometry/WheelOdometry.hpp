@@ -1,8 +1,9 @@
 #pragma once
 #include "WheelConfig.hpp"
-#include "system/wheelVector.hpp"
+#include "IOdometry.hpp"
+#include "system/WheelVector.hpp"
 #include "driver/Encoder.hpp"
-#include <Dense.h>
+#include <ControlMath.h>
 
 template <int N>
 class WheelOdometry : public IOdometry<N>
@@ -10,7 +11,7 @@ class WheelOdometry : public IOdometry<N>
     static_assert(N > 2, "N must be greater than 2.");
 
 public:
-    WheelOdometry(array<MeasuringWheel, N> &measuring_wheels) : position(0_m, 0_m, 0_rad)
+    WheelOdometry(array<MeasuringWheel, N> &measuring_wheels)
     {
         array<WheelPositions, N> wheel_positions;
         for (int i = 0; i < N; i++)
@@ -27,7 +28,7 @@ public:
     Position getCurrentPosition() override
     {
         mutex.lock();
-        Position position = this->position;
+        Position position = pose.getPosition();
         mutex.unlock();
 
         return position;
@@ -36,7 +37,17 @@ public:
     void setCurrentPosition(Position current_position) override
     {
         mutex.lock();
-        position = current_position;
+        pose = Pose2(current_position);
+        this->clearPoseHistory();
+        mutex.unlock();
+    }
+
+    void applyCorrection(const Pose2 &correction) override
+    {
+        mutex.lock();
+        pose = correction.compose(pose);
+        this->pose_history.transform([&](Position position)
+                                     { return correction.transformPoint(position); });
         mutex.unlock();
     }
 
@@ -62,15 +73,12 @@ public:
             delta_theta += encoder_delta * wheel_vectors_inv[i].theta;
         }
 
-        // ロボット座標系からフィールド座標系への変換を含む位置と姿勢の更新
-        float theta = position.theta.value;
-        float delta_x_abs = delta_x * cos(theta + delta_theta / 2) - delta_y * sin(theta + delta_theta / 2); // x方向の移動量 (フィールド座標系)
-        float delta_y_abs = delta_x * sin(theta + delta_theta / 2) + delta_y * cos(theta + delta_theta / 2); // y方向の移動量 (フィールド座標系)
+        // ロボット座標系での移動を一定の速度で進んだ円弧とみなして、フィールド座標系の姿勢に合成する
+        Pose2 step = Pose2::exp(Position(Meter(delta_x), Meter(delta_y), Radian(delta_theta)));
 
         mutex.lock();
-        position.x += Meter(delta_x_abs);
-        position.y += Meter(delta_y_abs);
-        position.theta += Radian(delta_theta);
+        pose = pose.compose(step);
+        this->recordPose(pose.getPosition());
         mutex.unlock();
     }
 
@@ -79,5 +87,5 @@ private:
     array<Encoder *, N> encoders;
     array<int, N> last_encoder_counts;
     array<WheelVectorInv, N> wheel_vectors_inv;
-    Position position;
+    Pose2 pose; // 現在の姿勢 (向きのcos, sinを持つので、更新のたびに三角関数を呼ばずに済む)
 };
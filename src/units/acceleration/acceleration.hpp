@@ -1,31 +1,9 @@
 #pragma once
+#include "../quantity.hpp"
 
-class MeterPerSecondSquared;
+// 加速度の単位 (中身はfloat1つ)
 
-// メートル毎秒二乗
-class MeterPerSecondSquared
-{
-public:
-    float value;
+using MeterPerSecondSquared = Quantity<AccelerationDimension, Scale<std::ratio<1>>>; // メートル毎秒二乗
 
-    MeterPerSecondSquared() = default;
-    explicit constexpr MeterPerSecondSquared(float val) : value(val) {}
-
-    constexpr MeterPerSecondSquared operator+() const { return MeterPerSecondSquared(value); }
-    constexpr MeterPerSecondSquared operator-() const { return MeterPerSecondSquared(-value); }
-};
-
-// --- MeterPerSecondSquaredの実装 ---
-
-constexpr bool operator==(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return lhs.value == rhs.value; }
-constexpr bool operator!=(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return lhs.value != rhs.value; }
-constexpr bool operator<(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return lhs.value < rhs.value; }
-constexpr bool operator>(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return lhs.value > rhs.value; }
-constexpr bool operator<=(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return lhs.value <= rhs.value; }
-constexpr bool operator>=(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return lhs.value >= rhs.value; }
-
-constexpr MeterPerSecondSquared operator+(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return MeterPerSecondSquared(lhs.value + rhs.value); }
-constexpr MeterPerSecondSquared operator-(const MeterPerSecondSquared &lhs, const MeterPerSecondSquared &rhs) { return MeterPerSecondSquared(lhs.value - rhs.value); }
-constexpr MeterPerSecondSquared operator*(const MeterPerSecondSquared &lhs, float rhs) { return MeterPerSecondSquared(lhs.value * rhs); }
-constexpr MeterPerSecondSquared operator*(float lhs, const MeterPerSecondSquared &rhs) { return MeterPerSecondSquared(lhs * rhs.value); }
-constexpr MeterPerSecondSquared operator/(const MeterPerSecondSquared &lhs, float rhs) { return MeterPerSecondSquared(lhs.value / rhs); }
+template <typename T>
+constexpr bool is_acceleration_unit = is_quantity_of<T, AccelerationDimension>;
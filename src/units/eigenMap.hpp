@@ -0,0 +1,41 @@
+#pragma once
+#include <type_traits>
+#include <Core.h>
+#include "units.hpp"
+
+// 位置・速度・加速度のベクトルをEigenの固定長ベクトル (Vector3f) として扱う
+// QuantityVectorはfloat3つが隙間なく並ぶだけなので、コピーせずにそのままEigen::Mapで見せる。
+// Mapはアライメントを仮定しないので、スタック上のPositionなどどこにあっても使える。
+//
+// ### example
+// Eigen::Vector3f body_velocity = wheel_matrix_inv * wheel_rps;
+// Velocity velocity = fromEigen<Velocity>(body_velocity);
+// asEigen(position) += rotation * asEigen(velocity) * dt;
+
+template <typename LinearUnit, typename AngularUnit>
+Eigen::Map<Eigen::Vector3f> asEigen(QuantityVector<LinearUnit, AngularUnit> &vector)
+{
+    static_assert(std::is_standard_layout<QuantityVector<LinearUnit, AngularUnit>>::value &&
+                      sizeof(QuantityVector<LinearUnit, AngularUnit>) == 3 * sizeof(float),
+                  "QuantityVector must be three packed floats.");
+    return Eigen::Map<Eigen::Vector3f>(&vector.x.value);
+}
+
+template <typename LinearUnit, typename AngularUnit>
+Eigen::Map<const Eigen::Vector3f> asEigen(const QuantityVector<LinearUnit, AngularUnit> &vector)
+{
+    static_assert(std::is_standard_layout<QuantityVector<LinearUnit, AngularUnit>>::value &&
+                      sizeof(QuantityVector<LinearUnit, AngularUnit>) == 3 * sizeof(float),
+                  "QuantityVector must be three packed floats.");
+    return Eigen::Map<const Eigen::Vector3f>(&vector.x.value);
+}
+
+// Eigenの式の結果から位置・速度・加速度のベクトルをつくる (各成分はT::linear_unit, T::angular_unitの値とみなす)
+template <typename T, typename Derived>
+T fromEigen(const Eigen::MatrixBase<Derived> &vector)
+{
+    static_assert(is_quantity_vector<T>::value, "T must be a QuantityVector (e.g., Position, Velocity).");
+    T result;
+    asEigen(result) = vector;
+    return result;
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include <cstdint>
+
+// 制御ループ用のfloatの三角関数と角度の正規化
+// libmのsin/cosはdoubleへの昇格や広い範囲の引数の処理を含むが、制御で扱う角度は高々数千radなので、
+// π/2の倍数を引いてから[-π/4, π/4]でミニマックス多項式を評価するだけで足りる。
+// 分岐は象限の選択(条件付き選択になる)だけで、すべてconstexprなのでコンパイル時の表にも使える。
+//
+// 精度 (多項式の項数) は3段階から選ぶ。誤差は[-π, π]での最大絶対誤差 (tools/fast_math_benchで測定)。
+//   Low:    sin, cosで約3e-4、atan2で約1e-4。角度の粗い比較や表示など
+//   Medium: 約1e-6 (atan2は約4e-6)
+//   High:   floatの丸め誤差程度 (約1e-7)。既定値。オドメトリなど積分するもの
+//
+// 丸めは 1.5 * 2^23 を足して引く方法で行うので、-ffast-math(結合則の変更)ではビルドしないこと。
+namespace FastMath
+{
+    enum class Accuracy
+    {
+        Low,
+        Medium,
+        High,
+    };
+
+    struct SinCos
+    {
+        float sin;
+        float cos;
+    };
+
+    constexpr float PI = 3.14159265358979323846f;
+    constexpr float HALF_PI = 1.57079632679489661923f;
+    constexpr float QUARTER_PI = 0.78539816339744830962f;
+
+    namespace detail
+    {
+        constexpr float ROUND_MAGIC = 12582912.0f; // 1.5 * 2^23。|x| < 2^22 なら x + ROUND_MAGIC - ROUND_MAGIC が最近接の整数になる
+        constexpr float TWO_OVER_PI = 0.63661977236758134308f;
+        constexpr float INV_TWO_PI = 0.15915494309189533577f;
+        constexpr float INV_360 = 1.0f / 360.0f;
+        constexpr float TAN_PI_8 = 0.41421356237309504880f;
+
+        // π/2を3つに分けたもの (Cody-Waite)。上位は下位ビットが0なので k * PIO2_1 が誤差なく求まる
+        constexpr float PIO2_1 = 1.5703125f;
+        constexpr float PIO2_2 = 4.837512969970703125e-4f;
+        constexpr float PIO2_3 = 7.54978995489188216e-8f;
+
+        // 最近接の整数 (偶数丸め)
+        constexpr float roundToInteger(float x)
+        {
+            return (x + ROUND_MAGIC) - ROUND_MAGIC;
+        }
+
+        constexpr float abs(float x)
+        {
+            return x < 0.0f ? -x : x;
+        }
+
+        // sin(r) (|r| <= π/4)。r * P(r^2) で相対誤差のミニマックス
+        template <Accuracy A>
+        constexpr float sinKernel(float r, float r2)
+        {
+            if constexpr (A == Accuracy::Low)
+            {
+                return r * (0.99961228f + r2 * -0.16160110f);
+            }
+            else if constexpr (A == Accuracy::Medium)
+            {
+                return r * (0.99999857f + r2 * (-0.16662480f + r2 * 0.0081516356f));
+            }
+            else
+            {
+                return r * (1.0f + r2 * (-0.16666651f + r2 * (0.0083320369f + r2 * -0.00019504022f)));
+            }
+        }
+
+        // cos(r) (|r| <= π/4)。Q(r^2) で絶対誤差のミニマックス
+        template <Accuracy A>
+        constexpr float cosKernel(float r2)
+        {
+            if constexpr (A == Accuracy::Low)
+            {
+                return 0.99999003f + r2 * (-0.49970814f + r2 * 0.040398536f);
+            }
+            else if constexpr (A == Accuracy::Medium)
+            {
+                return 1.0f + r2 * (-0.49999857f + r2 * (0.041655027f + r2 * -0.0013585909f));
+            }
+            else
+            {
+                return 1.0f + r2 * (-0.5f + r2 * (0.041666617f + r2 * (-0.0013886619f + r2 * 0.000024379929f)));
+            }
+        }
+
+        // atan(t) (0 <= t <= tan(π/8))。t * A(t^2) で絶対誤差のミニマックス
+        template <Accuracy A>
+        constexpr float atanKernel(float t)
+        {
+            float t2 = t * t;
+            if constexpr (A == Accuracy::Low)
+            {
+                return t * (0.99846006f + t2 * -0.29551035f);
+            }
+            else if constexpr (A == Accuracy::Medium)
+            {
+                return t * (0.99993937f + t2 * (-0.33039563f + t2 * 0.16358568f));
+            }
+            else
+            {
+                return t * (0.99999991f + t2 * (-0.33332204f + t2 * (0.19961966f + t2 * (-0.13754814f + t2 * 0.077345612f))));
+            }
+        }
+    }
+
+    // sinとcosを同時に求める
+    template <Accuracy A = Accuracy::High>
+    constexpr SinCos sincos(float x)
+    {
+        // x = k * π/2 + r, |r| <= π/4
+        float k = detail::roundToInteger(x * detail::TWO_OVER_PI);
+        float r = ((x - k * detail::PIO2_1) - k * detail::PIO2_2) - k * detail::PIO2_3;
+        float r2 = r * r;
+        float s = detail::sinKernel<A>(r, r2);
+        float c = detail::cosKernel<A>(r2);
+
+        // 象限で入れ替えと符号を決める
+        int32_t quadrant = (int32_t)k;
+        bool swap = (quadrant & 1) != 0;
+        float sin_sign = 1.0f - (float)(quadrant & 2);
+        float cos_sign = 1.0f - (float)((quadrant + 1) & 2);
+
+        return SinCos{
+            (swap ? c : s) * sin_sign,
+            (swap ? s : c) * cos_sign,
+        };
+    }
+
+    template <Accuracy A = Accuracy::High>
+    constexpr float sin(float x)
+    {
+        return sincos<A>(x).sin;
+    }
+
+    template <Accuracy A = Accuracy::High>
+    constexpr float cos(float x)
+    {
+        return sincos<A>(x).cos;
+    }
+
+    // 点(x, y)の偏角 [-π, π]。atan2(0, 0) == 0
+    template <Accuracy A = Accuracy::High>
+    constexpr float atan2(float y, float x)
+    {
+        float abs_x = detail::abs(x);
+        float abs_y = detail::abs(y);
+        float large = abs_x > abs_y ? abs_x : abs_y;
+        float small = abs_x > abs_y ? abs_y : abs_x;
+        float ratio = large > 0.0f ? small / large : 0.0f; // [0, 1]
+
+        // tan(π/8)より大きければ atan(a) = π/4 + atan((a - 1) / (a + 1)) で範囲を狭める
+        bool reduce = ratio > detail::TAN_PI_8;
+        float t = reduce ? (ratio - 1.0f) / (ratio + 1.0f) : ratio;
+        float angle = (reduce ? QUARTER_PI : 0.0f) + detail::atanKernel<A>(t);
+
+        angle = abs_y > abs_x ? HALF_PI - angle : angle;
+        angle = x < 0.0f ? PI - angle : angle;
+        return y < 0.0f ? -angle : angle;
+    }
+
+    // 角度[rad]を[-π, π]に正規化する (std::remainder(x, 2π)と同じ)
+    constexpr float wrapAngle(float radian)
+    {
+        // 2π = 2 * (PIO2_1 + PIO2_2 + PIO2_3) * 2
+        float k = detail::roundToInteger(radian * detail::INV_TWO_PI);
+        return ((radian - k * (4.0f * detail::PIO2_1)) - k * (4.0f * detail::PIO2_2)) - k * (4.0f * detail::PIO2_3);
+    }
+
+    // 角度[deg]を[-180, 180]に正規化する
+    constexpr float wrapDegree(float degree)
+    {
+        return degree - detail::roundToInteger(degree * detail::INV_360) * 360.0f;
+    }
+}
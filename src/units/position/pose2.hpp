@@ -0,0 +1,210 @@
+#pragma once
+#include "../fastMath.hpp"
+#include "angle.hpp"
+#include "position.hpp"
+#include "positionVector.hpp"
+
+// 平面上の剛体変換 (SE(2)の要素)。位置(Position)に向きのcos, sinを持たせたもの。
+// 合成・逆・回転はcos, sinの積和だけで済むので三角関数を呼ばない。三角関数を呼ぶのは
+// Positionからの構築(rotationを含む)と、回転角が大きいときのexp, log(Position)だけで、どれもFastMath::sincos(精度High)を使う。
+//
+// thetaは正規化しない (Positionと同じく、合成すると角度がそのまま足される)。
+// 正規化した角度が必要なときはwrapped()を使う。
+//
+// ### example
+// Pose2 robot(current_position);
+// Position sensor = robot.transformPoint(sensor_on_robot); // ロボット座標系 -> フィールド座標系
+// Velocity body_velocity = robot.inverseRotate(field_velocity);
+// Pose2 next = robot.compose(Pose2::exp(body_displacement)); // 一定の速度で進んだ後の姿勢
+class Pose2
+{
+public:
+    // 恒等変換
+    constexpr Pose2() : position(0_m, 0_m, 0_rad), cos_theta(1.0f), sin_theta(0.0f) {}
+
+    explicit constexpr Pose2(Position position)
+        : Pose2(position, FastMath::sincos(position.theta.value)) {}
+
+    // cos, sinが分かっているとき (cos_theta^2 + sin_theta^2 == 1 であること)
+    constexpr Pose2(Position position, float cos_theta, float sin_theta)
+        : position(position), cos_theta(cos_theta), sin_theta(sin_theta) {}
+
+    // 回転だけの変換
+    static constexpr Pose2 rotation(Radian theta)
+    {
+        return Pose2(Position(0_m, 0_m, theta));
+    }
+
+    constexpr Position getPosition() const { return position; }
+    constexpr float getCos() const { return cos_theta; }
+    constexpr float getSin() const { return sin_theta; }
+
+    // this * other: otherをthisの座標系で表した姿勢とみなし、thisの親の座標系に直す
+    // cos, sinは積の丸め誤差で長さが1からずれていくので、1次の補正で長さを1に戻す。
+    // 補正はthisの長さから求める (積と並行して計算でき、合成を繰り返すときの依存の連鎖が短い)。
+    // 積で新たに入る丸め誤差は、次の合成で補正される。
+    constexpr Pose2 compose(const Pose2 &other) const
+    {
+        float scale = 1.5f - 0.5f * (cos_theta * cos_theta + sin_theta * sin_theta);
+        float c = cos_theta * other.cos_theta - sin_theta * other.sin_theta;
+        float s = sin_theta * other.cos_theta + cos_theta * other.sin_theta;
+
+        return Pose2(transformPoint(other.position), c * scale, s * scale);
+    }
+
+    constexpr Pose2 inverse() const
+    {
+        float x = position.x.value;
+        float y = position.y.value;
+
+        return Pose2(
+            Position(Meter(-cos_theta * x - sin_theta * y), Meter(sin_theta * x - cos_theta * y), -position.theta),
+            cos_theta,
+            -sin_theta);
+    }
+
+    // thisから見たotherの相対姿勢 (this^-1 * other)
+    constexpr Pose2 between(const Pose2 &other) const
+    {
+        return inverse().compose(other);
+    }
+
+    // thisの座標系で表した点(x, y)を親の座標系に直す。thetaは向きとして足される。
+    // compose(Pose2(point)).getPosition()と同じだが、pointのcos, sinを求めない。
+    constexpr Position transformPoint(Position point) const
+    {
+        return Position(
+            position.x + point.x * cos_theta - point.y * sin_theta,
+            position.y + point.x * sin_theta + point.y * cos_theta,
+            position.theta + point.theta);
+    }
+
+    // ベクトルの(x, y)を向きだけ回転する (thisの座標系 -> 親の座標系)。thetaの成分はそのまま。
+    template <typename LinearUnit, typename AngularUnit>
+    constexpr QuantityVector<LinearUnit, AngularUnit> rotate(const QuantityVector<LinearUnit, AngularUnit> &vector) const
+    {
+        return QuantityVector<LinearUnit, AngularUnit>(
+            vector.x * cos_theta - vector.y * sin_theta,
+            vector.x * sin_theta + vector.y * cos_theta,
+            vector.theta);
+    }
+
+    // rotateの逆 (親の座標系 -> thisの座標系)。フィールド座標系の速度をロボット座標系に直すときなど。
+    template <typename LinearUnit, typename AngularUnit>
+    constexpr QuantityVector<LinearUnit, AngularUnit> inverseRotate(const QuantityVector<LinearUnit, AngularUnit> &vector) const
+    {
+        return QuantityVector<LinearUnit, AngularUnit>(
+            vector.x * cos_theta + vector.y * sin_theta,
+            -vector.x * sin_theta + vector.y * cos_theta,
+            vector.theta);
+    }
+
+    // thetaを[-π, π]に正規化した姿勢 (cos, sinは変わらない)
+    constexpr Pose2 wrapped() const
+    {
+        return Pose2(Position(position.x, position.y, normalizeAngle(position.theta)), cos_theta, sin_theta);
+    }
+
+    // exp: 一定の速度(ツイスト)で進んだときの相対姿勢
+    // twist: ロボット座標系での速度 * 時間 (並進の移動量と回転角)
+    // 制御周期1回分のような小さい回転角では、cos, sinも級数で求めて三角関数を呼ばない。
+    static constexpr Pose2 exp(Position twist)
+    {
+        float theta = twist.theta.value;
+
+        // sin(theta) / theta, (1 - cos(theta)) / theta
+        float sin_over_theta = 0.0f;
+        float one_minus_cos_over_theta = 0.0f;
+        float c = 0.0f;
+        float s = 0.0f;
+        if (isSeriesAngle(theta))
+        {
+            float theta2 = theta * theta;
+            sin_over_theta = 1.0f - theta2 * (1.0f / 6.0f) * (1.0f - theta2 * (1.0f / 20.0f) * (1.0f - theta2 * (1.0f / 42.0f)));
+            one_minus_cos_over_theta = theta * 0.5f * (1.0f - theta2 * (1.0f / 12.0f) * (1.0f - theta2 * (1.0f / 30.0f) * (1.0f - theta2 * (1.0f / 56.0f))));
+            c = 1.0f - theta * one_minus_cos_over_theta;
+            s = theta * sin_over_theta;
+        }
+        else
+        {
+            FastMath::SinCos sin_cos = FastMath::sincos(theta);
+            c = sin_cos.cos;
+            s = sin_cos.sin;
+
+            // cos > 0では 1 - cos = sin^2 / (1 + cos) として桁落ちを避ける
+            // (分岐にせず選択にして、除算は1回にまとめる)
+            bool is_front = c > 0.0f;
+            float k = is_front ? 1.0f + c : 1.0f;
+            float inv = 1.0f / (theta * k);
+            sin_over_theta = s * k * inv;
+            one_minus_cos_over_theta = (is_front ? s * s : 1.0f - c) * inv;
+        }
+
+        return Pose2(
+            Position(twist.x * sin_over_theta - twist.y * one_minus_cos_over_theta,
+                     twist.x * one_minus_cos_over_theta + twist.y * sin_over_theta,
+                     twist.theta),
+            c,
+            s);
+    }
+
+    // log: expの逆。回転角は[-π, π]に正規化する。キャッシュしたcos, sinを使うので三角関数を呼ばない。
+    constexpr Position log() const
+    {
+        return log(position, normalizeAngle(position.theta).value, cos_theta, sin_theta);
+    }
+
+    // Pose2(position).log()と同じだが、回転角が小さければcos, sinを求めない (隣り合う姿勢の差など)
+    static constexpr Position log(Position position)
+    {
+        float theta = normalizeAngle(position.theta).value;
+        if (isSeriesAngle(theta))
+        {
+            return log(position, theta, 1.0f, 0.0f);
+        }
+
+        FastMath::SinCos sin_cos = FastMath::sincos(theta);
+        return log(position, theta, sin_cos.cos, sin_cos.sin);
+    }
+
+private:
+    static constexpr float SERIES_ANGLE = 0.25f; // これより小さい角度は三角関数の代わりに級数を使う (打ち切り誤差はfloatの丸めより十分小さい)
+
+    Position position;
+    float cos_theta;
+    float sin_theta;
+
+    constexpr Pose2(Position position, FastMath::SinCos sin_cos)
+        : position(position), cos_theta(sin_cos.cos), sin_theta(sin_cos.sin) {}
+
+    static constexpr bool isSeriesAngle(float theta)
+    {
+        return -SERIES_ANGLE < theta && theta < SERIES_ANGLE;
+    }
+
+    // theta: [-π, π]に正規化したposition.theta
+    // c, s: cos(theta), sin(theta) (thetaが級数の範囲なら使わない)
+    static constexpr Position log(Position position, float theta, float c, float s)
+    {
+        float half_theta = theta / 2.0f;
+
+        // (theta / 2) / tan(theta / 2) = (theta / 2) * sin(theta) / (1 - cos(theta))
+        // 1 - cosの桁落ちを避けるため、cos > 0では (theta / 2) * (1 + cos) / sin とする (分岐にせず選択にする)
+        float v_scale = 0.0f;
+        if (isSeriesAngle(theta))
+        {
+            float theta2 = theta * theta;
+            v_scale = 1.0f - theta2 * (1.0f / 12.0f) * (1.0f + theta2 * (1.0f / 60.0f) * (1.0f + theta2 * (1.0f / 42.0f)));
+        }
+        else
+        {
+            bool is_front = c > 0.0f;
+            v_scale = half_theta * (is_front ? 1.0f + c : s) / (is_front ? s : 1.0f - c);
+        }
+
+        return Position(
+            position.x * v_scale + position.y * half_theta,
+            -position.x * half_theta + position.y * v_scale,
+            Radian(theta));
+    }
+};
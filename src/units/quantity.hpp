@@ -0,0 +1,236 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+// 単位付きの量の共通の実装
+// Meter, Radian, MeterPerSecondなどはすべて Quantity<次元, 倍率> の別名で、中身はfloat1つ。
+//
+// 次元: 長さ・時間・角度の指数 (速度は 長さ^1 時間^-1)。違う次元の足し算や代入はコンパイルエラーになる。
+// 倍率: 基本単位(m, s, rad)に対する倍率。std::ratioとπの指数で表す (度は π/180)。
+//
+// 単位の変換に使う係数はコンパイル時に1つのfloatの定数にまとめるので、
+// 1_m + 10_cm などの変換は掛け算1回になる (割り算やdoubleの計算は残らない)。
+// 同じ単位同士の演算はfloatの演算そのものになる。
+
+// 次元 (長さ, 時間, 角度の指数)
+template <int Length, int Time, int Angle>
+struct Dimension
+{
+    static constexpr int length = Length;
+    static constexpr int time = Time;
+    static constexpr int angle = Angle;
+};
+
+using Dimensionless = Dimension<0, 0, 0>;
+using LengthDimension = Dimension<1, 0, 0>;
+using AngleDimension = Dimension<0, 0, 1>;
+using VelocityDimension = Dimension<1, -1, 0>;
+using AngularVelocityDimension = Dimension<0, -1, 1>;
+using AccelerationDimension = Dimension<1, -2, 0>;
+using AngularAccelerationDimension = Dimension<0, -2, 1>;
+
+template <typename A, typename B>
+using DimensionProduct = Dimension<A::length + B::length, A::time + B::time, A::angle + B::angle>;
+
+template <typename A, typename B>
+using DimensionQuotient = Dimension<A::length - B::length, A::time - B::time, A::angle - B::angle>;
+
+// 倍率 Ratio * π^PiExponent
+template <typename Ratio, int PiExponent = 0>
+struct Scale
+{
+    using ratio = typename Ratio::type; // 約分しておく (1000/3600 と 5/18 を同じ型にする)
+    static constexpr int pi_exponent = PiExponent;
+
+    static constexpr double power(double base, int exponent)
+    {
+        return exponent == 0 ? 1.0 : (exponent > 0 ? base * power(base, exponent - 1) : power(base, exponent + 1) / base);
+    }
+
+    static constexpr double value = (double)ratio::num / (double)ratio::den * power(M_PI, PiExponent);
+};
+
+template <typename A, typename B>
+using ScaleProduct = Scale<std::ratio_multiply<typename A::ratio, typename B::ratio>, A::pi_exponent + B::pi_exponent>;
+
+template <typename A, typename B>
+using ScaleQuotient = Scale<std::ratio_divide<typename A::ratio, typename B::ratio>, A::pi_exponent - B::pi_exponent>;
+
+// From単位の値に掛けるとTo単位の値になる係数 (コンパイル時にfloatの定数になる)
+template <typename From, typename To>
+constexpr float scale_factor = (float)(From::value / To::value);
+
+template <typename Dim, typename UnitScale>
+class Quantity
+{
+public:
+    using dimension = Dim;
+    using scale = UnitScale;
+
+    float value;
+
+    Quantity() = default;
+    // doubleからの暗黙的な型変換を防ぐためexplicitを指定
+    explicit constexpr Quantity(float val) : value(val) {}
+
+    // 同じ次元の別の単位からの変換 (1_m -> 100_cm など)
+    template <typename OtherScale>
+    constexpr Quantity(Quantity<Dim, OtherScale> other) : value(convert<OtherScale>(other.value)) {}
+
+    constexpr Quantity operator+() const { return Quantity(value); }
+    constexpr Quantity operator-() const { return Quantity(-value); }
+
+private:
+    template <typename OtherScale>
+    static constexpr float convert(float other_value)
+    {
+        if constexpr (std::is_same<typename OtherScale::ratio, typename UnitScale::ratio>::value && OtherScale::pi_exponent == UnitScale::pi_exponent)
+        {
+            return other_value;
+        }
+        else
+        {
+            return other_value * scale_factor<OtherScale, UnitScale>;
+        }
+    }
+};
+
+template <typename T>
+struct is_quantity : std::false_type
+{
+};
+
+template <typename Dim, typename UnitScale>
+struct is_quantity<Quantity<Dim, UnitScale>> : std::true_type
+{
+};
+
+// TがDimの次元の量か
+template <typename T, typename Dim>
+constexpr bool is_quantity_of = []
+{
+    if constexpr (is_quantity<T>::value)
+    {
+        return std::is_same<typename T::dimension, Dim>::value;
+    }
+    else
+    {
+        return false;
+    }
+}();
+
+// 比較
+// 単位が違うときは右辺を左辺の単位に変換して比べる (1_m == 100_cm など)
+
+template <typename Dim, typename S1, typename S2>
+constexpr bool operator==(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return lhs.value == Quantity<Dim, S1>(rhs).value; }
+
+template <typename Dim, typename S1, typename S2>
+constexpr bool operator!=(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return lhs.value != Quantity<Dim, S1>(rhs).value; }
+
+template <typename Dim, typename S1, typename S2>
+constexpr bool operator<(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return lhs.value < Quantity<Dim, S1>(rhs).value; }
+
+template <typename Dim, typename S1, typename S2>
+constexpr bool operator>(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return lhs.value > Quantity<Dim, S1>(rhs).value; }
+
+template <typename Dim, typename S1, typename S2>
+constexpr bool operator<=(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return lhs.value <= Quantity<Dim, S1>(rhs).value; }
+
+template <typename Dim, typename S1, typename S2>
+constexpr bool operator>=(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return lhs.value >= Quantity<Dim, S1>(rhs).value; }
+
+// 加算・減算 (結果は左辺の単位)
+
+template <typename Dim, typename S1, typename S2>
+constexpr Quantity<Dim, S1> operator+(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return Quantity<Dim, S1>(lhs.value + Quantity<Dim, S1>(rhs).value); }
+
+template <typename Dim, typename S1, typename S2>
+constexpr Quantity<Dim, S1> operator-(const Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs) { return Quantity<Dim, S1>(lhs.value - Quantity<Dim, S1>(rhs).value); }
+
+template <typename Dim, typename S1, typename S2>
+constexpr Quantity<Dim, S1> &operator+=(Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs)
+{
+    lhs.value += Quantity<Dim, S1>(rhs).value;
+    return lhs;
+}
+
+template <typename Dim, typename S1, typename S2>
+constexpr Quantity<Dim, S1> &operator-=(Quantity<Dim, S1> &lhs, const Quantity<Dim, S2> &rhs)
+{
+    lhs.value -= Quantity<Dim, S1>(rhs).value;
+    return lhs;
+}
+
+// スカラー倍
+
+template <typename Dim, typename S>
+constexpr Quantity<Dim, S> operator*(const Quantity<Dim, S> &lhs, float rhs) { return Quantity<Dim, S>(lhs.value * rhs); }
+
+template <typename Dim, typename S>
+constexpr Quantity<Dim, S> operator*(float lhs, const Quantity<Dim, S> &rhs) { return Quantity<Dim, S>(lhs * rhs.value); }
+
+template <typename Dim, typename S>
+constexpr Quantity<Dim, S> operator/(const Quantity<Dim, S> &lhs, float rhs) { return Quantity<Dim, S>(lhs.value / rhs); }
+
+template <typename Dim, typename S>
+constexpr Quantity<Dim, S> &operator*=(Quantity<Dim, S> &lhs, float rhs)
+{
+    lhs.value *= rhs;
+    return lhs;
+}
+
+template <typename Dim, typename S>
+constexpr Quantity<Dim, S> &operator/=(Quantity<Dim, S> &lhs, float rhs)
+{
+    lhs.value /= rhs;
+    return lhs;
+}
+
+// 量同士の積・商は次元と倍率を掛け合わせた量になる (次元が無くなったら基本単位のfloat)
+// 例: Meter(1) / Meter(2) == 0.5f, MeterPerSecond v = 1_m / std::chrono::seconds(2)
+
+template <typename Dim, typename UnitScale>
+constexpr auto makeQuantity(float value)
+{
+    if constexpr (std::is_same<Dim, Dimensionless>::value)
+    {
+        return value * (float)UnitScale::value;
+    }
+    else
+    {
+        return Quantity<Dim, UnitScale>(value);
+    }
+}
+
+template <typename D1, typename S1, typename D2, typename S2>
+constexpr auto operator*(const Quantity<D1, S1> &lhs, const Quantity<D2, S2> &rhs)
+{
+    return makeQuantity<DimensionProduct<D1, D2>, ScaleProduct<S1, S2>>(lhs.value * rhs.value);
+}
+
+template <typename D1, typename S1, typename D2, typename S2>
+constexpr auto operator/(const Quantity<D1, S1> &lhs, const Quantity<D2, S2> &rhs)
+{
+    return makeQuantity<DimensionQuotient<D1, D2>, ScaleQuotient<S1, S2>>(lhs.value / rhs.value);
+}
+
+// std::chrono::durationとの積・商 (時間の次元を持つ量として扱う)
+
+template <typename Period>
+using DurationScale = Scale<std::ratio<Period::num, Period::den>>;
+
+template <typename Dim, typename S, typename Rep, typename Period>
+constexpr auto operator*(const Quantity<Dim, S> &lhs, std::chrono::duration<Rep, Period> rhs)
+{
+    return makeQuantity<DimensionProduct<Dim, Dimension<0, 1, 0>>, ScaleProduct<S, DurationScale<Period>>>(lhs.value * (float)rhs.count());
+}
+
+template <typename Dim, typename S, typename Rep, typename Period>
+constexpr auto operator/(const Quantity<Dim, S> &lhs, std::chrono::duration<Rep, Period> rhs)
+{
+    return makeQuantity<DimensionQuotient<Dim, Dimension<0, 1, 0>>, ScaleQuotient<S, DurationScale<Period>>>(lhs.value / (float)rhs.count());
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <chrono>
+#include <type_traits>
+#include "quantity.hpp"
+
+// 平面上の機体の位置・速度・加速度 (x, y, theta) の共通の実装
+// LinearUnitは長さ・時間^k、AngularUnitは角度・時間^kの次元 (kは位置0, 速度-1, 加速度-2)。
+// 中身はfloat3つが隙間なく並ぶだけなので、units/eigenMap.hppでEigenの固定長ベクトルとして扱える。
+// 各演算は成分ごとのfloatの演算になり、インライン展開後は一時オブジェクトも残らない。
+template <typename LinearUnit, typename AngularUnit>
+class QuantityVector
+{
+    // コンパイル時に型をチェックし、条件を満たさない場合は指定したメッセージを出力
+    static_assert(is_quantity<LinearUnit>::value && LinearUnit::dimension::length == 1 && LinearUnit::dimension::angle == 0,
+                  "LinearUnit must be a distance based unit (e.g., Meter, MeterPerSecond).");
+    static_assert(is_quantity<AngularUnit>::value && AngularUnit::dimension::length == 0 && AngularUnit::dimension::angle == 1,
+                  "AngularUnit must be an angle based unit (e.g., Radian, RadPerSecond).");
+    static_assert(LinearUnit::dimension::time == AngularUnit::dimension::time,
+                  "LinearUnit and AngularUnit must have the same time dimension.");
+
+public:
+    using linear_unit = LinearUnit;
+    using angular_unit = AngularUnit;
+    static constexpr int time_dimension = LinearUnit::dimension::time;
+
+    LinearUnit x;
+    LinearUnit y;
+    AngularUnit theta;
+
+    QuantityVector() = default;
+    constexpr QuantityVector(LinearUnit x_val, LinearUnit y_val, AngularUnit theta_val)
+        : x(x_val), y(y_val), theta(theta_val) {}
+
+    // 他の単位のベクトルからの変換 (Position_mm_deg -> Positionなど)
+    template <
+        typename OtherLinearUnit,
+        typename OtherAngularUnit,
+        typename OtherEnableIf = std::enable_if_t<std::is_same<typename OtherLinearUnit::dimension, typename LinearUnit::dimension>::value &&
+                                                  std::is_same<typename OtherAngularUnit::dimension, typename AngularUnit::dimension>::value>>
+    constexpr QuantityVector(const QuantityVector<OtherLinearUnit, OtherAngularUnit> &other)
+        : x(other.x), y(other.y), theta(other.theta) {}
+
+    constexpr QuantityVector operator+() const { return *this; }
+    constexpr QuantityVector operator-() const { return QuantityVector(-x, -y, -theta); }
+};
+
+template <typename T>
+struct is_quantity_vector : std::false_type
+{
+};
+
+template <typename LinearUnit, typename AngularUnit>
+struct is_quantity_vector<QuantityVector<LinearUnit, AngularUnit>> : std::true_type
+{
+};
+
+// Tが時間^TimeDimensionの次元のベクトルか
+template <typename T, int TimeDimension>
+constexpr bool is_quantity_vector_of = []
+{
+    if constexpr (is_quantity_vector<T>::value)
+    {
+        return T::time_dimension == TimeDimension;
+    }
+    else
+    {
+        return false;
+    }
+}();
+
+// 同じ次元のベクトル同士の演算子 (単位が違うときは右辺を左辺の単位に変換する)
+
+template <typename L1, typename A1, typename L2, typename A2>
+constexpr bool operator==(const QuantityVector<L1, A1> &lhs, const QuantityVector<L2, A2> &rhs)
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.theta == rhs.theta;
+}
+
+template <typename L1, typename A1, typename L2, typename A2>
+constexpr bool operator!=(const QuantityVector<L1, A1> &lhs, const QuantityVector<L2, A2> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename L1, typename A1, typename L2, typename A2>
+constexpr QuantityVector<L1, A1> operator+(const QuantityVector<L1, A1> &lhs, const QuantityVector<L2, A2> &rhs)
+{
+    return QuantityVector<L1, A1>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.theta + rhs.theta);
+}
+
+template <typename L1, typename A1, typename L2, typename A2>
+constexpr QuantityVector<L1, A1> operator-(const QuantityVector<L1, A1> &lhs, const QuantityVector<L2, A2> &rhs)
+{
+    return QuantityVector<L1, A1>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.theta - rhs.theta);
+}
+
+template <typename L1, typename A1, typename L2, typename A2>
+constexpr QuantityVector<L1, A1> &operator+=(QuantityVector<L1, A1> &lhs, const QuantityVector<L2, A2> &rhs)
+{
+    lhs.x += rhs.x;
+    lhs.y += rhs.y;
+    lhs.theta += rhs.theta;
+    return lhs;
+}
+
+template <typename L1, typename A1, typename L2, typename A2>
+constexpr QuantityVector<L1, A1> &operator-=(QuantityVector<L1, A1> &lhs, const QuantityVector<L2, A2> &rhs)
+{
+    lhs.x -= rhs.x;
+    lhs.y -= rhs.y;
+    lhs.theta -= rhs.theta;
+    return lhs;
+}
+
+// スカラー倍
+
+template <typename L, typename A>
+constexpr QuantityVector<L, A> operator*(const QuantityVector<L, A> &lhs, float rhs)
+{
+    return QuantityVector<L, A>(lhs.x * rhs, lhs.y * rhs, lhs.theta * rhs);
+}
+
+template <typename L, typename A>
+constexpr QuantityVector<L, A> operator*(float lhs, const QuantityVector<L, A> &rhs)
+{
+    return rhs * lhs;
+}
+
+template <typename L, typename A>
+constexpr QuantityVector<L, A> operator/(const QuantityVector<L, A> &lhs, float rhs)
+{
+    return QuantityVector<L, A>(lhs.x / rhs, lhs.y / rhs, lhs.theta / rhs);
+}
+
+template <typename L, typename A>
+constexpr QuantityVector<L, A> &operator*=(QuantityVector<L, A> &lhs, float rhs)
+{
+    lhs.x *= rhs;
+    lhs.y *= rhs;
+    lhs.theta *= rhs;
+    return lhs;
+}
+
+template <typename L, typename A>
+constexpr QuantityVector<L, A> &operator/=(QuantityVector<L, A> &lhs, float rhs)
+{
+    lhs.x /= rhs;
+    lhs.y /= rhs;
+    lhs.theta /= rhs;
+    return lhs;
+}
+
+// 時間との積・商 (速度 * 時間 -> 位置, 位置 / 時間 -> 速度 など)
+
+template <typename L, typename A, typename Rep, typename Period>
+constexpr auto operator*(const QuantityVector<L, A> &lhs, std::chrono::duration<Rep, Period> rhs)
+{
+    using Result = QuantityVector<decltype(lhs.x * rhs), decltype(lhs.theta * rhs)>;
+    return Result(lhs.x * rhs, lhs.y * rhs, lhs.theta * rhs);
+}
+
+template <typename L, typename A, typename Rep, typename Period>
+constexpr auto operator/(const QuantityVector<L, A> &lhs, std::chrono::duration<Rep, Period> rhs)
+{
+    using Result = QuantityVector<decltype(lhs.x / rhs), decltype(lhs.theta / rhs)>;
+    return Result(lhs.x / rhs, lhs.y / rhs, lhs.theta / rhs);
+}
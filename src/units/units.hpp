@@ -1,10 +1,12 @@
 #pragma once
+#include "fastMath.hpp"
 #include "position/position.hpp"
 #include "position/angle.hpp"
 #include "position/positionVector.hpp"
+#include "position/pose2.hpp"
 #include "velocity/velocity.hpp"
 #include "velocity/angularVelocity.hpp"
-#include "velocity/velocityVector.hpp"
+#include "velocity/VelocityVector.hpp"
 #include "acceleration/acceleration.hpp"
 #include "acceleration/angularAcceleration.hpp"
 #include "acceleration/accelerationVector.hpp"
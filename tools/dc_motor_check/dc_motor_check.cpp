@@ -0,0 +1,300 @@
+// DCMotorTとMotorGroupの出力のタイミングを、FakePwmBackendの模擬タイマーで確かめるホスト用ツール。
+// 時刻を1usずつ進め、PWM周期の境界ごとに全モーターのタイマーの更新イベントを起こす (駆動輪は同じタイマーの想定)。
+// 制御周期ごとにMotorGroupでランダムなduty比(符号の反転を含む)をstage/commitし、次を確かめる。
+// - 方向ピンを変えた時点で、出力中のCCR(active)が0で、かつ0が1周期以上出力されていたか
+// - commitしたduty比が全モーターで同じ更新イベントで出力に反映されたか
+// 続けて、setDriveConfig/setModelによるduty比の整形を同じ模擬時刻で確かめる。
+// - デッドバンド以下の指令が0になり、それより上が静止摩擦のduty比から1までに割り当てられるか
+// - deadbandに1以上などの範囲外の値を渡しても、出力がNaNにならず-1から1に収まるか
+// - 制御周期ごとのduty比の変化がmax_slew_rate * 周期以下で、いずれ指令に追い付くか
+// - 電流制限を有効にしたとき、推定電流がmax_current以下か
+// 1つでも満たさなければ終了コード1。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/dc_motor_check/dc_motor_check.cpp -o dc_motor_check
+//
+// ### usage
+// ./dc_motor_check
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "driver/pwm/FakePwmBackend.hpp"
+#include "driver/DCMotor.hpp"
+#include "driver/MotorGroup.hpp"
+
+namespace
+{
+    using Motor = DCMotorT<FakePwmBackend>;
+
+    constexpr int MOTORS = 3;
+    constexpr float PWM_FREQUENCY = 10000.0f;                         // 周期100us (1us刻みで境界が来るように)
+    constexpr std::chrono::microseconds PWM_PERIOD(100);
+    constexpr std::chrono::microseconds CONTROL_PERIOD(5000);
+    constexpr std::chrono::microseconds DURATION = std::chrono::seconds(20);
+
+    struct Channel
+    {
+        int dir;                  // 前回見た方向ピン
+        uint32_t zero_since;      // activeが0になった更新イベントの番号
+        bool is_zero;             // activeが0か
+        uint32_t pending_compare; // commitで書かれ、まだ反映されていないCCR
+        bool is_pending;
+    };
+
+    bool checkReversal()
+    {
+        std::array<Motor, MOTORS> motors = {Motor(NC, NC, true, PWM_FREQUENCY), Motor(NC, NC, false, PWM_FREQUENCY), Motor(NC, NC, true, PWM_FREQUENCY)};
+        MotorGroup<MOTORS, Motor> group({&motors[0], &motors[1], &motors[2]});
+
+        std::array<Channel, MOTORS> channels;
+        for (int i = 0; i < MOTORS; i++)
+        {
+            channels[i] = {0, 0, true, 0, false};
+        }
+
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> duty_distribution(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> phase_distribution(0, (int)PWM_PERIOD.count() - 1);
+
+        int reversals = 0;
+        int unsafe_reversals = 0;
+        int commits = 0;
+        int split_commits = 0;
+        long max_commit_latency = 0;
+
+        HighResClock::time_point now = HighResClock::now(); // 前の確認の続きから (時刻を戻さない)
+        HighResClock::time_point next_control = now + CONTROL_PERIOD + std::chrono::microseconds(phase_distribution(random));
+        HighResClock::time_point commit_time{};
+        uint32_t update_index = 0;
+
+        while (now.time_since_epoch() < DURATION)
+        {
+            now += std::chrono::microseconds(1);
+            HighResClock::setNow(now);
+
+            // PWM周期の境界: 全チャンネルの更新イベント
+            if (now.time_since_epoch().count() % PWM_PERIOD.count() == 0)
+            {
+                update_index++;
+                int applied = 0;
+                int pending = 0;
+                for (int i = 0; i < MOTORS; i++)
+                {
+                    FakePwmBackend &pwm = motors[i].getPwmBackend();
+                    pwm.updateEvent();
+
+                    bool is_zero = pwm.getActiveCompare() == 0;
+                    if (is_zero && !channels[i].is_zero)
+                    {
+                        channels[i].zero_since = update_index;
+                    }
+                    channels[i].is_zero = is_zero;
+
+                    if (channels[i].is_pending)
+                    {
+                        pending++;
+                        if (pwm.getActiveCompare() == channels[i].pending_compare)
+                        {
+                            applied++;
+                            channels[i].is_pending = false;
+                        }
+                    }
+                }
+
+                if (pending > 0)
+                {
+                    // 同じ更新イベントで全部反映されるはず
+                    split_commits += (applied != pending);
+                    max_commit_latency = std::max(max_commit_latency, (long)(now - commit_time).count());
+                    for (Channel &channel : channels)
+                    {
+                        channel.is_pending = false;
+                    }
+                }
+            }
+
+            if (now < next_control)
+            {
+                continue;
+            }
+            next_control += CONTROL_PERIOD;
+
+            // 1/4の確率で符号を反転させる
+            std::array<float, MOTORS> duty;
+            for (int i = 0; i < MOTORS; i++)
+            {
+                float magnitude = std::fabs(duty_distribution(random));
+                float previous = motors[i].getDuty();
+                bool flip = (random() % 4) == 0;
+                duty[i] = (previous >= 0.0f) != flip ? magnitude : -magnitude;
+            }
+
+            group.stage(duty);
+            group.commit();
+            commits++;
+            commit_time = now;
+
+            for (int i = 0; i < MOTORS; i++)
+            {
+                FakePwmBackend &pwm = motors[i].getPwmBackend();
+                channels[i].pending_compare = pwm.getPreloadCompare();
+                channels[i].is_pending = pwm.getPreloadCompare() != pwm.getActiveCompare();
+
+                // 方向ピンが変わったら、その時点の出力を調べる
+                int dir = motors[i].readDirPin();
+                if (dir != channels[i].dir)
+                {
+                    reversals++;
+                    bool is_safe = pwm.getActiveCompare() == 0 && update_index - channels[i].zero_since >= 1;
+                    unsafe_reversals += !is_safe;
+                    channels[i].dir = dir;
+                }
+            }
+        }
+
+        printf("reversals %d, while driving or without a full zero period: %d\n", reversals, unsafe_reversals);
+        printf("commits %d, applied across different update events: %d, max commit -> output %ld us (PWM period %ld us)\n",
+               commits, split_commits, max_commit_latency, (long)PWM_PERIOD.count());
+
+        return reversals > 0 && unsafe_reversals == 0 && split_commits == 0 && max_commit_latency <= PWM_PERIOD.count();
+    }
+
+    constexpr float TOLERANCE = 1e-5f;
+
+    // 模擬時刻を進める
+    void advance(HighResClock::time_point &now, std::chrono::microseconds time)
+    {
+        now += time;
+        HighResClock::setNow(now);
+    }
+
+    // 新しいモーターに指令を出し、整形後のduty比を返す
+    // 向きが変わる指令は1回目が0になるので、反転の保持時間より後にもう1回出す。
+    float shapeOnce(HighResClock::time_point &now, DCMotorDriveConfig config, float duty)
+    {
+        Motor motor(NC, NC, true, PWM_FREQUENCY);
+        motor.setDriveConfig(config);
+        motor.setDuty(duty);
+        advance(now, PWM_PERIOD * 2);
+        motor.setDuty(duty);
+        return motor.getAppliedDuty();
+    }
+
+    bool checkDeadband()
+    {
+        HighResClock::time_point now = HighResClock::now(); // 前の確認の続きから (時刻を戻さない)
+        const DCMotorDriveConfig config = {.deadband = 0.1f, .stiction_duty = 0.2f};
+
+        int errors = 0;
+        for (int i = -120; i <= 120; i++)
+        {
+            float duty = i / 100.0f;
+            float magnitude = std::fabs(duty);
+            float expected = 0.0f;
+            if (magnitude > config.deadband)
+            {
+                float ratio = (std::fmin(magnitude, 1.0f) - config.deadband) / (1.0f - config.deadband);
+                expected = std::copysign(config.stiction_duty + (1.0f - config.stiction_duty) * ratio, duty);
+            }
+            errors += std::fabs(shapeOnce(now, config, duty) - expected) > TOLERANCE;
+        }
+
+        // デッドバンドのすぐ上は静止摩擦のduty比、1以上は1
+        float above_deadband = shapeOnce(now, config, config.deadband + 1e-4f);
+        float full = shapeOnce(now, config, -1.5f);
+        bool is_continuous = std::fabs(above_deadband - config.stiction_duty) < 1e-3f && std::fabs(full + 1.0f) < TOLERANCE;
+
+        // 範囲外の設定 (deadband >= 1 は以前0除算になっていた)
+        int invalid = 0;
+        for (float deadband : {1.0f, 1.5f, -0.5f})
+        {
+            for (int i = -15; i <= 15; i++) // 1を超える指令で (1 - 1) / (1 - 1) になっていた
+            {
+                float applied = shapeOnce(now, {.deadband = deadband, .stiction_duty = 1.5f}, i / 10.0f);
+                invalid += !std::isfinite(applied) || std::fabs(applied) > 1.0f;
+            }
+        }
+
+        printf("deadband/stiction: mismatches %d, %.4f just above deadband, %.4f at -1.5, out-of-range config invalid outputs %d\n",
+               errors, above_deadband, full, invalid);
+        return errors == 0 && is_continuous && invalid == 0;
+    }
+
+    bool checkSlew()
+    {
+        HighResClock::time_point now = HighResClock::now(); // 前の確認の続きから (時刻を戻さない)
+        const DCMotorDriveConfig config = {.max_slew_rate = 20.0f};
+        const float max_step = config.max_slew_rate * std::chrono::duration<float>(CONTROL_PERIOD).count();
+        const int settle_steps = (int)std::ceil(2.0f / max_step) + 2; // +1 -> -1 と、反転の保持の1周期
+
+        Motor motor(NC, NC, true, PWM_FREQUENCY);
+        motor.setDriveConfig(config);
+
+        std::mt19937 random(2);
+        std::uniform_real_distribution<float> duty_distribution(-1.0f, 1.0f);
+
+        float max_change = 0.0f;
+        int unsettled = 0;
+        for (int target = 0; target < 200; target++)
+        {
+            float duty = duty_distribution(random);
+            for (int step = 0; step < settle_steps; step++)
+            {
+                float previous = motor.getAppliedDuty();
+                advance(now, CONTROL_PERIOD);
+                motor.setDuty(duty);
+                max_change = std::max(max_change, std::fabs(motor.getAppliedDuty() - previous));
+            }
+            unsettled += std::fabs(motor.getAppliedDuty() - duty) > TOLERANCE;
+        }
+
+        printf("slew: max change %.4f per %ld us (limit %.4f), targets not reached in %d steps: %d\n",
+               max_change, (long)CONTROL_PERIOD.count(), max_step, settle_steps, unsettled);
+        return max_change <= max_step + TOLERANCE && unsettled == 0;
+    }
+
+    bool checkCurrentLimit()
+    {
+        HighResClock::time_point now = HighResClock::now(); // 前の確認の続きから (時刻を戻さない)
+        const DCMotorModel model = {.supply_voltage = 12.0f, .resistance = 1.0f, .back_emf_constant = 0.02f, .max_current = 3.0f};
+
+        std::mt19937 random(3);
+        std::uniform_real_distribution<float> duty_distribution(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> speed_distribution(-300.0f, 300.0f); // 逆起電力がduty比0.5まで
+
+        float max_current = 0.0f;
+        int changed_within_limit = 0;
+        for (int i = 0; i < 10000; i++)
+        {
+            Motor motor(NC, NC, true, PWM_FREQUENCY);
+            motor.setModel(model);
+            float duty = duty_distribution(random);
+            float speed = speed_distribution(random);
+            motor.setMeasuredSpeed(RadPerSecond(speed));
+            motor.setDuty(duty);
+            advance(now, PWM_PERIOD * 2);
+            motor.setDuty(duty);
+
+            max_current = std::max(max_current, std::fabs(motor.getEstimatedCurrent()));
+
+            // 制限に掛からない指令はそのまま出す
+            float current = (duty * model.supply_voltage - model.back_emf_constant * speed) / model.resistance;
+            changed_within_limit += std::fabs(current) <= model.max_current && std::fabs(motor.getAppliedDuty() - duty) > TOLERANCE;
+        }
+
+        printf("current limit: max estimated current %.4f A (limit %.1f A), commands changed within the limit: %d\n",
+               max_current, model.max_current, changed_within_limit);
+        return max_current <= model.max_current + 1e-3f && changed_within_limit == 0;
+    }
+}
+
+int main()
+{
+    bool ok = checkReversal();
+    ok &= checkDeadband();
+    ok &= checkSlew();
+    ok &= checkCurrentLimit();
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
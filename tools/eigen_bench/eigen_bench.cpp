@@ -0,0 +1,245 @@
+// 同梱のEigenで、制御に出てくる大きさの行列演算の速さを測るホスト用ツール。
+// SSEのパケット演算あり・なしの両方でビルドして比べる。
+// ベクトル化したときの結果は、誤差の範囲でベクトル化しない場合と一致する(最大残差も表示する)。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -msse4.1 -Ilib/Eigen/include tools/eigen_bench/eigen_bench.cpp -o eigen_bench_sse
+// g++ -std=gnu++17 -O2 -msse4.1 -DEIGEN_DONT_VECTORIZE -Ilib/Eigen/include tools/eigen_bench/eigen_bench.cpp -o eigen_bench_scalar
+//
+// Cortex-M4F向けの設定とカーネル(arch/CortexM)をホストで試すときは、ベクトル化を切ってEIGEN_ARCH_CORTEXMを定義する。
+// カーネルと汎用の実装の結果がビット単位で一致するかも確認する。実機のビルドに合わせて-Osで比べる。
+// g++ -std=gnu++17 -Os -DEIGEN_DONT_VECTORIZE -DEIGEN_ARCH_CORTEXM -Ilib/Eigen/include tools/eigen_bench/eigen_bench.cpp -o eigen_bench_cortexm
+//
+// ### usage
+// ./eigen_bench_sse [iterations]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <Dense.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 最適化で消されないように結果を足し込む
+    volatile float sink;
+
+    // dataの指す値をすべて読み書きしたものとコンパイラーに思わせる (ループの中の計算を消させず、外にも出させない)
+    // 結果の1要素だけを次の入力に足し込むと、他の要素の計算が消されてしまう。
+    inline void clobber(const void *data)
+    {
+        asm volatile("" : : "g"(data) : "memory");
+    }
+
+    constexpr int ROUNDS = 5; // iterationsをこの回数に分けて測り、最小の平均を取る (他のプロセスの割り込みを除く)
+
+    template <typename Function>
+    double measure(int iterations, Function function)
+    {
+        int round_iterations = iterations / ROUNDS + 1;
+        double best = 1e300;
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < round_iterations; i++)
+            {
+                function();
+            }
+            Clock::time_point end = Clock::now();
+            best = std::fmin(best, std::chrono::duration<double, std::nano>(end - start).count() / round_iterations);
+        }
+
+        return best;
+    }
+
+    // n x n の積、LU分解での求解、コレスキー分解での求解
+    template <int N>
+    void benchSize(int iterations)
+    {
+        using Matrix = Eigen::Matrix<float, N, N>;
+        using Vector = Eigen::Matrix<float, N, 1>;
+
+        Matrix a = Matrix::Random() + Matrix::Identity() * N;
+        Matrix b = Matrix::Random();
+        Matrix spd = a * a.transpose() + Matrix::Identity();
+        Vector rhs = Vector::Random();
+        // 入力のアドレスを渡しておくと、毎回のclobberで書き換わりうるものとして扱われ、計算をループの外に出せない
+        clobber(a.data());
+        clobber(b.data());
+        clobber(spd.data());
+        clobber(rhs.data());
+
+        Matrix product = Matrix::Zero();
+        double product_ns = measure(iterations, [&]()
+                                    {
+                                        product.noalias() = a * b;
+                                        clobber(product.data());
+                                    });
+
+        Vector solution = Vector::Zero();
+        double lu_ns = measure(iterations, [&]()
+                               {
+                                   solution = a.partialPivLu().solve(rhs);
+                                   clobber(solution.data());
+                               });
+
+        double llt_ns = measure(iterations, [&]()
+                                {
+                                    solution = spd.llt().solve(rhs);
+                                    clobber(solution.data());
+                                });
+
+        float residual = (a * a.partialPivLu().solve(rhs) - rhs).cwiseAbs().maxCoeff();
+        sink = product.sum() + solution.sum();
+
+        printf("%2dx%-2d  product %8.1f ns  lu solve %8.1f ns  llt solve %8.1f ns  residual %.2g\n",
+               N, N, product_ns, lu_ns, llt_ns, residual);
+    }
+
+    void benchInverse4(int iterations)
+    {
+        Eigen::Matrix4f a = Eigen::Matrix4f::Random() + Eigen::Matrix4f::Identity() * 4;
+        Eigen::Matrix4f inverse;
+        clobber(a.data());
+        double inverse_ns = measure(iterations, [&]()
+                                    {
+                                        inverse = a.inverse();
+                                        clobber(inverse.data());
+                                    });
+
+        float residual = (a * a.inverse() - Eigen::Matrix4f::Identity()).cwiseAbs().maxCoeff();
+        sink = inverse.sum();
+
+        printf("4x4    inverse %8.1f ns  residual %.2g\n", inverse_ns, residual);
+    }
+
+    // オドメトリ: 車輪の回転数 -> 機体速度 (3x4の疑似逆行列 x 4輪)
+    // フィルタ: 6状態の共分散の予測 F P F^T + Q
+    void benchWorkloads(int iterations)
+    {
+        Eigen::Matrix<float, 3, 4> wheel_matrix_inv = Eigen::Matrix<float, 3, 4>::Random();
+        Eigen::Vector4f wheel_speeds = Eigen::Vector4f::Random();
+        Eigen::Vector3f velocity = Eigen::Vector3f::Zero();
+        clobber(wheel_matrix_inv.data());
+        clobber(wheel_speeds.data());
+        double odometry_ns = measure(iterations, [&]()
+                                     {
+                                         velocity = wheel_matrix_inv * wheel_speeds;
+                                         clobber(velocity.data());
+                                     });
+
+        using Matrix6f = Eigen::Matrix<float, 6, 6>;
+        Matrix6f transition = Matrix6f::Identity() + Matrix6f::Random() * 0.01f;
+        Matrix6f covariance = Matrix6f::Identity();
+        Matrix6f noise = Matrix6f::Identity() * 1e-4f;
+        clobber(transition.data());
+        clobber(noise.data());
+        double filter_ns = measure(iterations, [&]()
+                                   {
+                                       covariance = transition * covariance * transition.transpose() + noise;
+                                       covariance *= 0.5f;
+                                       clobber(covariance.data());
+                                   });
+
+        sink = velocity.sum() + covariance.sum();
+
+        printf("odometry 3x4*4 %8.1f ns  filter predict 6x6 %8.1f ns\n", odometry_ns, filter_ns);
+    }
+
+#ifdef EIGEN_ARCH_CORTEXM
+    // Cortex-M向けカーネルを汎用の実装と比べる
+    // blocked()はカーネルに、unblocked()は汎用の実装に振り分けられる。
+    template <int N>
+    void benchCortexMLlt(int iterations)
+    {
+        using Matrix = Eigen::Matrix<float, N, N>;
+
+        int mismatches = 0;
+        for (int i = 0; i < 10000; i++)
+        {
+            Matrix a = Matrix::Random();
+            Matrix kernel = a * a.transpose() + Matrix::Identity() * 0.01f;
+            Matrix generic = kernel;
+            Eigen::internal::llt_inplace<float, Eigen::Lower>::blocked(kernel);
+            Eigen::internal::llt_inplace<float, Eigen::Lower>::unblocked(generic);
+            mismatches += std::memcmp(kernel.data(), generic.data(), sizeof(Matrix)) != 0;
+        }
+
+        Matrix a = Matrix::Random();
+        Matrix spd = a * a.transpose() + Matrix::Identity();
+        Matrix factor = spd;
+        clobber(spd.data());
+        double kernel_ns = measure(iterations, [&]()
+                                   {
+                                       factor = spd;
+                                       Eigen::internal::llt_inplace<float, Eigen::Lower>::blocked(factor);
+                                       clobber(factor.data());
+                                   });
+        double generic_ns = measure(iterations, [&]()
+                                    {
+                                        factor = spd;
+                                        Eigen::internal::llt_inplace<float, Eigen::Lower>::unblocked(factor);
+                                        clobber(factor.data());
+                                    });
+        sink = factor.sum();
+
+        printf("%dx%d    llt kernel %8.1f ns  generic %8.1f ns  mismatches %d/10000\n", N, N, kernel_ns, generic_ns, mismatches);
+    }
+
+    void benchCortexMInverse6(int iterations)
+    {
+        using Matrix6f = Eigen::Matrix<float, 6, 6>;
+        using Generic = Eigen::internal::compute_inverse_size6<Eigen::Architecture::Generic, float, Matrix6f, Matrix6f>;
+
+        int mismatches = 0;
+        for (int i = 0; i < 10000; i++)
+        {
+            Matrix6f a = Matrix6f::Random();
+            Matrix6f kernel = a.inverse();
+            Matrix6f generic;
+            Generic::run(a, generic);
+            mismatches += std::memcmp(kernel.data(), generic.data(), sizeof(Matrix6f)) != 0;
+        }
+
+        Matrix6f a = Matrix6f::Random() + Matrix6f::Identity() * 6;
+        Matrix6f inverse;
+        clobber(a.data());
+        double kernel_ns = measure(iterations, [&]()
+                                   {
+                                       inverse = a.inverse();
+                                       clobber(inverse.data());
+                                   });
+        double generic_ns = measure(iterations, [&]()
+                                    {
+                                        Generic::run(a, inverse);
+                                        clobber(inverse.data());
+                                    });
+        sink = inverse.sum();
+
+        printf("6x6    inverse kernel %8.1f ns  generic %8.1f ns  mismatches %d/10000\n", kernel_ns, generic_ns, mismatches);
+    }
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    printf("SIMD: %s\n", Eigen::SimdInstructionSetsInUse());
+    benchSize<3>(iterations);
+    benchSize<4>(iterations);
+    benchSize<6>(iterations);
+    benchSize<8>(iterations);
+    benchSize<12>(iterations);
+    benchInverse4(iterations);
+    benchWorkloads(iterations);
+#ifdef EIGEN_ARCH_CORTEXM
+    benchCortexMLlt<4>(iterations);
+    benchCortexMLlt<6>(iterations);
+    benchCortexMInverse6(iterations);
+#endif
+
+    return 0;
+}
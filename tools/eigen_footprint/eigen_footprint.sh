@@ -0,0 +1,51 @@
+#!/bin/sh
+# Eigenのインクルードの構成ごとに、制御の計算(probe.cpp)のコンパイル時間とオブジェクトの大きさを比べる。
+#   control: 各ヘッダーのまま (ControlMath.h: Core + LU + Cholesky)
+#   dense:   Dense.h (QR, SVD, Geometry, Eigenvalues も含む) を先にインクルードした場合
+# textとdataの和がフラッシュの使用量になる。ファームウェア全体のフラッシュ使用量は`pio run`の最後に表示される。
+#
+# ### usage (リポジトリのルートで実行)
+# sh tools/eigen_footprint/eigen_footprint.sh
+# Cortex-M4Fのコンパイラで測るとき
+# CXX=arm-none-eabi-g++ SIZE=arm-none-eabi-size CXXFLAGS="-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard -Os" sh tools/eigen_footprint/eigen_footprint.sh
+CXX=${CXX:-g++}
+SIZE=${SIZE:-size}
+CXXFLAGS=${CXXFLAGS:--O2 -DEIGEN_DONT_VECTORIZE}
+PROBE=tools/eigen_footprint/probe.cpp
+OUT=${TMPDIR:-/tmp}/eigen_footprint.$$
+
+# ミリ秒単位の時刻 (dateの%Nが無い環境では秒単位になる)
+now_ms() {
+    ms=$(date +%s%3N)
+    case $ms in
+    *N) echo $(($(date +%s) * 1000)) ;;
+    *) echo "$ms" ;;
+    esac
+}
+
+measure() {
+    name=$1
+    shift
+    flags="-std=gnu++17 $CXXFLAGS -Isrc -Ilib/Eigen/include $*"
+
+    lines=$($CXX $flags -E -P $PROBE | grep -cv '^[[:space:]]*$')
+
+    # 3回コンパイルして最短の時間を取る
+    best=
+    for i in 1 2 3; do
+        start=$(now_ms)
+        $CXX $flags -w -c $PROBE -o $OUT.o || exit 1
+        elapsed=$(($(now_ms) - start))
+        if [ -z "$best" ] || [ $elapsed -lt $best ]; then
+            best=$elapsed
+        fi
+    done
+
+    set -- $($SIZE $OUT.o | tail -n 1)
+    printf "%-8s %10s %10s %8s %8s %8s\n" "$name" "$lines" "$best" "$1" "$2" "$3"
+}
+
+printf "%-8s %10s %10s %8s %8s %8s\n" config lines compile_ms text data bss
+measure control
+measure dense -include Dense.h
+rm -f $OUT.o
@@ -0,0 +1,19 @@
+// eigen_footprint.shでコンパイルする、制御で使うEigenの計算を集めた翻訳単位
+// ファームウェアと同じ関数がインスタンス化されるように、mbedに依存しない制御器をそのまま使う。
+#include <array>
+#include <chrono>
+#include "system/MpcController.hpp"
+#include "WheelSettings.hpp"
+
+// 車輪の回転数 -> 機体速度 (オドメトリの疑似逆行列と同じ大きさの積)
+Eigen::Vector3f probeOdometry(const Eigen::Matrix<float, 3, 5> &wheel_matrix_inv, const Eigen::Matrix<float, 5, 1> &wheel_speeds)
+{
+    return wheel_matrix_inv * wheel_speeds;
+}
+
+std::array<float, 3> probeMpc(Position error)
+{
+    static const std::array<WheelPositions, 3> wheel_positions = {WheelSettings::front, WheelSettings::rear_left, WheelSettings::rear_right};
+    static MpcController<3> mpc(wheel_positions, 3.0f, std::chrono::milliseconds(5), MpcWeight{1.0f, 0.5f, 0.01f});
+    return mpc.calculateDuty(error, Radian(0.0f));
+}
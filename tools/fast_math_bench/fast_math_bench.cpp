@@ -0,0 +1,190 @@
+// units/fastMath.hppの三角関数と角度の正規化を、doubleのlibmと比べるホスト用ツール。
+// 精度ごとの最大絶対誤差と1回あたりの時間を表示する。時間は5回測った最小値。
+// 誤差が各精度の想定(fastMath.hppの先頭のコメント)を超えたら終了コード1。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc tools/fast_math_bench/fast_math_bench.cpp -o fast_math_bench
+//
+// ### usage
+// ./fast_math_bench [repeat]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "units/fastMath.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using FastMath::Accuracy;
+
+    constexpr int SIZE = 1024;
+    constexpr double PI = 3.14159265358979323846;
+
+    // コンパイル時に評価できること
+    constexpr FastMath::SinCos QUARTER = FastMath::sincos(FastMath::QUARTER_PI);
+    static_assert(QUARTER.sin > 0.7071f && QUARTER.sin < 0.7072f, "constexpr sin");
+    static_assert(FastMath::wrapAngle(7.0f) > 0.7168f && FastMath::wrapAngle(7.0f) < 0.7169f, "constexpr wrapAngle");
+    static_assert(FastMath::wrapDegree(-190.0f) == 170.0f, "constexpr wrapDegree");
+
+    volatile float sink;
+
+    // functionを配列の全要素に対してrepeat回呼んだときの1回あたりの時間[ns]
+    template <typename Function>
+    double measure(int repeat, const std::vector<float> &inputs, Function function)
+    {
+        double best = 1e9;
+        for (int trial = 0; trial < 5; trial++)
+        {
+            float sum = 0.0f;
+            Clock::time_point start = Clock::now();
+            for (int r = 0; r < repeat; r++)
+            {
+                for (int i = 0; i < SIZE; i++)
+                {
+                    sum += function(inputs[i], inputs[(i + 1) & (SIZE - 1)]);
+                }
+            }
+            std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            sink = sum;
+            best = std::min(best, elapsed.count() / repeat / SIZE);
+        }
+        return best;
+    }
+
+    // [-range, range]を細かく区切ったすべての点での最大絶対誤差
+    template <typename Function, typename Reference>
+    double maxError(float range, Function function, Reference reference)
+    {
+        constexpr int STEPS = 2000000;
+        double max_error = 0.0;
+        for (int i = 0; i <= STEPS; i++)
+        {
+            float x = -range + 2.0f * range * i / STEPS;
+            max_error = std::max(max_error, std::fabs(function(x) - reference((double)x)));
+        }
+        return max_error;
+    }
+
+    // atan2は単位円上の点で比べる
+    template <Accuracy A>
+    double atan2Error()
+    {
+        constexpr int STEPS = 2000000;
+        double max_error = 0.0;
+        for (int i = 0; i <= STEPS; i++)
+        {
+            double angle = -PI + 2.0 * PI * i / STEPS;
+            float y = (float)std::sin(angle) * 3.0f;
+            float x = (float)std::cos(angle) * 3.0f;
+            max_error = std::max(max_error, std::fabs(FastMath::atan2<A>(y, x) - std::atan2((double)y, (double)x)));
+        }
+        return max_error;
+    }
+
+    bool report(const char *name, double error, double tolerance, double time)
+    {
+        bool ok = error <= tolerance;
+        printf("%-22s max error %9.3g (tolerance %8.2g) %s  %6.2f ns\n", name, error, tolerance, ok ? "ok" : "NG", time);
+        return ok;
+    }
+
+    template <Accuracy A>
+    bool checkTier(const char *tier, double tolerance, double atan2_tolerance, int repeat, const std::vector<float> &inputs)
+    {
+        char name[32];
+        bool ok = true;
+
+        double sin_error = std::max(maxError(FastMath::PI, [](float x)
+                                             { return FastMath::sin<A>(x); },
+                                             [](double x)
+                                             { return std::sin(x); }),
+                                    maxError(100.0f, [](float x)
+                                             { return FastMath::sin<A>(x); },
+                                             [](double x)
+                                             { return std::sin(x); }));
+        snprintf(name, sizeof(name), "sin    %s", tier);
+        ok &= report(name, sin_error, tolerance, measure(repeat, inputs, [](float x, float)
+                                                           { return FastMath::sin<A>(x); }));
+
+        double cos_error = std::max(maxError(FastMath::PI, [](float x)
+                                             { return FastMath::cos<A>(x); },
+                                             [](double x)
+                                             { return std::cos(x); }),
+                                    maxError(100.0f, [](float x)
+                                             { return FastMath::cos<A>(x); },
+                                             [](double x)
+                                             { return std::cos(x); }));
+        snprintf(name, sizeof(name), "cos    %s", tier);
+        ok &= report(name, cos_error, tolerance, measure(repeat, inputs, [](float x, float)
+                                                           { return FastMath::cos<A>(x); }));
+
+        snprintf(name, sizeof(name), "sincos %s", tier);
+        ok &= report(name, std::max(sin_error, cos_error), tolerance, measure(repeat, inputs, [](float x, float)
+                                                                                { FastMath::SinCos r = FastMath::sincos<A>(x); return r.sin + r.cos; }));
+
+        snprintf(name, sizeof(name), "atan2  %s", tier);
+        ok &= report(name, atan2Error<A>(), atan2_tolerance, measure(repeat, inputs, [](float y, float x)
+                                                                       { return FastMath::atan2<A>(y, x); }));
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distribution(-3.5f, 3.5f);
+    std::vector<float> inputs(SIZE);
+    for (float &input : inputs)
+    {
+        input = distribution(random);
+    }
+
+    // 基準 (floatのlibm)
+    printf("%-22s %6.2f ns\n", "std::sin (libm)", measure(repeat, inputs, [](float x, float)
+                                                          { return std::sin(x); }));
+    printf("%-22s %6.2f ns\n", "std::cos (libm)", measure(repeat, inputs, [](float x, float)
+                                                          { return std::cos(x); }));
+    printf("%-22s %6.2f ns\n", "std::sin + std::cos", measure(repeat, inputs, [](float x, float)
+                                                              { return std::sin(x) + std::cos(x); }));
+    printf("%-22s %6.2f ns\n", "std::atan2 (libm)", measure(repeat, inputs, [](float y, float x)
+                                                            { return std::atan2(y, x); }));
+
+    bool ok = true;
+    ok &= checkTier<Accuracy::Low>("Low", 4e-4, 1.3e-4, repeat, inputs);
+    ok &= checkTier<Accuracy::Medium>("Medium", 2e-6, 4e-6, repeat, inputs);
+    ok &= checkTier<Accuracy::High>("High", 3e-7, 3e-7, repeat, inputs);
+
+    // 角度の正規化 (以前の書き方と比べる)
+    auto wrapReference = [](double x)
+    { return std::remainder(x, 2.0 * PI); };
+    double wrap_error = maxError(100.0f, [](float x)
+                                 { return FastMath::wrapAngle(x); },
+                                 wrapReference);
+    ok &= report("wrapAngle", wrap_error, 1e-5, measure(repeat, inputs, [](float x, float)
+                                                         { return FastMath::wrapAngle(x * 10.0f); }));
+    printf("%-22s %6.2f ns\n", "std::remainder (libm)", measure(repeat, inputs, [](float x, float)
+                                                                { return std::remainder(x * 10.0f, 2.0f * FastMath::PI); }));
+
+    double degree_error = maxError(1000.0f, [](float x)
+                                   { return FastMath::wrapDegree(x); },
+                                   [](double x)
+                                   { return std::remainder(x, 360.0); });
+    ok &= report("wrapDegree", degree_error, 1e-4, measure(repeat, inputs, [](float x, float)
+                                                           { return FastMath::wrapDegree(x * 100.0f); }));
+    printf("%-22s %6.2f ns\n", "while loop (previous)", measure(repeat, inputs, [](float x, float)
+                                                                {
+                                                                    float yaw = x * 100.0f;
+                                                                    while (yaw > 180.0f)
+                                                                        yaw -= 360.0f;
+                                                                    while (yaw <= -180.0f)
+                                                                        yaw += 360.0f;
+                                                                    return yaw; }));
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+// PinNames.hのホスト用の置き換え
+// ホストにピンは無いので、どのピンもNCとして渡す。
+#pragma once
+
+enum PinName
+{
+    NC = -1,
+};
+
+enum PinMode
+{
+    PullNone,
+    PullUp,
+    PullDown,
+};
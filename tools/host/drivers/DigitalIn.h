@@ -0,0 +1,32 @@
+#pragma once
+#include <map>
+#include "PinNames.h"
+
+namespace mbed
+{
+    // 入力の値はsetLevelでピンごとに与える (ホストのピンはNCだけなので、実際は全てのDigitalInで共通)
+    class DigitalIn
+    {
+    public:
+        DigitalIn(PinName pin) : pin(pin) {}
+        int read()
+        {
+            // 確保しないようにfindで読む (RealTimeSectionの中でも呼ばれるため)
+            auto level = levels().find(pin);
+            return level == levels().end() ? 0 : level->second;
+        }
+        void mode(PinMode) {}
+        operator int() { return read(); }
+
+        static void setLevel(PinName pin, int level) { levels()[pin] = level; }
+
+    private:
+        PinName pin;
+
+        static std::map<PinName, int> &levels()
+        {
+            static std::map<PinName, int> levels;
+            return levels;
+        }
+    };
+}
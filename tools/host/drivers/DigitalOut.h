@@ -0,0 +1,18 @@
+#pragma once
+#include "PinNames.h"
+
+namespace mbed
+{
+    // 書いた値を覚えておき、readで読み返せる
+    class DigitalOut
+    {
+    public:
+        DigitalOut(PinName, int value = 0) : value(value) {}
+        void write(int value) { this->value = value; }
+        int read() { return value; }
+        operator int() { return value; }
+
+    private:
+        int value;
+    };
+}
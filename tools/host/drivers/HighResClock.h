@@ -0,0 +1,22 @@
+#pragma once
+#include <chrono>
+
+namespace mbed
+{
+    // 時刻は呼び出す側(リプレイやベンチマーク)がsetNowで決める
+    // (再生の速さによらず、ログの時刻がそのまま姿勢履歴などに入る)
+    struct HighResClock
+    {
+        using duration = std::chrono::microseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<HighResClock>;
+        static constexpr bool is_steady = true;
+
+        static time_point now() { return current; }
+        static void setNow(time_point time) { current = time; }
+
+    private:
+        static inline time_point current{};
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "PinNames.h"
+#include "platform/Callback.h"
+
+namespace mbed
+{
+    // 割り込みは発生しない
+    class InterruptIn
+    {
+    public:
+        InterruptIn(PinName) {}
+        void rise(Callback<void()>) {}
+        void fall(Callback<void()>) {}
+        int read() { return 0; }
+        void mode(PinMode) {}
+        void enable_irq() {}
+        void disable_irq() {}
+    };
+}
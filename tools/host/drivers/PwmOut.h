@@ -0,0 +1,14 @@
+#pragma once
+#include "PinNames.h"
+
+namespace mbed
+{
+    class PwmOut
+    {
+    public:
+        PwmOut(PinName) {}
+        void period_us(int) {}
+        void write(float) {}
+        void pulsewidth_us(int) {}
+    };
+}
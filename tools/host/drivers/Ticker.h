@@ -0,0 +1,15 @@
+#pragma once
+#include <chrono>
+#include "platform/Callback.h"
+
+namespace mbed
+{
+    // 割り込みは発生しない
+    class Ticker
+    {
+    public:
+        template <typename Rep, typename Period>
+        void attach(Callback<void()>, std::chrono::duration<Rep, Period>) {}
+        void detach() {}
+    };
+}
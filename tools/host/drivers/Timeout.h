@@ -0,0 +1,9 @@
+#pragma once
+#include "drivers/Ticker.h"
+
+namespace mbed
+{
+    class Timeout : public Ticker
+    {
+    };
+}
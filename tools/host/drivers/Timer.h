@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include "drivers/HighResClock.h"
+
+namespace mbed
+{
+    // HighResClock::setNowで進めた時刻で計る
+    class Timer
+    {
+    public:
+        void start()
+        {
+            if (!running)
+            {
+                started = HighResClock::now();
+                running = true;
+            }
+        }
+
+        void stop()
+        {
+            if (running)
+            {
+                elapsed += HighResClock::now() - started;
+                running = false;
+            }
+        }
+
+        void reset()
+        {
+            elapsed = std::chrono::microseconds(0);
+            started = HighResClock::now();
+        }
+
+        std::chrono::microseconds elapsed_time() const
+        {
+            return running ? elapsed + (HighResClock::now() - started) : elapsed;
+        }
+
+    private:
+        HighResClock::time_point started{};
+        std::chrono::microseconds elapsed{0};
+        bool running = false;
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <functional>
+
+namespace mbed
+{
+    template <typename Function>
+    class Callback;
+
+    template <typename R, typename... Args>
+    class Callback<R(Args...)> : public std::function<R(Args...)>
+    {
+    public:
+        using std::function<R(Args...)>::function;
+        Callback() = default;
+    };
+
+    template <typename T, typename R, typename... Args>
+    Callback<R(Args...)> callback(T *object, R (T::*method)(Args...))
+    {
+        return [object, method](Args... args)
+        { return (object->*method)(args...); };
+    }
+
+    template <typename R, typename... Args>
+    Callback<R(Args...)> callback(R (*function)(Args...))
+    {
+        return function;
+    }
+}
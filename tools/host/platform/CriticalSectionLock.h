@@ -0,0 +1,12 @@
+#pragma once
+
+namespace mbed
+{
+    // 割り込みが無いので何もしない
+    class CriticalSectionLock
+    {
+    public:
+        CriticalSectionLock() {}
+        ~CriticalSectionLock() {}
+    };
+}
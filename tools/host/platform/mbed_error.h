@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+// 表示して停止する (mbedと同じくNDEBUGでも消えない)
+[[noreturn]] inline void error(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    abort();
+}
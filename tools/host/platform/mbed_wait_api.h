@@ -0,0 +1,3 @@
+#pragma once
+
+inline void wait_us(int) {}
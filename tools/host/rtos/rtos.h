@@ -0,0 +1,110 @@
+// src/mbed.hppが読むmbed-osのヘッダーのホスト用の置き換え (tools/host以下)
+// -Itools/host でビルドすると、src/mbed.hppはそのままでドライバーやオドメトリがホストでコンパイルできる。
+// 入出力は何もせず、スレッドも割り込みも動かさない (Thread::startしても呼ばない)。Mutexは1スレッドで使う前提で何もしない。
+// EventFlagsは待たずにその時点のフラグを返す。
+// センサーの値はEncoder::addCountやImu::setYawで与え、時刻はHighResClock::setNowで進める (Timerもこの時刻で計る)。
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory> // mbed-osのヘッダーから間接的に読まれるもの
+#include "PinNames.h"
+#include "platform/Callback.h"
+
+constexpr uint32_t osWaitForever = 0xFFFFFFFFU;
+constexpr uint32_t osFlagsError = 0x80000000U;
+constexpr uint32_t osFlagsErrorTimeout = 0xFFFFFFFEU;
+
+namespace rtos
+{
+    struct Kernel
+    {
+        struct Clock
+        {
+            using duration_u32 = std::chrono::duration<uint32_t, std::milli>;
+        };
+        static constexpr Clock::duration_u32 wait_for_u32_forever{0xffffffff};
+    };
+
+    class Mutex
+    {
+    public:
+        void lock() {}
+        void unlock() {}
+        bool trylock() { return true; }
+    };
+
+    // 待たない。待つ時点で立っているフラグを返し、どれも立っていなければタイムアウトとする
+    class EventFlags
+    {
+    public:
+        uint32_t set(uint32_t flags) { return current |= flags; }
+        uint32_t get() const { return current; }
+
+        uint32_t clear(uint32_t flags = 0x7fffffff)
+        {
+            uint32_t previous = current;
+            current &= ~flags;
+            return previous;
+        }
+
+        uint32_t wait_any(uint32_t flags, uint32_t = osWaitForever, bool clear = true)
+        {
+            uint32_t result = current & flags;
+            if (result == 0)
+            {
+                return osFlagsErrorTimeout;
+            }
+            if (clear)
+            {
+                current &= ~flags;
+            }
+            return result;
+        }
+
+        template <typename Rep, typename Period>
+        uint32_t wait_any_for(uint32_t flags, std::chrono::duration<Rep, Period>, bool clear = true)
+        {
+            return wait_any(flags, 0, clear);
+        }
+
+    private:
+        uint32_t current = 0;
+    };
+
+    enum osPriority
+    {
+        osPriorityNormal,
+        osPriorityAboveNormal,
+        osPriorityHigh,
+        osPriorityRealtime,
+    };
+
+    class Thread
+    {
+    public:
+        Thread(osPriority = osPriorityNormal, uint32_t stack_size = 4096, unsigned char * = nullptr, const char * = nullptr) : size(stack_size) {}
+        int start(mbed::Callback<void()>) { return 0; }
+        int join() { return 0; }
+        uint32_t stack_size() const { return size; }
+
+    private:
+        uint32_t size;
+    };
+
+    namespace ThisThread
+    {
+        template <typename Rep, typename Period>
+        void sleep_for(std::chrono::duration<Rep, Period>) {}
+        inline void yield() {}
+
+        // スレッドは1つしか動かないので、常に同じ値を返す
+        inline const void *get_id()
+        {
+            static const char main_thread = 0;
+            return &main_thread;
+        }
+    }
+}
+
+using namespace rtos;
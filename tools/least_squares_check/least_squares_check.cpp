@@ -0,0 +1,125 @@
+// solveLeastSquares(float)の疑似逆行列を、doubleのSVDで求めた疑似逆行列と比べるホスト用ツール。
+// ロボットの車輪配置と、わざと悪くした配置で、条件数・解き方・相対誤差を表示する。
+// 相対誤差が許容値 (正規方程式: 条件数^2 * eps * 10, 固有値分解: 条件数 * eps * 10) を超えたら終了コード1。
+// 条件数も、基準のSVDの特異値から求めたものと比べる。
+// 参考に、以前の A^T (A A^T)^-1 (N>3では正しくない) の誤差も表示する。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/least_squares_check/least_squares_check.cpp -o least_squares_check
+//
+// ### usage
+// ./least_squares_check
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <SVD.h>
+#include "system/LeastSquares.hpp"
+#include "system/WheelVector.hpp"
+
+namespace
+{
+    template <int N>
+    Eigen::Matrix<float, N, 3> getWheelMatrix(const std::array<WheelPositions, N> &wheel_positions)
+    {
+        Eigen::Matrix<float, N, 3> wheel_matrix;
+        for (int i = 0; i < N; i++)
+        {
+            WheelVector wheel_vector = getWheelVector(wheel_positions[i]);
+            wheel_matrix(i, 0) = wheel_vector.x;
+            wheel_matrix(i, 1) = wheel_vector.y;
+            wheel_matrix(i, 2) = wheel_vector.theta;
+        }
+
+        return wheel_matrix;
+    }
+
+    // doubleのSVDによる疑似逆行列 (基準)
+    template <int N>
+    Eigen::Matrix<double, 3, N> referencePseudoInverse(const Eigen::Matrix<double, N, 3> &matrix)
+    {
+        Eigen::JacobiSVD<Eigen::Matrix<double, N, 3>> svd(matrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        double tolerance = svd.singularValues()(0) * N * Eigen::NumTraits<double>::epsilon();
+
+        Eigen::Matrix<double, 3, N> pseudo_inverse = Eigen::Matrix<double, 3, N>::Zero();
+        for (int i = 0; i < 3; i++)
+        {
+            if (svd.singularValues()(i) > tolerance)
+            {
+                pseudo_inverse += svd.matrixV().col(i) * (svd.matrixU().col(i).transpose() / svd.singularValues()(i));
+            }
+        }
+
+        return pseudo_inverse;
+    }
+
+    template <int N>
+    float relativeError(const Eigen::Matrix<float, 3, N> &value, const Eigen::Matrix<double, 3, N> &reference)
+    {
+        return (float)((value.template cast<double>() - reference).cwiseAbs().maxCoeff() / reference.cwiseAbs().maxCoeff());
+    }
+
+    // 配置1つを調べる。expect_rank_deficient: ランク落ちで条件数が無限大になるはずの配置
+    template <int N>
+    bool check(const char *name, const std::array<WheelPositions, N> &wheel_positions, bool expect_rank_deficient = false)
+    {
+        Eigen::Matrix<float, N, 3> wheel_matrix = getWheelMatrix<N>(wheel_positions);
+        Eigen::Matrix<double, 3, N> reference = referencePseudoInverse<N>(wheel_matrix.template cast<double>());
+
+        LeastSquaresSolution<float, N, 3> solution = solveLeastSquares(wheel_matrix);
+        float error = relativeError<N>(solution.pseudo_inverse, reference);
+
+        float epsilon = Eigen::NumTraits<float>::epsilon();
+        float condition = solution.condition_number;
+        float bound = std::isinf(condition) ? 1e-3f : (solution.used_eigendecomposition ? condition : condition * condition) * epsilon * 10.0f;
+
+        // 基準の条件数 (doubleのSVDの特異値から)
+        Eigen::JacobiSVD<Eigen::Matrix<double, N, 3>> svd(wheel_matrix.template cast<double>());
+        double reference_condition = svd.singularValues()(0) / svd.singularValues()(2);
+        bool condition_ok = std::isinf(condition) ? expect_rank_deficient : std::fabs(condition / reference_condition - 1.0) <= 1e-4;
+
+        bool ok = std::isinf(condition) == expect_rank_deficient && condition_ok && error <= bound;
+
+        printf("%-24s N=%d  condition %10.4g (svd %10.4g)  %-5s  error %9.3g  bound %9.3g  %s",
+               name, N, condition, reference_condition, solution.used_eigendecomposition ? "eigen" : "ldlt", error, bound, ok ? "ok" : "NG");
+
+        // 以前の式 A^T (A A^T)^-1 (N == 3ならA^-1と同じ)
+        if (N > 3)
+        {
+            Eigen::Matrix<float, N, N> gram = wheel_matrix * wheel_matrix.transpose();
+            Eigen::Matrix<float, 3, N> previous = wheel_matrix.transpose() * gram.inverse();
+            printf("  (previous formula error %.3g)", relativeError<N>(previous, reference));
+        }
+        printf("\n");
+
+        return ok;
+    }
+
+    WheelPositions wheelAt(float x, float y, float theta)
+    {
+        return WheelPositions{Position(Meter(x), Meter(y), Radian(theta)), WheelSettings::WHEEL_RAD};
+    }
+}
+
+int main()
+{
+    using namespace WheelSettings;
+    bool ok = true;
+
+    // 実機の配置
+    ok &= check<3>("omni 3 wheels", {front, rear_left, rear_right});
+    ok &= check<5>("omni 3 + measuring 2", {front, rear_left, rear_right, measuring_x, measuring_y});
+
+    // 4輪のX配置
+    float r = 0.2f;
+    float pi = (float)M_PI;
+    ok &= check<4>("omni 4 wheels (X)", {wheelAt(r, r, pi * 3 / 4), wheelAt(-r, r, -pi * 3 / 4), wheelAt(-r, -r, -pi / 4), wheelAt(r, -r, pi / 4)});
+
+    // 計測輪が機体中心の近くに集まっていて、回転がほとんど見えない配置
+    ok &= check<4>("measuring near center", {wheelAt(0.01f, 0.0f, pi / 2), wheelAt(-0.01f, 0.0f, pi / 2), wheelAt(0.0f, 0.01f, 0.0f), wheelAt(0.0f, -0.01f, 0.0f)});
+    ok &= check<4>("measuring almost center", {wheelAt(0.001f, 0.0f, pi / 2), wheelAt(-0.001f, 0.0f, pi / 2), wheelAt(0.0f, 0.001f, 0.0f), wheelAt(0.0f, -0.001f, 0.0f)});
+
+    // 全輪が平行でy方向が見えない配置 (ランク落ち)
+    ok &= check<4>("all parallel", {wheelAt(0.1f, 0.1f, 0.0f), wheelAt(-0.1f, 0.1f, 0.0f), wheelAt(-0.1f, -0.1f, 0.0f), wheelAt(0.1f, -0.1f, 0.0f)}, true);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,505 @@
+// src/systemとsrc/unitsの制御周期ごとに通る処理の1回あたりの時間を測るホスト用のマイクロベンチマーク。
+// mbedのAPIはtools/hostの置き換えを使う (スレッドや割り込みは動かず、エンコーダーのカウントはaddCountで与える)。
+//
+// 各ベンチマークは1回の測定(サンプル)が約5msになるよう回数を決めてから、全ベンチマークを順に回して既定で25サンプルずつ測る。
+// 中央値と、その95%信頼区間(順序統計量による)、四分位範囲、最小値を表示する。
+// --saveで結果をJSONに保存し、--compareで保存した結果と比べる。
+// 他のプロセスなどによる揺らぎは時間を増やす方向にしか働かないので、比べるのは最小値とする。
+// 最小値がthreshold[%](既定10%)より遅くなり、かつ中央値の信頼区間も重ならないものをSLOWERとし、1つでもあれば終了コード1。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/micro_bench/micro_bench.cpp -o micro_bench
+// または platformio.iniのnative_bench環境
+// pio run -e native_bench && .pio/build/native_bench/program
+//
+// ### usage
+// ./micro_bench [--filter NAME] [--samples N] [--save FILE] [--compare FILE] [--threshold PERCENT]
+// 変更前のブランチで --save baseline.json、変更後に --compare baseline.json (同じマシンで測ること)
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "WheelSettings.hpp"
+#include "driver/pwm/FakePwmBackend.hpp"
+#include "driver/DCMotor.hpp"
+#include "driver/ServoMotor.hpp"
+#include "driver/MotorGroup.hpp"
+#include "system/PIDController.hpp"
+#include "system/WheelController.hpp"
+#include "system/MpcController.hpp"
+#include "system/odometry/WheelOdometry.hpp"
+#include "control/behavior/BehaviorTree.hpp"
+#include "control/behavior/NodePool.hpp"
+
+// WheelControllerの内部の計算を直接呼ぶ (WheelControllerのfriend)
+template <int N>
+struct WheelControllerAccess
+{
+    static array<MeterPerSecond, N> bodyVelocityToMotorSpeeds(WheelController<N> &wheel_controller, const Velocity velocity)
+    {
+        return wheel_controller.bodyVelocityToMotorSpeeds(velocity);
+    }
+};
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int INPUTS = 256;                                // 入力の種類 (定数畳み込みされないよう毎回変える)
+    constexpr std::chrono::microseconds SAMPLE_TIME = 5000us;  // 1サンプルの目安の時間
+    constexpr int DEFAULT_SAMPLES = 25;
+    constexpr double DEFAULT_THRESHOLD = 10.0; // [%]
+
+    // 値を使ったことにして、計算を消されないようにする
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Statistics
+    {
+        double median;
+        double ci_low; // 中央値の95%信頼区間
+        double ci_high;
+        double p25;
+        double p75;
+        double min;
+        int samples;
+        long iterations; // 1サンプルあたりの回数
+    };
+
+    struct Benchmark
+    {
+        std::string name;
+        std::function<double(long)> run; // iterations回実行して、かかった時間[ns]を返す
+    };
+
+    // bodyをiterations回呼ぶ関数を作る (bodyはインライン展開される)
+    template <typename Body>
+    std::function<double(long)> loop(Body body)
+    {
+        return [body](long iterations) mutable
+        {
+            Clock::time_point start = Clock::now();
+            for (long i = 0; i < iterations; i++)
+            {
+                body((int)(i & (INPUTS - 1)));
+            }
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        };
+    }
+
+    // n個のサンプルの中央値の95%信頼区間の順位 (二項分布の正規近似)
+    std::pair<int, int> medianConfidenceRanks(int n)
+    {
+        double half_width = 1.96 * std::sqrt((double)n) / 2.0;
+        int low = std::max(0, (int)std::floor(n / 2.0 - half_width));
+        int high = std::min(n - 1, (int)std::ceil(n / 2.0 + half_width) - 1);
+        return {low, high};
+    }
+
+    double quantile(const std::vector<double> &sorted, double q)
+    {
+        double position = q * (sorted.size() - 1);
+        size_t index = (size_t)position;
+        double fraction = position - index;
+        return index + 1 < sorted.size() ? sorted[index] * (1.0 - fraction) + sorted[index + 1] * fraction : sorted[index];
+    }
+
+    // 1サンプルがSAMPLE_TIMEを超えるまで回数を倍にする (キャッシュと分岐予測も温まる)
+    long calibrate(Benchmark &benchmark)
+    {
+        long iterations = 16;
+        while (benchmark.run(iterations) < std::chrono::duration<double, std::nano>(SAMPLE_TIME).count() && iterations < (1L << 30))
+        {
+            iterations *= 2;
+        }
+        return iterations;
+    }
+
+    Statistics summarize(std::vector<double> times, long iterations)
+    {
+        std::sort(times.begin(), times.end());
+        int samples = (int)times.size();
+        std::pair<int, int> ranks = medianConfidenceRanks(samples);
+        return Statistics{quantile(times, 0.5), times[ranks.first], times[ranks.second],
+                          quantile(times, 0.25), quantile(times, 0.75), times.front(), samples, iterations};
+    }
+
+    void save(const char *path, const std::vector<std::pair<std::string, Statistics>> &results)
+    {
+        FILE *file = fopen(path, "w");
+        if (!file)
+        {
+            fprintf(stderr, "cannot write %s\n", path);
+            exit(2);
+        }
+
+        fprintf(file, "{\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Statistics &s = results[i].second;
+            fprintf(file, "    {\"name\": \"%s\", \"median_ns\": %.4f, \"ci_low_ns\": %.4f, \"ci_high_ns\": %.4f, "
+                          "\"p25_ns\": %.4f, \"p75_ns\": %.4f, \"min_ns\": %.4f, \"samples\": %d, \"iterations\": %ld}%s\n",
+                    results[i].first.c_str(), s.median, s.ci_low, s.ci_high, s.p25, s.p75, s.min, s.samples, s.iterations,
+                    i + 1 < results.size() ? "," : "");
+        }
+        fprintf(file, "  ]\n}\n");
+        fclose(file);
+    }
+
+    // --saveで書いたJSONを読む (この形式だけを読めればよいので、キーを順に探す)
+    std::map<std::string, Statistics> load(const char *path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            fprintf(stderr, "cannot open %s\n", path);
+            exit(2);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string json = buffer.str();
+
+        auto number = [&](size_t from, const char *key)
+        {
+            size_t at = json.find(std::string("\"") + key + "\":", from);
+            return at == std::string::npos ? 0.0 : std::strtod(json.c_str() + at + strlen(key) + 3, nullptr);
+        };
+
+        std::map<std::string, Statistics> baseline;
+        size_t at = 0;
+        while ((at = json.find("\"name\": \"", at)) != std::string::npos)
+        {
+            size_t begin = at + 9;
+            size_t end = json.find('"', begin);
+            Statistics s = {};
+            s.median = number(end, "median_ns");
+            s.ci_low = number(end, "ci_low_ns");
+            s.ci_high = number(end, "ci_high_ns");
+            s.min = number(end, "min_ns");
+            baseline[json.substr(begin, end - begin)] = s;
+            at = end;
+        }
+
+        return baseline;
+    }
+
+    // 100ノードのビヘイビアツリー (機構3つを並列に動かす想定)
+    // Parallel<3> - Sequence<8> x3 - (Fallback<2> - Condition, Inverter - Action) x8
+    // Conditionは常にFailure。
+    // full = false: Actionは4回に1回だけ完了するので、tickごとに各枝の実行中の1段だけをたどる (普段の動き)
+    // full = true:  Actionはすぐ完了するので、tickごとに全ノードをたどり、最後に全体をresetする (最悪の場合)
+    IBehaviorNode *makeBehaviorTree(bool full)
+    {
+        static NodePool<16384> pool;
+        static int ticks = 0;
+
+        std::array<IBehaviorNode *, 3> branches;
+        for (IBehaviorNode *&branch : branches)
+        {
+            std::array<IBehaviorNode *, 8> steps;
+            for (IBehaviorNode *&step : steps)
+            {
+                IBehaviorNode *condition = pool.create<ConditionNode>([]
+                                                                      { return false; });
+                IBehaviorNode *action = pool.create<ActionNode>([full]
+                                                                { return full || (++ticks & 3) == 0 ? NodeStatus::Failure : NodeStatus::Running; });
+                step = pool.create<FallbackNode<2>>(std::array<IBehaviorNode *, 2>{condition, pool.create<InverterNode>(action)});
+            }
+            branch = pool.create<SequenceNode<8>>(steps);
+        }
+
+        return pool.create<ParallelNode<3>>(branches);
+    }
+
+    std::vector<Benchmark> makeBenchmarks()
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        // 入力 (ループの中で毎回違う値を使う)
+        static Position errors[INPUTS];
+        static Velocity velocities[INPUTS];
+        static Velocity_m_s_deg_s velocities_deg[INPUTS];
+        static Radian angles[INPUTS];
+        static Degree degrees[INPUTS];
+        static Millimeter millimeters[INPUTS];
+        static WheelPositions wheel_positions[INPUTS];
+        static int counts[INPUTS];
+        for (int i = 0; i < INPUTS; i++)
+        {
+            errors[i] = Position(Meter(distribution(random)), Meter(distribution(random)), Radian(distribution(random)));
+            velocities[i] = Velocity(MeterPerSecond(distribution(random)), MeterPerSecond(distribution(random)), RadPerSecond(distribution(random) * 3.0f));
+            velocities_deg[i] = Velocity_m_s_deg_s(MeterPerSecond(distribution(random)), MeterPerSecond(distribution(random)), DegPerSecond(distribution(random) * 180.0f));
+            angles[i] = Radian(distribution(random) * 10.0f);
+            degrees[i] = Degree(distribution(random) * 180.0f);
+            millimeters[i] = Millimeter(distribution(random) * 1000.0f);
+            wheel_positions[i] = {Position(Meter(distribution(random) * 0.2f), Meter(distribution(random) * 0.2f), Radian(distribution(random) * 3.0f)), 30_mm};
+            counts[i] = (int)(distribution(random) * 40.0f); // 5msでのカウントの増分 (±1rps程度)
+        }
+
+        // 実機と同じ配置のセンサーとモーター (ホストでは何も動かない)
+        static Encoder encoders[5] = {{NC, NC}, {NC, NC}, {NC, NC}, {NC, NC}, {NC, NC}};
+        static DCMotor motors[3] = {{NC, NC}, {NC, NC}, {NC, NC}};
+        static PIDGain motor_gain = {0.7f, 0.1f, 0.0f, 200};
+        static PIDGain position_gain = {2.0f, 0.1f, 0.05f, 200};
+        static array<MotorWheel, 3> motor_wheels = {
+            MotorWheel{{WheelSettings::front, encoders[0]}, motors[0], motor_gain},
+            MotorWheel{{WheelSettings::rear_left, encoders[1]}, motors[1], motor_gain},
+            MotorWheel{{WheelSettings::rear_right, encoders[2]}, motors[2], motor_gain},
+        };
+        static array<MeasuringWheel, 5> measuring_wheels = {
+            motor_wheels[0].measuring_wheel,
+            motor_wheels[1].measuring_wheel,
+            motor_wheels[2].measuring_wheel,
+            MeasuringWheel{WheelSettings::measuring_x, encoders[3]},
+            MeasuringWheel{WheelSettings::measuring_y, encoders[4]},
+        };
+        static WheelController<3> wheel_controller(motor_wheels, position_gain, 2_m_s, 0.8f);
+        static WheelOdometry<5> odometry(measuring_wheels);
+        static PIDController<float> pid_float(motor_gain);
+        static PIDController<Position> pid_position(position_gain);
+        static HighResClock::time_point now;
+
+        // レジスタに書くPWMの経路 (FakePwmBackendはStm32PwmBackendと同じ計算でCCRの値を作る)
+        static float duties[INPUTS];
+        for (int i = 0; i < INPUTS; i++)
+        {
+            duties[i] = 0.05f + 0.9f * (distribution(random) + 1.0f) / 2.0f; // 符号は変えない (反転の待ちを含めない)
+        }
+        static FakePwmBackend fake_pwm(NC, 62us);
+        static DCMotorT<FakePwmBackend> fake_motors[3] = {{NC, NC}, {NC, NC}, {NC, NC}};
+        static MotorGroup<3, DCMotorT<FakePwmBackend>> fake_motor_group({&fake_motors[0], &fake_motors[1], &fake_motors[2]});
+        static ServoT<FakePwmBackend> fake_servo(NC, 500us, 2500us);
+        static IBehaviorNode *behavior_tree = makeBehaviorTree(false);
+        static IBehaviorNode *behavior_tree_full = makeBehaviorTree(true);
+        static std::unique_ptr<MpcController<3>> mpc = std::make_unique<MpcController<3>>(WheelSettings::drive_wheels, 3.0f, 5ms, MpcWeight{1.0f, 0.5f, 0.01f}, 0.8f);
+
+        std::vector<Benchmark> benchmarks;
+
+        // PID
+        benchmarks.push_back({"pid/float", loop([](int i)
+                                               { doNotOptimize(pid_float.calculate(errors[i].x.value)); })});
+        benchmarks.push_back({"pid/position", loop([](int i)
+                                                  { doNotOptimize(pid_position.calculate(errors[i])); })});
+
+        // 足回り (速度 -> 車輪の速度 -> duty比 -> MotorGroupで反映)
+        benchmarks.push_back({"wheel_controller/body_to_motor_speeds", loop([](int i)
+                                                                           { doNotOptimize(WheelControllerAccess<3>::bodyVelocityToMotorSpeeds(wheel_controller, velocities[i])); })});
+        benchmarks.push_back({"wheel_controller/update_motors_velocity", loop([](int i)
+                                                                             { wheel_controller.updateMotors(velocities[i], angles[i]); })});
+        benchmarks.push_back({"wheel_controller/update_motors_position", loop([](int i)
+                                                                             { wheel_controller.updateMotors(errors[i], angles[i]); })});
+        benchmarks.push_back({"mpc/solve", loop([](int i)
+                                                { doNotOptimize(mpc->calculateDuty(errors[i], angles[i])); })});
+        benchmarks.push_back({"wheel_vector/get_wheel_vector", loop([](int i)
+                                                                   { doNotOptimize(getWheelVector(wheel_positions[i])); })});
+
+        // オドメトリ (5輪のエンコーダーの読み出しから姿勢履歴への記録まで)
+        benchmarks.push_back({"odometry/wheel5_update", loop([](int i)
+                                                             {
+                                                                 for (int k = 0; k < 5; k++)
+                                                                 {
+                                                                     encoders[k].addCount(counts[(i + k) & (INPUTS - 1)]);
+                                                                 }
+                                                                 now += 5ms;
+                                                                 HighResClock::setNow(now);
+                                                                 odometry.updatePosition(); })});
+        benchmarks.push_back({"odometry/get_position_at", loop([](int i)
+                                                               {
+                                                                   Position position;
+                                                                   doNotOptimize(odometry.getPositionAt(now - std::chrono::microseconds(i * 1000), position));
+                                                                   doNotOptimize(position); })});
+
+        // ビヘイビアツリー (終わったらParallelNodeが自分でresetして最初から)
+        benchmarks.push_back({"behavior_tree/tick_100_nodes", loop([](int)
+                                                                   { doNotOptimize(behavior_tree->tick()); })});
+        benchmarks.push_back({"behavior_tree/tick_100_nodes_full", loop([](int)
+                                                                        { doNotOptimize(behavior_tree_full->tick()); })});
+
+        // PWM (ホストではmbedのPwmOutは何もしないので、レジスタに書く経路だけを測る)
+        benchmarks.push_back({"pwm/fake_write", loop([](int i)
+                                                     { fake_pwm.write(duties[i]); doNotOptimize(fake_pwm.getPreloadCompare()); })});
+        benchmarks.push_back({"pwm/fake_write_pulse_width", loop([](int i)
+                                                                 { fake_pwm.writePulseWidth(chrono::microseconds(500 + (i << 3))); doNotOptimize(fake_pwm.getPreloadCompare()); })});
+        benchmarks.push_back({"pwm/dc_motor_set_duty", loop([](int i)
+                                                            { fake_motors[0].setDuty(duties[i]); })});
+        benchmarks.push_back({"pwm/motor_group_commit_3", loop([](int i)
+                                                              {
+                                                                  fake_motor_group.stage({duties[i], duties[(i + 1) & (INPUTS - 1)], duties[(i + 2) & (INPUTS - 1)]});
+                                                                  fake_motor_group.commit(); })});
+        benchmarks.push_back({"pwm/servo_set_angles", loop([](int i)
+                                                           { fake_servo.setAngles(Radian(angles[i].value * 0.15f)); })});
+
+        // エンコーダー
+        benchmarks.push_back({"encoder/add_count", loop([](int i)
+                                                        { encoders[0].addCount(counts[i]); })});
+        benchmarks.push_back({"encoder/get_rotations", loop([](int)
+                                                            { doNotOptimize(encoders[0].getRotations()); })});
+
+        // 単位
+        benchmarks.push_back({"units/deg_to_rad", loop([](int i)
+                                                       { doNotOptimize(Radian(degrees[i])); })});
+        benchmarks.push_back({"units/mm_to_m", loop([](int i)
+                                                    { doNotOptimize(Meter(millimeters[i])); })});
+        benchmarks.push_back({"units/integrate_deg_s", loop([](int i)
+                                                            {
+                                                                static Position position;
+                                                                position += velocities_deg[i] * std::chrono::duration<float>(0.005f);
+                                                                doNotOptimize(position); })});
+        benchmarks.push_back({"units/normalize_angle", loop([](int i)
+                                                            { doNotOptimize(normalizeAngle(angles[i])); })});
+        benchmarks.push_back({"units/pose2_exp_compose", loop([](int i)
+                                                              {
+                                                                  static Pose2 pose;
+                                                                  pose = pose.compose(Pose2::exp(errors[i] * 0.01f));
+                                                                  doNotOptimize(pose); })});
+        benchmarks.push_back({"units/fast_sincos", loop([](int i)
+                                                        { doNotOptimize(FastMath::sincos(angles[i].value)); })});
+
+        return benchmarks;
+    }
+
+    void usage()
+    {
+        fprintf(stderr, "usage: micro_bench [--filter NAME] [--samples N] [--save FILE] [--compare FILE] [--threshold PERCENT]\n");
+        exit(2);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    const char *save_path = nullptr;
+    const char *compare_path = nullptr;
+    int samples = DEFAULT_SAMPLES;
+    double threshold = DEFAULT_THRESHOLD;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc)
+        {
+            usage();
+        }
+        if (strcmp(argv[i], "--filter") == 0)
+        {
+            filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--samples") == 0)
+        {
+            samples = std::max(5, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--save") == 0)
+        {
+            save_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--compare") == 0)
+        {
+            compare_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--threshold") == 0)
+        {
+            threshold = atof(argv[++i]);
+        }
+        else
+        {
+            usage();
+        }
+    }
+
+    std::map<std::string, Statistics> baseline;
+    if (compare_path)
+    {
+        baseline = load(compare_path);
+    }
+
+    std::vector<Benchmark> benchmarks;
+    for (Benchmark &benchmark : makeBenchmarks())
+    {
+        if (!filter || benchmark.name.find(filter) != std::string::npos)
+        {
+            benchmarks.push_back(benchmark);
+        }
+    }
+
+    // サンプルはベンチマークを1つずつ順に回して取る
+    // (CPUのクロックや他のプロセスの影響が時間とともに変わっても、特定のベンチマークだけに偏らない)
+    std::vector<long> iterations;
+    for (Benchmark &benchmark : benchmarks)
+    {
+        iterations.push_back(calibrate(benchmark));
+    }
+    std::vector<std::vector<double>> times(benchmarks.size());
+    for (int round = 0; round < samples; round++)
+    {
+        for (size_t b = 0; b < benchmarks.size(); b++)
+        {
+            times[b].push_back(benchmarks[b].run(iterations[b]) / iterations[b]);
+        }
+    }
+
+    std::vector<std::pair<std::string, Statistics>> results;
+    int slower = 0;
+
+    printf("%-40s %9s %19s %9s %9s", "benchmark", "median", "95% CI", "IQR", "min");
+    if (compare_path)
+    {
+        printf(" %9s %8s", "baseline", "change");
+    }
+    printf("\n%-40s %9s %19s %9s %9s\n", "", "[ns/op]", "[ns/op]", "[%]", "[ns/op]");
+    for (size_t b = 0; b < benchmarks.size(); b++)
+    {
+        const std::string &name = benchmarks[b].name;
+        Statistics s = summarize(times[b], iterations[b]);
+        results.push_back({name, s});
+        printf("%-40s %9.3f [%8.3f, %8.3f] %8.1f%% %9.3f", name.c_str(), s.median, s.ci_low, s.ci_high, (s.p75 - s.p25) / s.median * 100.0, s.min);
+
+        if (compare_path)
+        {
+            auto found = baseline.find(name);
+            if (found == baseline.end())
+            {
+                printf(" %9s %8s  new", "-", "-");
+            }
+            else
+            {
+                const Statistics &base = found->second;
+                double change = (s.min / base.min - 1.0) * 100.0;
+                // 中央値の信頼区間が重なるうちは差とみなさない
+                const char *status = "";
+                if (change > threshold && s.ci_low > base.ci_high)
+                {
+                    status = "  SLOWER";
+                    slower++;
+                }
+                else if (change < -threshold && s.ci_high < base.ci_low)
+                {
+                    status = "  faster";
+                }
+                printf(" %9.3f %+7.1f%%%s", base.min, change, status);
+            }
+        }
+        printf("\n");
+    }
+
+    if (save_path)
+    {
+        save(save_path, results);
+    }
+    if (compare_path)
+    {
+        printf("%d slower than %s (threshold %.1f%%)\n", slower, compare_path, threshold);
+    }
+
+    return slower > 0 ? 1 : 0;
+}
@@ -0,0 +1,480 @@
+// 記録したセンサーログ(エンコーダーのカウントとIMUのヨー角)をIOdometry<N>の実装にそのまま流し、
+// 推定した姿勢の軌跡と、真値からのずれ(ドリフト)を出力するホスト用ツール。
+// 実時間を待たずに最速で再生し、時刻(HighResClock::now)もログの時刻にするので、同じログからは常に同じ結果になる。
+// 複数のログをまとめて再生できるので、推定器を変えたときの回帰テストに使える。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/odometry_replay/odometry_replay.cpp -o odometry_replay
+//
+// ### usage
+// ./odometry_replay [--odometry wheel3,wheel5,imu3,imu5] [--track DIR] [--max-drift PERCENT] log...
+// ./odometry_replay --generate FILE [seconds] [seed]
+//   --odometry   再生するオドメトリ (既定: すべて)
+//                wheel: WheelOdometry, imu: ImuWheelOdometry。数字は使う計測輪の数 (3: 駆動輪だけ, 5: 計測輪も)
+//   --track      ログごとの軌跡をDIR/<ログのファイル名>.<オドメトリ>.csvに書く
+//   --max-drift  最終位置誤差 / 走行距離[%] がこれを超えたら終了コード1 (真値のあるログだけ)
+//   --generate   シミュレーションで真値付きのログを作る (既定: 60秒, seed 1)。測定輪の滑りとIMUの量子化・ドリフトを含む
+//
+// ログは1行に1サンプル (#以降はコメント)。サンプルごとにupdatePositionを1回呼ぶ。最初のサンプルは初期値にだけ使う。
+//   t[us] count_1 ... count_5 yaw[deg] [truth_x[m] truth_y[m] truth_theta[deg]]
+//   count_i: エンコーダーの累積カウント。main.cppのmeasuring_wheelsと同じ順 (front, rear_left, rear_right, measuring_x, measuring_y)
+//   yaw:     Imuのヨー角の生の値 (BNO055の出力, 0 ~ 360)
+//   truth:   真値 (シミュレーターやモーションキャプチャ)。あれば最初の真値を初期位置にし、ずれを計算する
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "WheelSettings.hpp"
+#include "system/odometry/WheelOdometry.hpp"
+#include "system/odometry/ImuWheelOdometry.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int LOG_WHEELS = 5;                            // ログに記録する計測輪の数
+    constexpr int ENCODER_RESOLUTION = 2048;                 // Encoderの既定の分解能
+    constexpr std::chrono::microseconds PERIOD = 5000us;     // --generateのサンプル周期 (オドメトリの更新周期)
+    constexpr float YAW_LSB = 1.0f / 16.0f;                  // BNO055のヨー角の分解能[deg]
+
+    // ログと同じ順の計測輪の配置
+    constexpr std::array<WheelPositions, LOG_WHEELS> WHEEL_POSITIONS = {
+        WheelSettings::front,
+        WheelSettings::rear_left,
+        WheelSettings::rear_right,
+        WheelSettings::measuring_x,
+        WheelSettings::measuring_y,
+    };
+
+    struct Sample
+    {
+        int64_t time_us;
+        std::array<int, LOG_WHEELS> counts;
+        float yaw;
+        bool has_truth;
+        Position truth;
+    };
+
+    struct Result
+    {
+        std::string log;
+        std::string odometry;
+        int samples = 0;
+        double duration = 0.0;        // ログの長さ[s]
+        double wall_time = 0.0;       // 再生にかかった時間[s]
+        bool has_truth = false;
+        Position final_position;
+        double length = 0.0;          // 真値の走行距離 (真値が無ければ推定の走行距離)[m]
+        double final_error = 0.0;     // 最終位置誤差[m]
+        double max_error = 0.0;       // 最大位置誤差[m]
+        double rms_error = 0.0;       // 位置誤差の二乗平均平方根[m]
+        double max_heading_error = 0.0; // 最大の向きの誤差[deg]
+
+        double drift() const
+        {
+            return length > 0.0 ? final_error / length * 100.0 : 0.0;
+        }
+    };
+
+    std::vector<Sample> readLog(const char *path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            fprintf(stderr, "cannot open %s\n", path);
+            exit(1);
+        }
+
+        std::vector<Sample> samples;
+        std::string line;
+        int line_number = 0;
+        while (std::getline(file, line))
+        {
+            line_number++;
+            line = line.substr(0, line.find('#'));
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+            {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            Sample sample;
+            stream >> sample.time_us;
+            for (int &count : sample.counts)
+            {
+                stream >> count;
+            }
+            stream >> sample.yaw;
+            if (!stream)
+            {
+                fprintf(stderr, "%s:%d: expected \"t count_1 ... count_%d yaw\"\n", path, line_number, LOG_WHEELS);
+                exit(1);
+            }
+
+            float x, y, theta_deg;
+            sample.has_truth = static_cast<bool>(stream >> x >> y >> theta_deg);
+            sample.truth = sample.has_truth ? Position(Meter(x), Meter(y), Radian(Degree(theta_deg))) : Position();
+
+            if (!samples.empty() && sample.time_us <= samples.back().time_us)
+            {
+                fprintf(stderr, "%s:%d: time must increase\n", path, line_number);
+                exit(1);
+            }
+            samples.push_back(sample);
+        }
+
+        if (samples.size() < 2)
+        {
+            fprintf(stderr, "%s must have at least 2 samples\n", path);
+            exit(1);
+        }
+
+        return samples;
+    }
+
+    // ログの計測輪のうち先頭のN個を使うセンサー一式 (ホストではスレッドも割り込みも動かない)
+    template <int N>
+    struct Sensors
+    {
+        std::array<std::unique_ptr<Encoder>, N> encoders;
+        Imu imu;
+        array<MeasuringWheel, N> measuring_wheels;
+
+        Sensors() : encoders(makeEncoders(std::make_index_sequence<N>())),
+                    imu(NC, NC),
+                    measuring_wheels(makeMeasuringWheels(std::make_index_sequence<N>())) {}
+
+    private:
+        template <size_t... I>
+        static std::array<std::unique_ptr<Encoder>, N> makeEncoders(std::index_sequence<I...>)
+        {
+            return {((void)I, std::make_unique<Encoder>(NC, NC, ENCODER_RESOLUTION))...};
+        }
+
+        template <size_t... I>
+        array<MeasuringWheel, N> makeMeasuringWheels(std::index_sequence<I...>)
+        {
+            return {MeasuringWheel{WHEEL_POSITIONS[I], *encoders[I]}...};
+        }
+    };
+
+    template <int N>
+    struct WheelOdometryFactory
+    {
+        static std::unique_ptr<IOdometry<N>> make(Sensors<N> &sensors)
+        {
+            return std::make_unique<WheelOdometry<N>>(sensors.measuring_wheels);
+        }
+    };
+
+    template <int N>
+    struct ImuWheelOdometryFactory
+    {
+        static std::unique_ptr<IOdometry<N>> make(Sensors<N> &sensors)
+        {
+            return std::make_unique<ImuWheelOdometry<N>>(sensors.measuring_wheels, sensors.imu);
+        }
+    };
+
+    FILE *openTrack(const char *directory, const char *log_path, const char *odometry, bool has_truth)
+    {
+        const char *slash = strrchr(log_path, '/');
+        std::string path = std::string(directory) + "/" + (slash ? slash + 1 : log_path) + "." + odometry + ".csv";
+        FILE *file = fopen(path.c_str(), "w");
+        if (!file)
+        {
+            fprintf(stderr, "cannot write %s\n", path.c_str());
+            exit(1);
+        }
+        fprintf(file, has_truth ? "t,x,y,theta,truth_x,truth_y,truth_theta,error\n" : "t,x,y,theta\n");
+        return file;
+    }
+
+    // ログを1つのオドメトリで再生する
+    template <int N, typename Factory>
+    Result replay(const char *log_path, const std::vector<Sample> &samples, const char *name, const char *track_directory)
+    {
+        Result result;
+        result.log = log_path;
+        result.odometry = name;
+        result.has_truth = samples.front().has_truth;
+
+        // 最初のサンプルを基準にする (エンコーダーのカウントは0から、Imuのヨー角はオドメトリの構築時に0になる)
+        Sensors<N> sensors;
+        std::array<int, N> previous_counts;
+        std::copy_n(samples.front().counts.begin(), N, previous_counts.begin());
+        HighResClock::setNow(HighResClock::time_point(std::chrono::microseconds(samples.front().time_us)));
+        sensors.imu.setYaw(samples.front().yaw);
+
+        std::unique_ptr<IOdometry<N>> odometry = Factory::make(sensors);
+        if (result.has_truth)
+        {
+            odometry->setCurrentPosition(samples.front().truth);
+        }
+
+        FILE *track = track_directory ? openTrack(track_directory, log_path, name, result.has_truth) : nullptr;
+        Position last = odometry->getCurrentPosition();
+        Position last_truth = samples.front().truth;
+        double squared_error_sum = 0.0;
+
+        Clock::time_point start = Clock::now();
+        for (size_t k = 1; k < samples.size(); k++)
+        {
+            const Sample &sample = samples[k];
+            HighResClock::setNow(HighResClock::time_point(std::chrono::microseconds(sample.time_us)));
+            for (int i = 0; i < N; i++)
+            {
+                sensors.encoders[i]->addCount(sample.counts[i] - previous_counts[i]);
+                previous_counts[i] = sample.counts[i];
+            }
+            sensors.imu.setYaw(sample.yaw);
+
+            odometry->updatePosition();
+            Position position = odometry->getCurrentPosition();
+            double t = (sample.time_us - samples.front().time_us) * 1e-6;
+
+            if (result.has_truth && sample.has_truth)
+            {
+                double error = std::hypot((position.x - sample.truth.x).value, (position.y - sample.truth.y).value);
+                double heading_error = std::fabs(Degree(normalizeAngle(position.theta - sample.truth.theta)).value);
+                result.final_error = error;
+                result.max_error = std::max(result.max_error, error);
+                result.max_heading_error = std::max(result.max_heading_error, heading_error);
+                result.length += std::hypot((sample.truth.x - last_truth.x).value, (sample.truth.y - last_truth.y).value);
+                squared_error_sum += error * error;
+                last_truth = sample.truth;
+
+                if (track)
+                {
+                    fprintf(track, "%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n", t, position.x.value, position.y.value, position.theta.value,
+                            sample.truth.x.value, sample.truth.y.value, sample.truth.theta.value, error);
+                }
+            }
+            else
+            {
+                result.length += std::hypot((position.x - last.x).value, (position.y - last.y).value);
+                if (track)
+                {
+                    fprintf(track, "%.6f,%.6f,%.6f,%.6f\n", t, position.x.value, position.y.value, position.theta.value);
+                }
+            }
+            last = position;
+            result.samples++;
+        }
+        std::chrono::duration<double> wall_time = Clock::now() - start;
+
+        if (track)
+        {
+            fclose(track);
+        }
+
+        result.final_position = last;
+        result.duration = (samples.back().time_us - samples.front().time_us) * 1e-6;
+        result.wall_time = wall_time.count();
+        result.rms_error = std::sqrt(squared_error_sum / result.samples);
+        return result;
+    }
+
+    struct Variant
+    {
+        const char *name;
+        Result (*replay)(const char *, const std::vector<Sample> &, const char *, const char *);
+    };
+
+    const Variant VARIANTS[] = {
+        {"wheel3", replay<3, WheelOdometryFactory<3>>},
+        {"wheel5", replay<5, WheelOdometryFactory<5>>},
+        {"imu3", replay<3, ImuWheelOdometryFactory<3>>},
+        {"imu5", replay<5, ImuWheelOdometryFactory<5>>},
+    };
+
+    // --generate: 8の字を描きながら向きも変える真値を作り、各計測輪の回転とIMUのヨー角を記録する
+    // 計測輪ごとに一定の滑り(回転数の倍率の誤差)と、IMUのヨー角の一定のドリフトを入れる。
+    void generate(const char *path, double seconds, unsigned seed)
+    {
+        FILE *file = fopen(path, "w");
+        if (!file)
+        {
+            fprintf(stderr, "cannot write %s\n", path);
+            exit(1);
+        }
+
+        std::mt19937 random(seed);
+        std::normal_distribution<double> slip(0.0, 0.005);     // 計測輪の滑り (0.5%)
+        std::normal_distribution<double> yaw_drift(0.0, 0.02); // IMUのヨー角のドリフト[deg/s]
+        std::array<double, LOG_WHEELS> wheel_slips;
+        for (double &wheel_slip : wheel_slips)
+        {
+            wheel_slip = 1.0 + slip(random);
+        }
+        double yaw_drift_rate = yaw_drift(random);
+
+        constexpr double OMEGA = 2.0 * M_PI / 20.0; // 8の字を20秒で1周
+        auto truthAt = [](double t)
+        {
+            return std::array<double, 3>{1.5 * std::sin(OMEGA * t), 0.75 * std::sin(2.0 * OMEGA * t), 1.2 * std::sin(0.5 * OMEGA * t)};
+        };
+
+        fprintf(file, "# odometry_replay --generate %s %g %u\n", path, seconds, seed);
+        fprintf(file, "# t[us] front rear_left rear_right measuring_x measuring_y yaw[deg] truth_x[m] truth_y[m] truth_theta[deg]\n");
+
+        std::array<double, LOG_WHEELS> rotations = {};
+        std::array<double, 3> previous = truthAt(0.0);
+        int64_t steps = (int64_t)(seconds * 1e6 / PERIOD.count());
+        for (int64_t k = 0; k <= steps; k++)
+        {
+            double t = k * PERIOD.count() * 1e-6;
+            std::array<double, 3> truth = truthAt(t);
+
+            // 前回の姿勢から見た移動(SE(2)のlog)を各計測輪の回転に直す
+            double dx = truth[0] - previous[0];
+            double dy = truth[1] - previous[1];
+            double dtheta = truth[2] - previous[2];
+            double c = std::cos(previous[2]);
+            double s = std::sin(previous[2]);
+            double body_x = c * dx + s * dy;
+            double body_y = -s * dx + c * dy;
+            double half = dtheta / 2.0;
+            double v_scale = std::fabs(dtheta) < 1e-9 ? 1.0 : half / std::tan(half);
+            double twist_x = v_scale * body_x + half * body_y;
+            double twist_y = -half * body_x + v_scale * body_y;
+            for (int i = 0; i < LOG_WHEELS; i++)
+            {
+                WheelVector wheel_vector = getWheelVector(WHEEL_POSITIONS[i]);
+                rotations[i] += (wheel_vector.x * twist_x + wheel_vector.y * twist_y + wheel_vector.theta * dtheta) * wheel_slips[i];
+            }
+            previous = truth;
+
+            // BNO055と同じく[0, 360)で1/16度単位
+            double yaw = std::fmod(truth[2] * 180.0 / M_PI + yaw_drift_rate * t, 360.0);
+            yaw = std::round((yaw < 0.0 ? yaw + 360.0 : yaw) / YAW_LSB) * YAW_LSB;
+
+            fprintf(file, "%lld", (long long)(k * PERIOD.count()));
+            for (double rotation : rotations)
+            {
+                fprintf(file, " %ld", std::lround(rotation * ENCODER_RESOLUTION));
+            }
+            fprintf(file, " %.4f %.6f %.6f %.6f\n", yaw >= 360.0 ? 0.0 : yaw, truth[0], truth[1], truth[2] * 180.0 / M_PI);
+        }
+
+        fclose(file);
+        printf("wrote %s (%lld samples, slip", path, (long long)steps + 1);
+        for (double wheel_slip : wheel_slips)
+        {
+            printf(" %+.2f%%", (wheel_slip - 1.0) * 100.0);
+        }
+        printf(", yaw drift %+.3f deg/s)\n", yaw_drift_rate);
+    }
+
+    void usage()
+    {
+        fprintf(stderr, "usage: odometry_replay [--odometry wheel3,wheel5,imu3,imu5] [--track DIR] [--max-drift PERCENT] log...\n");
+        fprintf(stderr, "       odometry_replay --generate FILE [seconds] [seed]\n");
+        exit(2);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "--generate") == 0)
+    {
+        generate(argv[2], argc > 3 ? atof(argv[3]) : 60.0, argc > 4 ? (unsigned)atoi(argv[4]) : 1u);
+        return 0;
+    }
+
+    std::string selected = "wheel3,wheel5,imu3,imu5";
+    const char *track_directory = nullptr;
+    double max_drift = -1.0;
+    std::vector<const char *> logs;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--odometry") == 0 && i + 1 < argc)
+        {
+            selected = argv[++i];
+        }
+        else if (strcmp(argv[i], "--track") == 0 && i + 1 < argc)
+        {
+            track_directory = argv[++i];
+        }
+        else if (strcmp(argv[i], "--max-drift") == 0 && i + 1 < argc)
+        {
+            max_drift = atof(argv[++i]);
+        }
+        else if (argv[i][0] == '-')
+        {
+            usage();
+        }
+        else
+        {
+            logs.push_back(argv[i]);
+        }
+    }
+    if (logs.empty())
+    {
+        usage();
+    }
+
+    std::vector<const Variant *> variants;
+    std::istringstream names(selected);
+    std::string name;
+    while (std::getline(names, name, ','))
+    {
+        auto found = std::find_if(std::begin(VARIANTS), std::end(VARIANTS), [&](const Variant &variant)
+                                  { return name == variant.name; });
+        if (found == std::end(VARIANTS))
+        {
+            fprintf(stderr, "unknown odometry: %s\n", name.c_str());
+            usage();
+        }
+        variants.push_back(found);
+    }
+
+    // Imu::resetYawの表示が混ざらないよう、結果はまとめて最後に出す
+    std::vector<Result> results;
+    for (const char *log : logs)
+    {
+        std::vector<Sample> samples = readLog(log);
+        for (const Variant *variant : variants)
+        {
+            results.push_back(variant->replay(log, samples, variant->name, track_directory));
+        }
+    }
+
+    bool ok = true;
+    printf("%-28s %-7s %7s %9s %9s %9s %9s %9s %8s %9s\n",
+           "log", "odom", "samples", "length", "final", "max", "rms", "heading", "drift", "speed");
+    printf("%-28s %-7s %7s %9s %9s %9s %9s %9s %8s %9s\n",
+           "", "", "", "[m]", "[m]", "[m]", "[m]", "[deg]", "[%]", "[x real]");
+    for (const Result &result : results)
+    {
+        double speed = result.wall_time > 0.0 ? result.duration / result.wall_time : 0.0;
+        if (result.has_truth)
+        {
+            bool passed = max_drift < 0.0 || result.drift() <= max_drift;
+            ok &= passed;
+            printf("%-28s %-7s %7d %9.3f %9.4f %9.4f %9.4f %9.3f %8.3f %9.0f%s\n",
+                   result.log.c_str(), result.odometry.c_str(), result.samples, result.length,
+                   result.final_error, result.max_error, result.rms_error, result.max_heading_error, result.drift(), speed,
+                   passed ? "" : "  NG");
+        }
+        else
+        {
+            // 真値が無いときは最終の姿勢だけ (オドメトリどうしの比較用)
+            printf("%-28s %-7s %7d %9.3f  final (%.4f, %.4f, %.2f deg) %29.0f\n",
+                   result.log.c_str(), result.odometry.c_str(), result.samples, result.length,
+                   result.final_position.x.value, result.final_position.y.value, Degree(result.final_position.theta).value, speed);
+        }
+    }
+
+    return ok ? 0 : 1;
+}
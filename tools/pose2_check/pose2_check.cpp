@@ -0,0 +1,229 @@
+// Pose2(SE(2))の演算をdoubleで計算した基準と比べるホスト用ツール。
+// 合成・逆・exp/log・補間の誤差と、合成を繰り返したときのcos, sinのずれを表示する。
+// 最後に、オドメトリの1ステップと姿勢の補間を以前の書き方(三角関数を毎回呼ぶ)と比べた時間を表示する。
+// 時間は揺らぐので、比べるときは何度か実行して最小値を見ること。
+// 誤差が許容値を超えたら終了コード1。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc tools/pose2_check/pose2_check.cpp -o pose2_check
+//
+// ### usage
+// ./pose2_check
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "units/units.hpp"
+#include "system/odometry/PoseHistory.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float TOLERANCE = 2e-6f; // 1m, 1rad程度の値に対する許容誤差
+
+    volatile float sink;
+
+    struct Reference
+    {
+        double x;
+        double y;
+        double theta;
+    };
+
+    Reference toReference(Position position)
+    {
+        return {position.x.value, position.y.value, position.theta.value};
+    }
+
+    Reference compose(Reference a, Reference b)
+    {
+        return {a.x + b.x * std::cos(a.theta) - b.y * std::sin(a.theta),
+                a.y + b.x * std::sin(a.theta) + b.y * std::cos(a.theta),
+                a.theta + b.theta};
+    }
+
+    Reference exp(Reference twist)
+    {
+        double theta = twist.theta;
+        double a = std::fabs(theta) < 1e-9 ? 1.0 : std::sin(theta) / theta;
+        double b = std::fabs(theta) < 1e-9 ? theta / 2.0 : (1.0 - std::cos(theta)) / theta;
+        return {a * twist.x - b * twist.y, b * twist.x + a * twist.y, theta};
+    }
+
+    double error(Position value, Reference reference)
+    {
+        return std::fmax(std::fmax(std::fabs(value.x.value - reference.x), std::fabs(value.y.value - reference.y)),
+                         std::fabs(value.theta.value - reference.theta));
+    }
+
+    bool report(const char *name, double max_error, double tolerance)
+    {
+        bool ok = max_error <= tolerance;
+        printf("%-32s max error %9.3g  tolerance %9.3g  %s\n", name, max_error, tolerance, ok ? "ok" : "NG");
+        return ok;
+    }
+
+    // 以前のオドメトリの1ステップ (中点の向きで回す)
+    Position previousOdometryStep(Position position, float delta_x, float delta_y, float delta_theta)
+    {
+        float theta = position.theta.value;
+        float delta_x_abs = delta_x * std::cos(theta + delta_theta / 2) - delta_y * std::sin(theta + delta_theta / 2);
+        float delta_y_abs = delta_x * std::sin(theta + delta_theta / 2) + delta_y * std::cos(theta + delta_theta / 2);
+        position.x += Meter(delta_x_abs);
+        position.y += Meter(delta_y_abs);
+        position.theta += Radian(delta_theta);
+        return position;
+    }
+
+    // 以前のPoseHistory::interpolate (三角関数を5回呼ぶ)
+    Position previousInterpolate(Position a, Position b, float ratio)
+    {
+        float cos_a = std::cos(a.theta.value);
+        float sin_a = std::sin(a.theta.value);
+        float dx = (b.x - a.x).value;
+        float dy = (b.y - a.y).value;
+        float relative_x = cos_a * dx + sin_a * dy;
+        float relative_y = -sin_a * dx + cos_a * dy;
+        float relative_theta = normalizeAngle(b.theta - a.theta).value;
+
+        float half_theta = relative_theta / 2.0f;
+        float v_scale = std::fabs(relative_theta) < 1e-3f ? 1.0f - relative_theta * relative_theta / 12.0f : half_theta * std::cos(half_theta) / std::sin(half_theta);
+        float twist_x = v_scale * relative_x + half_theta * relative_y;
+        float twist_y = -half_theta * relative_x + v_scale * relative_y;
+
+        float theta = relative_theta * ratio;
+        float sin_over_theta = std::fabs(theta) < 1e-3f ? 1.0f - theta * theta / 6.0f : std::sin(theta) / theta;
+        float one_minus_cos_over_theta = std::fabs(theta) < 1e-3f ? theta / 2.0f : (1.0f - std::cos(theta)) / theta;
+        float step_x = (sin_over_theta * twist_x - one_minus_cos_over_theta * twist_y) * ratio;
+        float step_y = (one_minus_cos_over_theta * twist_x + sin_over_theta * twist_y) * ratio;
+
+        return Position(a.x + Meter(cos_a * step_x - sin_a * step_y), a.y + Meter(sin_a * step_x + cos_a * step_y), a.theta + Radian(theta));
+    }
+
+    template <typename Function>
+    double measure(int count, Function function)
+    {
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < count; i++)
+        {
+            function(i);
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        return elapsed.count() / count;
+    }
+}
+
+int main()
+{
+    constexpr int SAMPLES = 10000;
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distance(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> angle(-3.1f, 3.1f);
+    auto randomPosition = [&]
+    { return Position(Meter(distance(random)), Meter(distance(random)), Radian(angle(random))); };
+
+    bool ok = true;
+
+    // 合成・逆・点の変換
+    double compose_error = 0.0, inverse_error = 0.0, point_error = 0.0, rotate_error = 0.0;
+    for (int i = 0; i < SAMPLES; i++)
+    {
+        Position a = randomPosition();
+        Position b = randomPosition();
+        Pose2 pose_a(a);
+        Pose2 pose_b(b);
+
+        compose_error = std::fmax(compose_error, error(pose_a.compose(pose_b).getPosition(), compose(toReference(a), toReference(b))));
+        inverse_error = std::fmax(inverse_error, error(pose_a.compose(pose_a.inverse()).getPosition(), {0.0, 0.0, 0.0}));
+        point_error = std::fmax(point_error, error(pose_a.transformPoint(b), toReference(pose_a.compose(pose_b).getPosition())));
+        rotate_error = std::fmax(rotate_error, error(pose_a.inverseRotate(pose_a.rotate(b)), toReference(b)));
+    }
+    ok &= report("compose", compose_error, TOLERANCE * 4);
+    ok &= report("compose(inverse)", inverse_error, TOLERANCE * 4);
+    ok &= report("transformPoint", point_error, TOLERANCE);
+    ok &= report("inverseRotate(rotate)", rotate_error, TOLERANCE);
+
+    // exp/log (級数との境目(0.25rad)付近の角度も含む)
+    const float angles[] = {0.0f, 1e-6f, 1e-4f, 1e-3f, 1e-2f, 0.1f, 0.2499f, 0.25f, 0.2501f, 0.3f, 1.5f, 3.0f, 3.14f};
+    double exp_error = 0.0, log_error = 0.0;
+    for (int i = 0; i < SAMPLES; i++)
+    {
+        float theta = angles[i % (sizeof(angles) / sizeof(angles[0]))] * (i % 2 == 0 ? 1.0f : -1.0f);
+        Position twist(Meter(distance(random)), Meter(distance(random)), Radian(theta));
+
+        Pose2 pose = Pose2::exp(twist);
+        exp_error = std::fmax(exp_error, error(pose.getPosition(), exp(toReference(twist))));
+        log_error = std::fmax(log_error, error(pose.log(), toReference(twist)));
+        log_error = std::fmax(log_error, error(Pose2::log(pose.getPosition()), toReference(twist)));
+    }
+    ok &= report("exp", exp_error, TOLERANCE);
+    ok &= report("log(exp)", log_error, TOLERANCE * 4);
+
+    // 補間の両端と、以前の補間との差
+    double end_error = 0.0, previous_difference = 0.0;
+    for (int i = 0; i < SAMPLES; i++)
+    {
+        Position a = randomPosition();
+        Position b = Pose2(a).compose(Pose2::exp(Position(Meter(distance(random) * 0.01f), Meter(distance(random) * 0.01f), Radian(angle(random) * 0.01f)))).getPosition();
+        end_error = std::fmax(end_error, error(PoseHistory<Clock::time_point, 2>::interpolate(a, b, 0.0f), toReference(a)));
+        end_error = std::fmax(end_error, error(PoseHistory<Clock::time_point, 2>::interpolate(a, b, 1.0f), toReference(b)));
+        float ratio = (i % 100) / 100.0f;
+        previous_difference = std::fmax(previous_difference, error(PoseHistory<Clock::time_point, 2>::interpolate(a, b, ratio), toReference(previousInterpolate(a, b, ratio))));
+    }
+    ok &= report("interpolate ends", end_error, TOLERANCE);
+    ok &= report("interpolate vs previous", previous_difference, TOLERANCE);
+
+    // オドメトリと同じく1ステップずつ合成し続けたとき、キャッシュしたcos, sinが真の向きからずれないか
+    // (10分間, 5ms周期, 1.5m/s, 3rad/sで回り続ける)
+    // 参考に、floatのthetaを足し続けた値(以前のオドメトリと同じ)の誤差も表示する。
+    Pose2 pose;
+    Position step(Meter(1.5f * 0.005f), 0_m, Radian(3.0f * 0.005f));
+    Pose2 step_pose = Pose2::exp(step);
+    double drift = 0.0, theta_drift = 0.0;
+    for (int i = 0; i < 120000; i++)
+    {
+        pose = pose.compose(step_pose);
+        double theta = (i + 1) * (double)step.theta.value;
+        drift = std::fmax(drift, std::fmax(std::fabs(pose.getCos() - std::cos(theta)), std::fabs(pose.getSin() - std::sin(theta))));
+        theta_drift = std::fmax(theta_drift, std::fabs(pose.getPosition().theta.value - theta));
+    }
+    ok &= report("cached cos/sin drift (120k steps)", drift, 1e-3);
+    printf("%-32s max error %9.3g\n", "  (float theta sum, reference)", theta_drift);
+
+    // 時間 (オドメトリの1ステップ, 姿勢の補間)
+    // 補間は、PoseHistoryの隣り合う履歴(1ステップ離れた姿勢)の間と、無関係な2つの姿勢の間(回転角が大きい)の両方を測る。
+    std::vector<Position> steps(1024), positions(1024), neighbors(1024);
+    for (int i = 0; i < 1024; i++)
+    {
+        steps[i] = Position(Meter(distance(random) * 0.01f), Meter(distance(random) * 0.01f), Radian(angle(random) * 0.01f));
+        positions[i] = randomPosition();
+        neighbors[i] = Pose2(positions[i]).compose(Pose2::exp(steps[i])).getPosition();
+    }
+    constexpr int COUNT = 2000000;
+    Pose2 odometry;
+    double pose2_step = measure(COUNT, [&](int i)
+                                { odometry = odometry.compose(Pose2::exp(steps[i & 1023])); });
+    sink = odometry.getPosition().x.value;
+    Position previous = odometry.getPosition();
+    double previous_step = measure(COUNT, [&](int i)
+                                   { const Position &s = steps[i & 1023]; previous = previousOdometryStep(previous, s.x.value, s.y.value, s.theta.value); });
+    sink = previous.x.value;
+    printf("%-32s Pose2 %6.2f ns  previous %6.2f ns\n", "odometry step", pose2_step, previous_step);
+
+    Position interpolated;
+    double pose2_neighbor = measure(COUNT, [&](int i)
+                                    { interpolated = PoseHistory<Clock::time_point, 2>::interpolate(positions[i & 1023], neighbors[i & 1023], 0.3f); sink = interpolated.x.value; });
+    double previous_neighbor = measure(COUNT, [&](int i)
+                                       { interpolated = previousInterpolate(positions[i & 1023], neighbors[i & 1023], 0.3f); sink = interpolated.x.value; });
+    printf("%-32s Pose2 %6.2f ns  previous %6.2f ns\n", "interpolate (neighbors)", pose2_neighbor, previous_neighbor);
+
+    double pose2_interpolate = measure(COUNT, [&](int i)
+                                       { interpolated = PoseHistory<Clock::time_point, 2>::interpolate(positions[i & 1023], positions[(i + 1) & 1023], 0.3f); sink = interpolated.x.value; });
+    double previous_interpolate = measure(COUNT, [&](int i)
+                                          { interpolated = previousInterpolate(positions[i & 1023], positions[(i + 1) & 1023], 0.3f); sink = interpolated.x.value; });
+    printf("%-32s Pose2 %6.2f ns  previous %6.2f ns\n", "interpolate (random pairs)", pose2_interpolate, previous_interpolate);
+
+    return ok ? 0 : 1;
+}
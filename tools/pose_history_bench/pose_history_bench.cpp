@@ -0,0 +1,90 @@
+// PoseHistory::findの問い合わせコストを測るホスト用ツール。
+// 一定の並進速度・角速度(円弧)で動いた履歴を作り、ランダムな時刻を問い合わせる。
+// 円弧の上ではSE(2)補間が厳密なので、補間誤差も合わせて表示する。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc tools/pose_history_bench/pose_history_bench.cpp -o pose_history_bench
+//
+// ### usage
+// ./pose_history_bench [queries]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "system/odometry/PoseHistory.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = std::chrono::time_point<Clock, std::chrono::microseconds>;
+
+    constexpr int HISTORY_SIZE = 64;
+    constexpr std::chrono::microseconds PERIOD(5000); // オドメトリの更新周期
+    constexpr float SPEED = 1.5f;                     // 並進速度[m/s] (ロボット座標系のx方向)
+    constexpr float ANGULAR_SPEED = 3.0f;             // 角速度[rad/s]
+
+    // 時刻tの円弧上の姿勢
+    Position poseAt(float t)
+    {
+        float theta = ANGULAR_SPEED * t;
+        float radius = SPEED / ANGULAR_SPEED;
+        return Position(Meter(radius * std::sin(theta)), Meter(radius * (1.0f - std::cos(theta))), Radian(theta));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int queries = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    PoseHistory<TimePoint, HISTORY_SIZE> history;
+    TimePoint origin(std::chrono::microseconds(0));
+    for (int i = 0; i < HISTORY_SIZE * 3; i++)
+    {
+        TimePoint timestamp = origin + PERIOD * i;
+        history.push(timestamp, poseAt(std::chrono::duration<float>(timestamp - origin).count()));
+    }
+
+    TimePoint newest = origin + PERIOD * (HISTORY_SIZE * 3 - 1);
+    TimePoint oldest = newest - PERIOD * (HISTORY_SIZE - 1);
+    std::mt19937 random(1);
+    std::uniform_int_distribution<long long> distribution(oldest.time_since_epoch().count(), newest.time_since_epoch().count());
+
+    std::vector<TimePoint> timestamps(queries);
+    for (TimePoint &timestamp : timestamps)
+    {
+        timestamp = TimePoint(std::chrono::microseconds(distribution(random)));
+    }
+
+    float max_error = 0.0f;
+    float checksum = 0.0f;
+    int found = 0;
+
+    Clock::time_point start = Clock::now();
+    for (const TimePoint &timestamp : timestamps)
+    {
+        Position position;
+        if (history.find(timestamp, position))
+        {
+            found++;
+            checksum += position.x.value;
+        }
+    }
+    Clock::time_point end = Clock::now();
+
+    for (int i = 0; i < queries && i < 10000; i++)
+    {
+        Position position;
+        history.find(timestamps[i], position);
+        Position expected = poseAt(std::chrono::duration<float>(timestamps[i] - origin).count());
+        max_error = std::fmax(max_error, std::hypot((position.x - expected.x).value, (position.y - expected.y).value));
+    }
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / queries;
+    printf("history: %d poses, queries: %d, found: %d\n", history.size(), queries, found);
+    printf("find: %.1f ns/query\n", nanoseconds);
+    printf("max interpolation error on arc: %.3g m (checksum %.3f)\n", max_error, checksum);
+
+    return 0;
+}
@@ -0,0 +1,381 @@
+// 足回りの閉ループのシミュレーションで、位置制御の到達時間を比べるホスト用ツール。
+// 実機と同じWheelController<3> (位置のPID、DutyController、MotorGroup、DCMotor)とWheelOdometry<5>を200Hzで回し、
+// 機体は次のモデルで動かす。
+// - モーター: 車輪の回転数が duty比 * MAX_WHEEL_RPS に時定数MOTOR_TIME_CONSTANTで近づく (1次遅れ)
+// - 機体: 駆動輪3輪の回転数から機体速度を求め、PHYSICS_STEPごとに積分する (滑りなし)
+// - エンコーダー: odometry_replay --generateと同じく、機体の移動を各車輪の回転に直してEncoder::addCountで与える
+// オドメトリの推定で制御し、到達の判定は真値で行う。
+//
+// 到達時間: 真値が目標からPOSITION_TOLERANCEとHEADING_TOLERANCEの中に入り、シミュレーションの終わりまで出なかった時刻。
+// 比較する制御:
+//   field: 以前の実装。フィールド座標系のPIDの出力をそのまま機体速度として車輪に配る (updateMotorsに向き0を渡すのと同じ)
+//   body:  今の実装。PIDの出力を現在の向きでロボット座標系に回してから配る
+//
+// 経由点のある経路 (trajectory_planner/courses/section1.txtなど) の到達時間も比べる。
+//   point-to-point: 経由点を順に位置制御の目標にする。途中の点は推定位置が許容範囲に入った時点で次の点に切り替える
+//                   (PositionControllerのsettle_timeは待たないので、point-to-pointに有利な比べ方)
+//   PurePursuit:    PositionController::followPathと同じく、PurePursuitで終端付近まで追従し、
+//                   PIDをrestartしてから終端を目標とした位置制御に引き継ぐ
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/position_sim/position_sim.cpp -o position_sim
+//
+// ### usage
+// ./position_sim
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include "WheelSettings.hpp"
+#include "system/PathFollower.hpp"
+#include "system/WheelController.hpp"
+#include "system/odometry/WheelOdometry.hpp"
+
+// WheelControllerの内部の処理を呼ぶ (WheelControllerのfriend)
+// 実機では車輪ごとのTickerとスレッドで回る回転数の計測を、制御周期ごとに呼ぶ。
+template <int N>
+struct WheelControllerAccess
+{
+    static void updateCurrentRps(WheelController<N> &wheel_controller)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            wheel_controller.duty_controllers[i]->updateCurrentRps();
+        }
+    }
+};
+
+namespace
+{
+    constexpr int FREQUENCY = 200;                                   // 制御周期 [Hz]
+    constexpr std::chrono::microseconds CONTROL_PERIOD(1000000 / FREQUENCY);
+    constexpr std::chrono::microseconds PHYSICS_STEP(1000);          // 機体の積分の刻み
+    constexpr int ENCODER_RESOLUTION = 2048;
+    constexpr float MAX_WHEEL_RPS = 10.0f;                           // duty比1での車輪の回転数 (車輪の周速で約1.9m/s)
+    constexpr float MOTOR_TIME_CONSTANT = 0.04f;                     // [s]
+    constexpr MeterPerSecond MAX_SPEED = MeterPerSecond(8.0f);       // WheelControllerのmax_speed (車輪の回転数[rps]と比べている)
+    constexpr double POSITION_TOLERANCE = 0.01;                      // [m]
+    constexpr double HEADING_TOLERANCE = 1.0 * M_PI / 180.0;         // [rad]
+    constexpr double SIMULATION_TIME = 10.0;                         // [s]
+    constexpr Meter LOOKAHEAD = Meter(0.2f);                         // PurePursuitの先読み距離
+    constexpr float CRUISE_SPEEDS[] = {1.0f, 1.4f};                  // 比べるPurePursuitの巡航速度 [m/s] (位置のPIDが飽和すると車輪は8rps、周速約1.5m/s)
+    constexpr MeterPerSecondSquared PATH_ACCELERATION = MeterPerSecondSquared(2.0f);
+    constexpr float HEADING_GAIN = 4.0f;                             // PurePursuitの角度のゲイン [1/s]
+
+    PIDGain motor_gain = {2.0f, 0.0f, 0.0f, FREQUENCY};
+    PIDGain position_gain = {4.0f, 0.0f, 0.0f, FREQUENCY};
+
+    // 計測輪 (main.cppのmeasuring_wheelsと同じ順。先頭3つは駆動輪)
+    constexpr std::array<WheelPositions, 5> WHEEL_POSITIONS = {
+        WheelSettings::front,
+        WheelSettings::rear_left,
+        WheelSettings::rear_right,
+        WheelSettings::measuring_x,
+        WheelSettings::measuring_y,
+    };
+
+    // シミュレーションの時刻 (ロボットを作り直しても戻さない。DCMotorなどが時刻の差を使うため)
+    HighResClock::time_point now{};
+
+    // 真値の姿勢と車輪の状態
+    struct Plant
+    {
+        double x = 0.0;
+        double y = 0.0;
+        double theta = 0.0;
+        std::array<double, 3> wheel_rps = {};  // 駆動輪の回転数
+        std::array<double, 5> rotations = {};  // 各計測輪の累積回転数
+        std::array<long, 5> counts = {};       // エンコーダーに与えたカウント
+        double path_length = 0.0;              // 走行距離 [m]
+    };
+
+    // 実機と同じ構成の足回りとオドメトリ (ホストではスレッドもTickerも動かない)
+    struct Robot
+    {
+        Encoder encoders[5] = {{NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}};
+        DCMotor motors[3] = {{NC, NC}, {NC, NC}, {NC, NC}};
+        array<MotorWheel, 3> motor_wheels;
+        array<MeasuringWheel, 5> measuring_wheels;
+        WheelController<3> wheel_controller;
+        WheelOdometry<5> odometry;
+        Plant plant;
+
+        Robot()
+            : motor_wheels{
+                  MotorWheel{{WHEEL_POSITIONS[0], encoders[0]}, motors[0], motor_gain},
+                  MotorWheel{{WHEEL_POSITIONS[1], encoders[1]}, motors[1], motor_gain},
+                  MotorWheel{{WHEEL_POSITIONS[2], encoders[2]}, motors[2], motor_gain},
+              },
+              measuring_wheels{
+                  motor_wheels[0].measuring_wheel,
+                  motor_wheels[1].measuring_wheel,
+                  motor_wheels[2].measuring_wheel,
+                  MeasuringWheel{WHEEL_POSITIONS[3], encoders[3]},
+                  MeasuringWheel{WHEEL_POSITIONS[4], encoders[4]},
+              },
+              wheel_controller(motor_wheels, position_gain, MAX_SPEED),
+              odometry(measuring_wheels)
+        {
+            // 駆動輪の回転数 -> 機体速度 (車輪のベクトルを並べた3x3行列の逆行列)
+            Eigen::Matrix3d wheel_matrix;
+            for (int i = 0; i < 3; i++)
+            {
+                WheelVector wheel_vector = getWheelVector(WHEEL_POSITIONS[i]);
+                wheel_matrix.row(i) << wheel_vector.x, wheel_vector.y, wheel_vector.theta;
+            }
+            body_from_wheels = wheel_matrix.inverse();
+        }
+
+        Position getTruth() const
+        {
+            return Position(Meter((float)plant.x), Meter((float)plant.y), Radian((float)plant.theta));
+        }
+
+        // 制御周期の始め: オドメトリと車輪の回転数の計測を更新する
+        Position sense()
+        {
+            odometry.updatePosition();
+            WheelControllerAccess<3>::updateCurrentRps(wheel_controller);
+            return odometry.getCurrentPosition();
+        }
+
+        // 出力中のduty比で機体を1制御周期だけ動かす
+        void advance()
+        {
+            const double step = std::chrono::duration<double>(PHYSICS_STEP).count();
+            for (auto time = PHYSICS_STEP; time <= CONTROL_PERIOD; time += PHYSICS_STEP)
+            {
+                Eigen::Vector3d wheel_rps;
+                for (int i = 0; i < 3; i++)
+                {
+                    double target_rps = motors[i].getAppliedDuty() * MAX_WHEEL_RPS;
+                    plant.wheel_rps[i] += (target_rps - plant.wheel_rps[i]) * (step / MOTOR_TIME_CONSTANT);
+                    wheel_rps(i) = plant.wheel_rps[i];
+                }
+                Eigen::Vector3d body = body_from_wheels * wheel_rps; // ロボット座標系の (vx, vy, ω)
+
+                // 各計測輪の回転
+                for (int i = 0; i < 5; i++)
+                {
+                    WheelVector wheel_vector = getWheelVector(WHEEL_POSITIONS[i]);
+                    plant.rotations[i] += (wheel_vector.x * body(0) + wheel_vector.y * body(1) + wheel_vector.theta * body(2)) * step;
+                    long count = std::lround(plant.rotations[i] * ENCODER_RESOLUTION);
+                    encoders[i].addCount((int)(count - plant.counts[i]));
+                    plant.counts[i] = count;
+                }
+
+                // 刻みの中点の向きでフィールド座標系に直して積分する
+                double theta = plant.theta + body(2) * step / 2.0;
+                plant.x += (std::cos(theta) * body(0) - std::sin(theta) * body(1)) * step;
+                plant.y += (std::sin(theta) * body(0) + std::cos(theta) * body(1)) * step;
+                plant.theta += body(2) * step;
+                plant.path_length += std::hypot(body(0), body(1)) * step;
+
+                now += PHYSICS_STEP;
+                HighResClock::setNow(now);
+            }
+        }
+
+    private:
+        Eigen::Matrix3d body_from_wheels;
+    };
+
+    // 到達の判定 (真値が許容範囲に入り、最後まで出なかった時刻)
+    class SettleTracker
+    {
+    public:
+        void update(double time, Position truth, Position target)
+        {
+            double distance = std::hypot(truth.x.value - target.x.value, truth.y.value - target.y.value);
+            double heading = std::fabs(normalizeAngle(truth.theta - target.theta).value);
+            bool inside = distance <= POSITION_TOLERANCE && heading <= HEADING_TOLERANCE;
+            if (inside && !was_inside)
+            {
+                enter_time = time;
+            }
+            was_inside = inside;
+        }
+
+        bool isSettled() const { return was_inside; }
+        double getTime() const { return enter_time; }
+
+    private:
+        bool was_inside = false;
+        double enter_time = 0.0;
+    };
+
+    struct Result
+    {
+        bool reached;
+        double time;        // 到達時間 [s]
+        double path_length; // 走行距離 [m]
+    };
+
+    // 原点から目標まで位置制御で動かす
+    // rotate_to_body: PIDの出力をロボット座標系に回すか (falseなら以前の実装)
+    Result runToTarget(Position target, bool rotate_to_body)
+    {
+        std::unique_ptr<Robot> robot = std::make_unique<Robot>();
+        SettleTracker tracker;
+
+        int steps = (int)(SIMULATION_TIME * FREQUENCY);
+        for (int k = 0; k < steps; k++)
+        {
+            Position current_position = robot->sense();
+
+            Position error = target - current_position;
+            error.theta = normalizeAngle(error.theta);
+            robot->wheel_controller.updateMotors(error, rotate_to_body ? current_position.theta : 0_rad);
+
+            robot->advance();
+            tracker.update((k + 1) / (double)FREQUENCY, robot->getTruth(), target);
+        }
+
+        return Result{tracker.isSettled(), tracker.getTime(), robot->plant.path_length};
+    }
+
+    // 原点から経由点をたどって終端まで動かす (waypoints[0]は原点)
+    // pure_pursuit: PurePursuitで追従するか (falseなら経由点を順に位置制御の目標にする)
+    // cruise_speed: PurePursuitの巡航速度 [m/s]
+    template <size_t K>
+    Result runPath(const std::array<Position, K> &waypoints, bool pure_pursuit, float cruise_speed = 0.0f)
+    {
+        std::unique_ptr<Robot> robot = std::make_unique<Robot>();
+        PurePursuit<K> follower(waypoints, LOOKAHEAD, MeterPerSecond(cruise_speed), PATH_ACCELERATION, HEADING_GAIN);
+        SettleTracker tracker;
+        bool is_following_path = pure_pursuit;
+        int next = 1; // point-to-pointで目標にしている経由点
+
+        int steps = (int)(SIMULATION_TIME * FREQUENCY);
+        for (int k = 0; k < steps; k++)
+        {
+            Position current_position = robot->sense();
+
+            if (is_following_path && !follower.isFinished())
+            {
+                robot->wheel_controller.updateMotors(follower.calculate(current_position), current_position.theta);
+            }
+            else
+            {
+                if (is_following_path)
+                {
+                    // PositionController::updatePositionと同じく、経路追従から切り替えるときにPIDをやり直す
+                    robot->wheel_controller.restartPid();
+                    is_following_path = false;
+                }
+
+                Position target = pure_pursuit ? waypoints[K - 1] : waypoints[next];
+                Position error = target - current_position;
+                error.theta = normalizeAngle(error.theta);
+                if (!pure_pursuit && next < K - 1 &&
+                    hypot(error.x.value, error.y.value) <= POSITION_TOLERANCE && fabs(error.theta.value) <= HEADING_TOLERANCE)
+                {
+                    next++;
+                }
+                robot->wheel_controller.updateMotors(error, current_position.theta);
+            }
+
+            robot->advance();
+            tracker.update((k + 1) / (double)FREQUENCY, robot->getTruth(), waypoints[K - 1]);
+        }
+
+        return Result{tracker.isSettled(), tracker.getTime(), robot->plant.path_length};
+    }
+
+    void printResult(const Result &result)
+    {
+        if (result.reached)
+        {
+            printf(" %7.3fs %6.2fm", result.time, result.path_length);
+        }
+        else
+        {
+            printf(" %8s %6.2fm", "never", result.path_length);
+        }
+    }
+
+    Position target(float x, float y, float theta_deg)
+    {
+        return Position(Meter(x), Meter(y), Radian(Degree(theta_deg)));
+    }
+}
+
+int main()
+{
+    const Position targets[] = {
+        target(1.0f, 0.0f, 0.0f),
+        target(0.0f, 1.0f, 0.0f),
+        target(1.0f, 0.0f, 45.0f),
+        target(1.0f, 1.0f, 90.0f),
+        target(0.0f, 1.5f, -90.0f),
+        target(2.0f, 0.5f, 135.0f),
+        target(-1.0f, 1.0f, 180.0f),
+        target(0.3f, 0.0f, 30.0f),
+    };
+
+    printf("time to target (within %.0f mm, %.0f deg) and path length, %d Hz control, simulated %.0f s\n",
+           POSITION_TOLERANCE * 1000.0, HEADING_TOLERANCE * 180.0 / M_PI, FREQUENCY, SIMULATION_TIME);
+    printf("%-22s %16s %16s %8s\n", "target (x, y, theta)", "field (before)", "body (after)", "saved");
+
+    double total_before = 0.0;
+    double total_after = 0.0;
+    int never_before = 0;
+    int never_after = 0;
+    for (const Position &target : targets)
+    {
+        Result before = runToTarget(target, false);
+        Result after = runToTarget(target, true);
+
+        char label[32];
+        snprintf(label, sizeof(label), "%.1f, %.1f, %4.0f deg", target.x.value, target.y.value, Degree(target.theta).value);
+        printf("%-22s", label);
+        printResult(before);
+        printResult(after);
+        if (before.reached && after.reached)
+        {
+            printf(" %7.1f%%", (before.time - after.time) / before.time * 100.0);
+            total_before += before.time;
+            total_after += after.time;
+        }
+        printf("\n");
+
+        never_before += !before.reached;
+        never_after += !after.reached;
+    }
+
+    printf("\nreached by both: total %.3fs -> %.3fs (%.1f%% less)\n", total_before, total_after, (total_before - total_after) / total_before * 100.0);
+    printf("not reached in %.0f s: before %d, after %d\n", SIMULATION_TIME, never_before, never_after);
+
+    // 経路 (trajectory_planner/courses/section1.txtと、その場で回転する経由点を含む経路)
+    const std::array<Position, 4> section1_course = {target(0.0f, 0.0f, 0.0f), target(2.0f, 0.0f, 0.0f), target(2.0f, 1.0f, 45.0f), target(4.0f, 1.0f, 90.0f)};
+    const std::array<Position, 4> turn_course = {target(0.0f, 0.0f, 0.0f), target(1.0f, 0.0f, 0.0f), target(1.0f, 0.0f, 90.0f), target(1.0f, 1.5f, 90.0f)};
+
+    printf("\npath time (PurePursuit lookahead %.2f m)\n", LOOKAHEAD.value);
+    printf("%-22s %16s %16s %8s\n", "course", "point-to-point", "PurePursuit", "saved");
+    bool path_reached = true;
+    auto printPath = [&](const char *name, const auto &course)
+    {
+        Result point_to_point = runPath(course, false);
+        for (float cruise_speed : CRUISE_SPEEDS)
+        {
+            Result pure_pursuit = runPath(course, true, cruise_speed);
+
+            char label[32];
+            snprintf(label, sizeof(label), "%s, %.1f m/s", name, cruise_speed);
+            printf("%-22s", label);
+            printResult(point_to_point);
+            printResult(pure_pursuit);
+            if (point_to_point.reached && pure_pursuit.reached)
+            {
+                printf(" %7.1f%%", (point_to_point.time - pure_pursuit.time) / point_to_point.time * 100.0);
+            }
+            printf("\n");
+            path_reached &= pure_pursuit.reached;
+        }
+    };
+    printPath("section1", section1_course);
+    printPath("turn in place", turn_course);
+
+    return never_after == 0 && path_reached ? 0 : 1;
+}
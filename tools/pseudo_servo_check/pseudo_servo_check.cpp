@@ -0,0 +1,206 @@
+// PseudoServoの台形プロファイルと原点復帰を、FakePwmBackendのモーターと模擬したエンコーダー・リミットスイッチで確かめるホスト用ツール。
+// 制御周期(200Hz)ごとにupdateを呼び、その間はモーターを次のモデルで1msずつ動かす。
+// - モーター: 軸の角速度が 出力中のduty比 * MAX_MOTOR_SPEED に時定数MOTOR_TIME_CONSTANTで近づく (1次遅れ)
+// - エンコーダー: 軸の角度をカウントに直してEncoder::addCountで与える
+// - リミットスイッチ: 軸の角度がSWITCH_ANGLE以下の間は押されている (DigitalIn::setLevelで与える)
+// 次を確かめる。
+// - 原点復帰: リミットスイッチに当たって原点が決まり、homing_timeoutより前に完了するか
+// - プロファイル: 目標角度を何度か変え、プロファイルの角速度がmax_velocity以下、角加速度がmax_acceleration以下か
+//                 (動いている途中で変えた直後も含む)。出力中のduty比がmax_duty以下で、最後の目標に到達して保持できるか
+// - タイムアウト: リミットスイッチが押されないとき、homing_timeoutの後にFaultになってモーターが止まり、それより前はならないか
+// 1つでも満たさなければ終了コード1。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/pseudo_servo_check/pseudo_servo_check.cpp -o pseudo_servo_check
+//
+// ### usage
+// ./pseudo_servo_check
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "driver/pwm/FakePwmBackend.hpp"
+#include "driver/DCMotor.hpp"
+#include "system/PseudoServo.hpp"
+
+using Motor = DCMotorT<FakePwmBackend>;
+
+// PseudoServoの台形プロファイルの状態を読む (PseudoServoTのfriend)
+template <typename Motor>
+struct PseudoServoAccess
+{
+    static float getReferenceVelocity(const PseudoServoT<Motor> &servo)
+    {
+        return servo.reference_velocity;
+    }
+};
+
+namespace
+{
+    constexpr int FREQUENCY = 200;
+    constexpr std::chrono::microseconds CONTROL_PERIOD(1000000 / FREQUENCY);
+    constexpr std::chrono::microseconds PHYSICS_STEP(1000);
+    constexpr int ENCODER_RESOLUTION = 2048;
+    constexpr double MAX_MOTOR_SPEED = 30.0;     // duty比1での軸の角速度 [rad/s]
+    constexpr double MOTOR_TIME_CONSTANT = 0.03; // [s]
+    constexpr double SWITCH_ANGLE = -1.0;        // リミットスイッチが押される軸の角度 [rad] (開始位置は0)
+    constexpr float TOLERANCE = 1e-4f;           // 制限の比較の許容誤差 (floatの丸め)
+
+    const PseudoServoConfig CONFIG = {
+        {10.0f, 0.0f, 0.0f, FREQUENCY},  // 位置ループ
+        {0.05f, 2.0f, 0.0f, FREQUENCY},  // 速度ループ
+        RadPerSecond(8.0f),              // max_velocity
+        40.0f,                           // max_acceleration
+        0.8f,                            // max_duty
+        -0.3f,                           // homing_duty (負の向きにリミットスイッチ)
+        0_rad,                           // home_angle
+        Radian(0.02f),                   // tolerance
+        std::chrono::milliseconds(2000), // homing_timeout
+    };
+
+    // シミュレーションの時刻 (確認ごとに作り直しても戻さない。DCMotorやTimerが時刻の差を使うため)
+    HighResClock::time_point now = HighResClock::now();
+
+    struct Rig
+    {
+        Motor motor{NC, NC};
+        Encoder encoder{NC, NC, ENCODER_RESOLUTION};
+        LimitSwitch limit_switch{NC};
+        PseudoServoT<Motor> servo{motor, encoder, limit_switch, CONFIG};
+
+        double angle = 0.0;        // 軸の角度 (真値)
+        double speed = 0.0;        // 軸の角速度
+        double rotations_sent = 0; // エンコーダーに与えた回転数
+        bool switch_works = true;  // falseならリミットスイッチが断線している
+
+        Rig()
+        {
+            DigitalIn::setLevel(NC, 0);
+        }
+
+        // 1制御周期だけ動かしてからupdateを呼ぶ
+        void step()
+        {
+            const double dt = std::chrono::duration<double>(PHYSICS_STEP).count();
+            for (auto time = PHYSICS_STEP; time <= CONTROL_PERIOD; time += PHYSICS_STEP)
+            {
+                double target_speed = motor.getAppliedDuty() * MAX_MOTOR_SPEED;
+                speed += (target_speed - speed) * (dt / MOTOR_TIME_CONSTANT);
+                angle += speed * dt;
+
+                double rotations = angle / (2.0 * M_PI);
+                int count = (int)std::lround((rotations - rotations_sent) * ENCODER_RESOLUTION);
+                encoder.addCount(count);
+                rotations_sent += (double)count / ENCODER_RESOLUTION;
+
+                DigitalIn::setLevel(NC, switch_works && angle <= SWITCH_ANGLE);
+
+                now += PHYSICS_STEP;
+                HighResClock::setNow(now);
+            }
+
+            servo.update();
+        }
+    };
+
+    bool checkHomingAndProfile()
+    {
+        Rig rig;
+        rig.servo.home();
+
+        int steps = 0;
+        int timeout_steps = (int)(CONFIG.homing_timeout / CONTROL_PERIOD);
+        while (!rig.servo.isHomed() && !rig.servo.isFault() && steps < timeout_steps * 2)
+        {
+            rig.step();
+            steps++;
+        }
+        bool homed = rig.servo.isHomed() && steps < timeout_steps;
+        printf("homing: %s after %.3f s (timeout %.3f s)\n", homed ? "done" : "FAILED",
+               steps / (double)FREQUENCY, timeout_steps / (double)FREQUENCY);
+
+        // 原点で止まるまで待つ
+        for (int k = 0; k < FREQUENCY / 2; k++)
+        {
+            rig.step();
+        }
+
+        const Radian targets[] = {Radian(3.0f), Radian(-1.0f), Radian(0.5f), Radian(0.45f), Radian(4.0f)};
+        const float dt = 1.0f / FREQUENCY;
+        float max_velocity = 0.0f;
+        float max_acceleration = 0.0f;
+        float max_duty = 0.0f;
+
+        for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++)
+        {
+            rig.servo.setTarget(targets[i]);
+
+            // 最後以外は途中で次の目標に切り替える (動いている間の変更も確かめる)
+            bool is_last = i + 1 == sizeof(targets) / sizeof(targets[0]);
+            int steps_limit = is_last ? 3 * FREQUENCY : FREQUENCY / 4;
+            float last_velocity = PseudoServoAccess<Motor>::getReferenceVelocity(rig.servo);
+            for (int k = 0; k < steps_limit && !(is_last && rig.servo.isReached()); k++)
+            {
+                rig.step();
+
+                float velocity = PseudoServoAccess<Motor>::getReferenceVelocity(rig.servo);
+                max_velocity = std::fmax(max_velocity, std::fabs(velocity));
+                max_acceleration = std::fmax(max_acceleration, std::fabs(velocity - last_velocity) / dt);
+                max_duty = std::fmax(max_duty, std::fabs(rig.motor.getAppliedDuty()));
+                last_velocity = velocity;
+            }
+        }
+
+        // 到達した後も保持できているか
+        for (int k = 0; k < FREQUENCY; k++)
+        {
+            rig.step();
+        }
+
+        bool velocity_ok = max_velocity <= CONFIG.max_velocity.value * (1.0f + TOLERANCE);
+        bool acceleration_ok = max_acceleration <= CONFIG.max_acceleration * (1.0f + TOLERANCE);
+        bool duty_ok = max_duty <= CONFIG.max_duty + TOLERANCE;
+        bool reached_ok = rig.servo.isReached() && std::fabs((rig.servo.getAngle() - targets[4]).value) <= CONFIG.tolerance.value;
+
+        printf("profile: max velocity %.3f rad/s (limit %.3f) %s\n", max_velocity, CONFIG.max_velocity.value, velocity_ok ? "ok" : "FAILED");
+        printf("         max acceleration %.3f rad/s^2 (limit %.3f) %s\n", max_acceleration, CONFIG.max_acceleration, acceleration_ok ? "ok" : "FAILED");
+        printf("         max duty %.3f (limit %.3f) %s\n", max_duty, CONFIG.max_duty, duty_ok ? "ok" : "FAILED");
+        printf("         final target %.3f rad, angle %.4f rad 1 s after reaching %s\n", targets[4].value, rig.servo.getAngle().value, reached_ok ? "ok" : "FAILED");
+
+        return homed && velocity_ok && acceleration_ok && duty_ok && reached_ok;
+    }
+
+    bool checkHomingTimeout()
+    {
+        Rig rig;
+        rig.switch_works = false;
+        rig.servo.home();
+
+        int timeout_steps = (int)(CONFIG.homing_timeout / CONTROL_PERIOD);
+        bool early_fault = false;
+        for (int k = 0; k < timeout_steps - 1; k++)
+        {
+            rig.step();
+            early_fault |= rig.servo.isFault();
+        }
+        for (int k = 0; k < 2; k++)
+        {
+            rig.step();
+        }
+
+        bool fault = rig.servo.isFault();
+        bool stopped = rig.motor.getAppliedDuty() == 0.0f;
+        bool ok = !early_fault && fault && stopped;
+        printf("homing timeout: %s (fault before timeout %s, motor %s)\n", ok ? "ok" : "FAILED",
+               early_fault ? "yes" : "no", stopped ? "stopped" : "still driven");
+
+        return ok;
+    }
+}
+
+int main()
+{
+    bool ok = checkHomingAndProfile();
+    ok &= checkHomingTimeout();
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,303 @@
+// 制御周期ごとに呼ばれる処理をRealTimeSectionの中で回し、制御周期の中でヒープを使っていないかを調べるホスト用ツール。
+// 制御器の構築は区間の外、calculateなどの周期処理は区間の中で行う (実機の制御スレッドと同じ)。
+// mbedに依存する足回り・オドメトリ・PseudoServo・セクションはtools/hostの置き換えで動かし、時刻はHighResClock::setNowで進める。
+// 最初にフックが効いているか(operator newとEigenの動的確保を検出できるか)を確かめる。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -DREALTIME_SECTION_HOST -rdynamic -static-libstdc++ -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc -Isrc -Itools/host -Ilib/Eigen/include
+//     tools/realtime_check/realtime_check.cpp src/system/RealTimeSection.cpp -o realtime_check
+//
+// ### usage
+// ./realtime_check         各制御器の区間内での確保回数を表示する。確保があれば終了コード1。
+// ./realtime_check --trap  最初の確保でバックトレースを表示して停止する (どこで確保したかを調べるとき)
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <Dense.h>
+#include "system/RealTimeSection.hpp"
+#include "system/PIDController.hpp"
+#include "system/GainScheduledPIDController.hpp"
+#include "system/PathFollower.hpp"
+#include "system/MpcController.hpp"
+#include "system/WheelController.hpp"
+#include "system/DutyController.hpp"
+#include "system/PseudoServo.hpp"
+#include "system/TrajectoryPlayer.hpp"
+#include "system/odometry/WheelOdometry.hpp"
+#include "system/odometry/ImuWheelOdometry.hpp"
+#include "control/SectionController.hpp"
+#include "control/behavior/BehaviorTree.hpp"
+#include "WheelSettings.hpp"
+
+namespace
+{
+    constexpr int CYCLES = 1000;
+    constexpr int FREQUENCY = 200;
+    constexpr std::chrono::microseconds CONTROL_PERIOD(1000000 / FREQUENCY);
+    constexpr int ENCODER_RESOLUTION = 2048;
+
+    constexpr GainSchedule<3> position_schedule = {{
+        {0.00f, 2.0f, 0.5f, 0.0f},
+        {0.10f, 1.0f, 0.0f, 0.0f},
+        {1.00f, 0.5f, 0.0f, 0.0f},
+    }};
+
+    volatile float sink;
+
+    // シミュレーションの時刻 (戻さない)
+    HighResClock::time_point now{};
+
+    // 1制御周期だけ時刻を進める (区間の中で呼んでよい)
+    void advanceTime()
+    {
+        now += CONTROL_PERIOD;
+        HighResClock::setNow(now);
+    }
+
+    PIDGain motor_gain = {2.0f, 0.0f, 0.0f, FREQUENCY};
+    PIDGain position_gain = {4.0f, 0.0f, 0.0f, FREQUENCY};
+
+    const PseudoServoConfig servo_config = {
+        {10.0f, 0.0f, 0.0f, FREQUENCY},
+        {0.05f, 2.0f, 0.0f, FREQUENCY},
+        RadPerSecond(8.0f),
+        40.0f,
+        0.8f,
+        -0.3f,
+        0_rad,
+        Radian(0.02f),
+        std::chrono::milliseconds(2000),
+    };
+
+    constexpr TrajectoryPoint trajectory[] = {
+        {0.0f, {0_m, 0_m, 0_rad}, {MeterPerSecond(0.0f), MeterPerSecond(0.0f), RadPerSecond(0.0f)}},
+        {1.0f, {Meter(0.5f), 0_m, 0_rad}, {MeterPerSecond(1.0f), MeterPerSecond(0.0f), RadPerSecond(0.0f)}},
+        {2.0f, {Meter(1.5f), Meter(0.5f), Radian(1.0f)}, {MeterPerSecond(0.0f), MeterPerSecond(0.0f), RadPerSecond(0.0f)}},
+    };
+
+    // 実機と同じ構成の駆動輪3輪と計測輪2輪 (main.cppのmeasuring_wheelsと同じ順。先頭3つは駆動輪)
+    struct Rig
+    {
+        Encoder encoders[5] = {{NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}, {NC, NC, ENCODER_RESOLUTION}};
+        DCMotor motors[3] = {{NC, NC}, {NC, NC}, {NC, NC}};
+        array<MotorWheel, 3> motor_wheels = {
+            MotorWheel{{WheelSettings::front, encoders[0]}, motors[0], motor_gain},
+            MotorWheel{{WheelSettings::rear_left, encoders[1]}, motors[1], motor_gain},
+            MotorWheel{{WheelSettings::rear_right, encoders[2]}, motors[2], motor_gain},
+        };
+        array<MeasuringWheel, 5> measuring_wheels = {
+            motor_wheels[0].measuring_wheel,
+            motor_wheels[1].measuring_wheel,
+            motor_wheels[2].measuring_wheel,
+            MeasuringWheel{WheelSettings::measuring_x, encoders[3]},
+            MeasuringWheel{WheelSettings::measuring_y, encoders[4]},
+        };
+
+        // 車輪ごとに違う量だけエンコーダーを進める
+        void turn(int i)
+        {
+            for (int k = 0; k < 5; k++)
+            {
+                encoders[k].addCount((i % 7) * (k + 1) - 3);
+            }
+        }
+    };
+
+    // functionを区間の中でCYCLES回呼び、区間の中で確保した回数を表示する
+    template <typename Function>
+    bool check(const char *name, Function function)
+    {
+        int before = RealTimeSection::getViolationCount();
+        for (int i = 0; i < CYCLES; i++)
+        {
+            RealTimeSection section;
+            function(i);
+        }
+        int allocations = RealTimeSection::getViolationCount() - before;
+
+        printf("%-28s %s (%d allocations in %d cycles)\n", name, allocations == 0 ? "ok" : "ALLOCATES", allocations, CYCLES);
+        return allocations == 0;
+    }
+
+    // 区間の外の確保は数えず、中の確保は数えることを確かめる
+    bool checkHooks()
+    {
+        // 最適化でnew/deleteの組を消されないようにvolatileに入れる
+        int before = RealTimeSection::getViolationCount();
+        int *volatile outside = new int(0);
+        delete outside;
+        {
+            RealTimeSection section;
+            int *volatile inside = new int(0);
+            delete inside;
+
+            Eigen::MatrixXf dynamic(4, 4);
+            dynamic.setZero();
+            sink = dynamic.sum();
+        }
+        int detected = RealTimeSection::getViolationCount() - before;
+
+        printf("%-28s %s (detected %d of 2)\n", "hooks", detected == 2 ? "ok" : "BROKEN", detected);
+        return detected == 2;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool trap = argc > 1 && strcmp(argv[1], "--trap") == 0;
+    RealTimeSection::setTrap(trap);
+
+    bool ok = trap || checkHooks();
+
+    PIDController<Position> position_pid(1.0f, 0.1f, 0.01f, 200);
+    ok &= check("PIDController<Position>", [&](int i)
+                {
+                    Position output = position_pid.calculate(Position(Meter(1.0f / (i + 1)), 0_m, 0_rad));
+                    sink = output.x.value;
+                });
+
+    GainScheduledPIDController<float, 3> scheduled_pid(position_schedule, 200);
+    ok &= check("GainScheduledPIDController", [&](int i)
+                {
+                    float error = 1.0f / (i + 1);
+                    sink = scheduled_pid.calculate(error, error);
+                });
+
+    std::array<Position, 3> waypoints = {{{0_m, 0_m, 0_rad}, {1_m, 0_m, 0_rad}, {1_m, 1_m, 1.57_rad}}};
+    PurePursuit<3> pure_pursuit(waypoints, 0.2_m, 1_m_s, MeterPerSecondSquared(2.0f), 2.0f);
+    ok &= check("PurePursuit", [&](int i)
+                {
+                    Velocity velocity = pure_pursuit.calculate(Position(Meter(i * 0.002f), 0_m, 0_rad));
+                    sink = velocity.x.value;
+                });
+
+    // 実機と同じくヒープに構築する (区間の外)
+    std::array<WheelPositions, 3> wheel_positions = {WheelSettings::front, WheelSettings::rear_left, WheelSettings::rear_right};
+    auto mpc = std::make_unique<MpcController<3>>(wheel_positions, 3.0f, std::chrono::milliseconds(5), MpcWeight{1.0f, 0.5f, 0.01f});
+    ok &= check("MpcController<3>", [&](int i)
+                {
+                    std::array<float, 3> duty = mpc->calculateDuty(Position(Meter(1.0f / (i + 1)), 0.1_m, 0.2_rad), 0_rad);
+                    sink = duty[0];
+                });
+
+    // 車輪の回転数 -> 機体速度 (IOdometryの疑似逆行列と同じ大きさの固定長の積)
+    Eigen::Matrix<float, 3, 5> wheel_matrix_inv = Eigen::Matrix<float, 3, 5>::Random();
+    ok &= check("odometry 3x5 * 5", [&](int i)
+                {
+                    Eigen::Matrix<float, 5, 1> wheel_speeds = Eigen::Matrix<float, 5, 1>::Constant(i * 0.01f);
+                    Eigen::Vector3f velocity = wheel_matrix_inv * wheel_speeds;
+                    sink = velocity(0);
+                });
+
+    Rig wheels;
+    WheelOdometry<5> wheel_odometry(wheels.measuring_wheels);
+    ok &= check("WheelOdometry<5>", [&](int i)
+                {
+                    advanceTime();
+                    wheels.turn(i);
+                    wheel_odometry.updatePosition();
+                    sink = wheel_odometry.getCurrentPosition().x.value;
+                });
+
+    Imu imu(NC, NC);
+    ImuWheelOdometry<5> imu_odometry(wheels.measuring_wheels, imu);
+    ok &= check("ImuWheelOdometry<5>", [&](int i)
+                {
+                    advanceTime();
+                    wheels.turn(i);
+                    imu.setYaw(i * 0.5f);
+                    imu_odometry.updatePosition();
+                    sink = imu_odometry.getCurrentPosition().theta.value;
+                });
+
+    // 車輪ごとのDutyControllerの構築は区間の外 (コンストラクタでmake_uniqueする)
+    WheelController<3> wheel_controller(wheels.motor_wheels, position_gain, MeterPerSecond(8.0f), 1.0f, &position_schedule);
+    ok &= check("WheelController (position)", [&](int i)
+                {
+                    advanceTime();
+                    wheel_controller.updateMotors(Position(Meter(1.0f / (i + 1)), 0.1_m, 0.2_rad), Radian(0.001f * i));
+                });
+    ok &= check("WheelController (velocity)", [&](int i)
+                {
+                    advanceTime();
+                    wheel_controller.updateMotors(Velocity{MeterPerSecond(0.5f), MeterPerSecond(0.001f * i), RadPerSecond(0.1f)}, Radian(0.001f * i));
+                });
+    ok &= check("WheelController (duty)", [&](int i)
+                {
+                    advanceTime();
+                    wheel_controller.updateMotors(array<float, 3>{0.001f * i, -0.5f, 0.2f});
+                });
+
+    DutyController duty_controller(wheels.encoders[0], motor_gain);
+    duty_controller.setTargetRps(2.0f);
+    ok &= check("DutyController", [&](int i)
+                {
+                    wheels.turn(i);
+                    duty_controller.updateCurrentRps();
+                    sink = duty_controller.calculateDuty();
+                });
+
+    // 原点復帰はリミットスイッチが押されたままにして最初のupdateで終わらせ、あとは目標を変えながら追従させる
+    DCMotor servo_motor(NC, NC);
+    LimitSwitch limit_switch(NC);
+    PseudoServo servo(servo_motor, wheels.encoders[3], limit_switch, servo_config);
+    DigitalIn::setLevel(NC, 1);
+    servo.home();
+    ok &= check("PseudoServo", [&](int i)
+                {
+                    advanceTime();
+                    if (i % 200 == 100)
+                    {
+                        servo.setTarget(Radian((i / 200) % 2 == 0 ? 2.0f : -1.0f));
+                    }
+                    wheels.turn(i);
+                    servo.update();
+                    sink = servo.getAngle().value;
+                });
+    DigitalIn::setLevel(NC, 0);
+
+    TrajectoryPlayer trajectory_player(trajectory, 2.0f, 2.0f);
+    ok &= check("TrajectoryPlayer", [&](int i)
+                {
+                    advanceTime();
+                    if (trajectory_player.isFinished())
+                    {
+                        trajectory_player.reset();
+                    }
+                    Velocity velocity = trajectory_player.calculate(Position(Meter(i * 0.001f), 0_m, 0_rad));
+                    sink = velocity.x.value;
+                });
+
+    // 条件を確かめて動作を3回繰り返す木を、タイムアウト付きで1つのセクションとして回す (終わったら最初から)
+    int actions = 0;
+    ConditionNode ready([&]
+                        { return actions >= 0; });
+    ActionNode action([&]
+                      { return ++actions % 4 == 0 ? NodeStatus::Success : NodeStatus::Running; });
+    SequenceNode<2> sequence({&ready, &action});
+    RepeatNode repeat(&sequence, 3);
+    TimeoutNode timeout(&repeat, std::chrono::seconds(1));
+    BehaviorTreeSection tree_section(&timeout);
+    ok &= check("BehaviorTree::tick", [&](int)
+                {
+                    advanceTime();
+                    if (timeout.tick() != NodeStatus::Running)
+                    {
+                        timeout.reset();
+                    }
+                });
+
+    SectionController<1> section_controller({&tree_section});
+    section_controller.start();
+    ok &= check("SectionController", [&](int)
+                {
+                    advanceTime();
+                    section_controller.update();
+                    if (!section_controller.isRunning())
+                    {
+                        section_controller.start();
+                    }
+                });
+
+    return ok ? 0 : 1;
+}
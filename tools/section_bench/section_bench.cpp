@@ -0,0 +1,220 @@
+// SectionControllerの反応遅れとRAM使用量を、スレッドでポーリングしていた以前の実装と比べるホスト用ツール。
+//
+// 反応遅れ: ランダムな時刻に割り込み(EventFlags)を立て、気付くまでの時間をホストの実時間(steady_clock)で測る。
+//           2つのstd::threadを同時に動かし、同じ割り込みを両方に立てる。
+//           - 以前の実装: SectionControllerの専用スレッドで、フラグを確認してはThisThread::sleep_for(10ms)する
+//           - 今の実装:   制御周期ごとにSectionController::updateを呼び、AwaitFlagsで待つセクションが気付く
+//           ホストのスケジューラーの遅れ(数十us程度)も含む。割り込みの代わりのスレッドとはstd::mutexで排他する
+//           (tools/hostのEventFlagsはスレッドを考えていないため)。
+// RAM: 以前の実装はSectionControllerごとにThreadを1つ持っていた。Threadはstartでスタックをヒープに確保し、
+//      オブジェクトの中にRTXのスレッド制御ブロック(osRtxThread_t)などを持つ。
+//      スタックはmbed-os 6のrtos.thread-stack-size (mbed_app.jsonで変えていないので既定の4096B)、
+//      Threadオブジェクトはmbed-os 6のメンバーの合計からの見積もり。実機での値はtools/target_benchで表示する。
+//      今の実装はPositionControllerの制御スレッドの上で動くので、増えるのはオブジェクトの大きさだけ。
+// updateのホストでの実行時間も表示する (実機ではない)。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -pthread -Isrc -Itools/host -Ilib/Eigen/include tools/section_bench/section_bench.cpp -o section_bench
+//
+// ### usage
+// ./section_bench [--period MS] [--events N]
+//   --period  制御周期[ms] (既定5ms)
+//   --events  割り込みの回数 (既定200。1回あたり20-40msかかる)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "control/SectionController.hpp"
+#include "control/Await.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::chrono::microseconds POLLING_PERIOD = 10ms; // 以前のセクションのsleep_for
+    constexpr int THREAD_STACK_SIZE = 4096;                    // mbed-os 6のrtos.thread-stack-sizeの既定値[B] (mbed_app.jsonで変えていない)
+    // mbed-os 6のrtos::Threadの大きさの見積もり[B] (Cortex-M4)
+    // osRtxThread_t 68 + osThreadAttr_t 36 + Semaphore 20 + Mutex 36 + Callback 16 + スレッドID・フラグ 8
+    constexpr int THREAD_OBJECT_SIZE = 184;
+    constexpr std::chrono::microseconds DEFAULT_PERIOD = 5ms;
+    constexpr int DEFAULT_EVENTS = 200;
+
+    std::mutex interrupt_mutex; // 割り込みの代わりのスレッドとの排他
+
+    // 割り込みのフラグを待ち、気付いた時刻を記録して次のフラグを待つセクション
+    class WaitFlagSection : public ISection
+    {
+    public:
+        WaitFlagSection(EventFlags &event_flags) : await_flags(event_flags, 1) {}
+
+        SectionStatus update() override
+        {
+            if (await_flags.isSet())
+            {
+                reactions.push_back(Clock::now());
+            }
+            return SectionStatus::Running;
+        }
+
+        std::vector<Clock::time_point> reactions;
+
+    private:
+        AwaitFlags await_flags;
+    };
+
+    struct Summary
+    {
+        double mean;
+        double p99;
+        double max;
+    };
+
+    Summary summarize(std::vector<double> latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0.0;
+        for (double latency : latencies)
+        {
+            sum += latency;
+        }
+        return Summary{sum / latencies.size(), latencies[(size_t)(latencies.size() * 0.99)], latencies.back()};
+    }
+
+    std::vector<double> getLatencies(const std::vector<Clock::time_point> &events, const std::vector<Clock::time_point> &reactions)
+    {
+        std::vector<double> latencies;
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            latencies.push_back(std::chrono::duration<double, std::milli>(reactions[i] - events[i]).count());
+        }
+        return latencies;
+    }
+
+    void usage()
+    {
+        fprintf(stderr, "usage: section_bench [--period MS] [--events N]\n");
+        exit(2);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::chrono::microseconds period = DEFAULT_PERIOD;
+    int events = DEFAULT_EVENTS;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc)
+        {
+            usage();
+        }
+        if (strcmp(argv[i], "--period") == 0)
+        {
+            period = std::chrono::microseconds((long)(atof(argv[++i]) * 1000.0));
+        }
+        else if (strcmp(argv[i], "--events") == 0)
+        {
+            events = std::max(1, atoi(argv[++i]));
+        }
+        else
+        {
+            usage();
+        }
+    }
+
+    EventFlags tick_flags;
+    WaitFlagSection section(tick_flags);
+    SectionController<1> section_controller({&section});
+    section_controller.start();
+
+    EventFlags polling_flags;
+    std::vector<Clock::time_point> polling_reactions;
+
+    std::atomic<bool> is_running(true);
+    double update_ns = 0.0;
+    long updates = 0;
+
+    // 今の実装: 制御周期ごとにupdateを呼ぶ
+    std::thread control_thread([&]
+                               {
+                                   Clock::time_point next = Clock::now();
+                                   while (is_running)
+                                   {
+                                       next += period;
+                                       std::this_thread::sleep_until(next);
+
+                                       std::lock_guard<std::mutex> lock(interrupt_mutex);
+                                       Clock::time_point start = Clock::now();
+                                       section_controller.update();
+                                       update_ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                                       updates++;
+                                   } });
+
+    // 以前の実装: 専用スレッドで確認してはsleep_forする
+    std::thread polling_thread([&]
+                               {
+                                   while (is_running)
+                                   {
+                                       {
+                                           std::lock_guard<std::mutex> lock(interrupt_mutex);
+                                           if (polling_flags.get() & 1)
+                                           {
+                                               polling_flags.clear(1);
+                                               polling_reactions.push_back(Clock::now());
+                                           }
+                                       }
+                                       std::this_thread::sleep_for(POLLING_PERIOD);
+                                   } });
+
+    // 割り込み (次の割り込みまでに必ず気付けるよう、以前の確認周期と制御周期の長い方より間隔を空ける)
+    std::mt19937 random(1);
+    std::chrono::microseconds spacing = std::max(period, POLLING_PERIOD) * 2;
+    std::uniform_int_distribution<long> jitter(0, spacing.count() - 1);
+    std::vector<Clock::time_point> event_times;
+    Clock::time_point time = Clock::now();
+    for (int i = 0; i < events; i++)
+    {
+        time += spacing + std::chrono::microseconds(jitter(random));
+        std::this_thread::sleep_until(time);
+
+        std::lock_guard<std::mutex> lock(interrupt_mutex);
+        tick_flags.set(1);
+        polling_flags.set(1);
+        event_times.push_back(Clock::now());
+    }
+    std::this_thread::sleep_for(spacing);
+    is_running = false;
+    control_thread.join();
+    polling_thread.join();
+
+    if (section.reactions.size() != event_times.size() || polling_reactions.size() != event_times.size())
+    {
+        fprintf(stderr, "missed events: %zu events, %zu tick reactions, %zu polling reactions\n",
+                event_times.size(), section.reactions.size(), polling_reactions.size());
+        return 1;
+    }
+
+    Summary tick_summary = summarize(getLatencies(event_times, section.reactions));
+    Summary polling_summary = summarize(getLatencies(event_times, polling_reactions));
+
+    printf("reaction latency (%d events, measured on host threads)\n", events);
+    printf("%-36s %8s %8s %8s\n", "", "mean", "p99", "max");
+    printf("%-36s %6.2fms %6.2fms %6.2fms\n", "thread, sleep_for(10ms) polling", polling_summary.mean, polling_summary.p99, polling_summary.max);
+    char label[64];
+    snprintf(label, sizeof(label), "control tick (%.1fms)", std::chrono::duration<double, std::milli>(period).count());
+    printf("%-36s %6.2fms %6.2fms %6.2fms\n", label, tick_summary.mean, tick_summary.p99, tick_summary.max);
+
+    printf("\nRAM per SectionController\n");
+    printf("%-36s %5d B (stack %d B + rtos::Thread about %d B, estimated)\n", "thread (before)",
+           THREAD_STACK_SIZE + THREAD_OBJECT_SIZE, THREAD_STACK_SIZE, THREAD_OBJECT_SIZE);
+    printf("%-36s %5zu B (sizeof(SectionController<1>) on host, without the rtos Mutex)\n", "control tick", sizeof(SectionController<1>));
+
+    printf("\nSectionController::update on host: %.1f ns\n", update_ns / updates);
+
+    return 0;
+}
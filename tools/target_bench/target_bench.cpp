@@ -0,0 +1,154 @@
+// 実機(NUCLEO-F446RE)で制御周期ごとに通る処理のサイクル数を測るベンチマーク。
+// DWTのサイクルカウンター(CYCCNT)で1回ずつ測り、最小・最大のサイクル数と時間をシリアルに表示する。
+// 割り込みの影響を除くため、測る間はクリティカルセクションに入る。
+//
+// mpc/solve: MpcController<3>::calculateDuty (反復30回)。偏差を変えながら測り、最大値を5msの制御周期と比べる。
+//            MpcController::getSolveFlopsの演算回数から、1演算あたりのサイクル数も表示する。
+// pwm/*: Stm32PwmBackendとMbedPwmBackendの1回の書き込み(write, writePulseWidth)のサイクル数を比べる。
+//        どちらも制御周期ごとにモーター1台につき1回呼ばれる。モーターのつながっていないMBED_PWM_PIN, STM32_PWM_PINに出力する
+//        (PA_5はNUCLEOのLED。STM32のターゲットでだけ測る)。
+// section/ram: 以前のSectionControllerが持っていたThreadの大きさとスタックを、今のSectionControllerの大きさと比べる
+//              (tools/section_benchの見積もりの確認用)。
+//
+// ### build
+// platformio.iniのnucleo_f446re_bench環境 (src/main.cppの代わりにこのファイルをリンクする)
+// pio run -e nucleo_f446re_bench -t upload
+//
+// ### usage
+// pio device monitor -b 9600
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mbed.hpp>
+#include "cmsis.h"
+#include "WheelSettings.hpp"
+#include "driver/pwm/MbedPwmBackend.hpp"
+#include "driver/pwm/Stm32PwmBackend.hpp"
+#include "system/MpcController.hpp"
+#include "control/SectionController.hpp"
+
+namespace
+{
+    constexpr int SAMPLES = 200;
+    constexpr std::chrono::microseconds CONTROL_PERIOD = 5ms;
+
+    // DWTのサイクルカウンター
+    void startCycleCounter()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    struct CycleStats
+    {
+        uint32_t min = UINT32_MAX;
+        uint32_t max = 0;
+
+        void add(uint32_t cycles)
+        {
+            min = std::min(min, cycles);
+            max = std::max(max, cycles);
+        }
+    };
+
+    // functionをSAMPLES回呼び、1回ずつのサイクル数を集計する (引数はサンプルの番号)
+    template <typename Function>
+    CycleStats measure(Function function)
+    {
+        CycleStats stats;
+        for (int i = 0; i < SAMPLES; i++)
+        {
+            CriticalSectionLock lock;
+            uint32_t start = DWT->CYCCNT;
+            function(i);
+            stats.add(DWT->CYCCNT - start);
+        }
+
+        return stats;
+    }
+
+    float toMicroseconds(uint32_t cycles)
+    {
+        return cycles * 1e6f / SystemCoreClock;
+    }
+
+    void print(const char *name, CycleStats stats)
+    {
+        printf("%-24s min %8" PRIu32 " cycles (%8.1f us), max %8" PRIu32 " cycles (%8.1f us)\n",
+               name, stats.min, toMicroseconds(stats.min), stats.max, toMicroseconds(stats.max));
+    }
+
+    volatile float sink; // 結果を捨てさせない
+
+    void benchMpc()
+    {
+        constexpr int ITERATIONS = 30;
+        std::unique_ptr<MpcController<3>> mpc = std::make_unique<MpcController<3>>(WheelSettings::drive_wheels, 3.0f, CONTROL_PERIOD, MpcWeight{1.0f, 0.5f, 0.01f}, 0.8f, ITERATIONS);
+
+        // 偏差は制約に掛からない小さいものから、全輪が飽和する大きいものまで変える
+        CycleStats stats = measure([&](int i)
+                                   {
+                                       float scale = (i % 20) * 0.1f;
+                                       Position error(Meter(scale), Meter(-0.5f * scale), Radian(0.3f * scale));
+                                       std::array<float, 3> duty = mpc->calculateDuty(error, Radian(0.01f * i));
+                                       sink = duty[0]; });
+        print("mpc/solve", stats);
+
+        constexpr long flops = MpcController<3>::getSolveFlops(ITERATIONS);
+        uint32_t period_cycles = (uint32_t)(SystemCoreClock / 1000000 * CONTROL_PERIOD.count());
+        printf("  %ld flops, %.2f cycles/flop (max), %.1f%% of %d us control period\n",
+               flops, (float)stats.max / flops, 100.0f * stats.max / period_cycles, (int)CONTROL_PERIOD.count());
+    }
+
+#ifdef TARGET_STM
+    constexpr PinName MBED_PWM_PIN = PA_5;  // TIM2_CH1 (LED)
+    constexpr PinName STM32_PWM_PIN = PB_3; // TIM2_CH2 (SWO。このベンチでは使わない)
+    constexpr std::chrono::microseconds PWM_PERIOD(62); // DCMotorの既定の16kHz
+
+    // Backend::writeとwritePulseWidthを測る。dutyは毎回変えて、同じ値の書き込みを省かれないようにする
+    template <typename Backend>
+    void benchPwmBackend(PinName pin, const char *write_name, const char *pulse_width_name)
+    {
+        Backend backend(pin, PWM_PERIOD);
+
+        print(write_name, measure([&](int i)
+                                  { backend.write((i % 100) * 0.01f); }));
+        print(pulse_width_name, measure([&](int i)
+                                        { backend.writePulseWidth(std::chrono::microseconds(i % 60)); }));
+        backend.write(0.0f);
+    }
+
+    void benchPwm()
+    {
+        benchPwmBackend<MbedPwmBackend>(MBED_PWM_PIN, "pwm/mbed_write", "pwm/mbed_pulse_width");
+        benchPwmBackend<Stm32PwmBackend>(STM32_PWM_PIN, "pwm/stm32_write", "pwm/stm32_pulse_width");
+    }
+#endif
+
+    void printSectionRam()
+    {
+        Thread thread; // startしないのでスタックは確保されない。stack_sizeはstartで確保する大きさ
+        printf("section/ram              Thread %u B + stack %" PRIu32 " B, SectionController<1> %u B\n",
+               (unsigned)sizeof(Thread), thread.stack_size(), (unsigned)sizeof(SectionController<1>));
+    }
+}
+
+int main()
+{
+    startCycleCounter();
+    printf("target_bench: SystemCoreClock %" PRIu32 " Hz, %d samples\n", SystemCoreClock, SAMPLES);
+
+    benchMpc();
+#ifdef TARGET_STM
+    benchPwm();
+#endif
+    printSectionRam();
+
+    while (true)
+    {
+        ThisThread::sleep_for(1s);
+    }
+}
@@ -0,0 +1,340 @@
+// 競技コースの経由点から加速度制限付きの時間最適軌道を計算し、
+// TrajectoryPlayerで再生するconstexprの軌道表(ヘッダ)を出力するホスト用ツール。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc tools/trajectory_planner/trajectory_planner.cpp -o trajectory_planner
+//
+// ### usage
+// ./trajectory_planner tools/trajectory_planner/courses/section1.txt section1_trajectory > src/control/trajectories/section1_trajectory.hpp
+//
+// コースファイルは1行に1つの経由点 "x[m] y[m] theta[deg]"。#以降はコメント。
+// 直前と同じ経由点(長さ0の区間)は読み飛ばす。
+//
+// 経路は経由点を結ぶ折れ線で、並進と回転を同時に線形補間する。
+// 各点での速度上限は、WheelSettings::drive_wheelsの全駆動輪の回転数が max_wheel_rps * max_duty を超えない最大速度。
+// そこから前進・後退の2パスで加速度制限を課すと、その経路上での時間最適な速度分布になる。
+// 経由点で向きが変わる場合は、1サンプル間で速度ベクトルを切り替えられる速度まで落とす。
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "WheelSettings.hpp"
+#include "system/WheelVector.hpp"
+
+namespace
+{
+    constexpr float DEFAULT_MAX_WHEEL_RPS = 3.0f;  // duty比1での駆動輪の回転数[rps]
+    constexpr float DEFAULT_MAX_DUTY = 0.8f;       // 計画に使うduty比の上限 (残りはフィードバック用)
+    constexpr float DEFAULT_MAX_ACCELERATION = 2.0f; // 経路に沿った加速度の上限[m/s^2]
+    constexpr float DEFAULT_PERIOD = 0.05f;        // 出力する軌道表の時間間隔[s]
+    constexpr float SAMPLE_LENGTH = 0.005f;        // 速度計画のサンプル間隔[m]
+    constexpr float MIN_SEGMENT_LENGTH = 1e-4f;    // これより短い区間は直前の経由点と同じとみなす[m]
+
+    constexpr int DRIVE_WHEELS = WheelSettings::drive_wheels.size();
+
+    // 回転を経路長に換算するときの半径。駆動輪の配置半径を使う。
+    const float ROTATION_RADIUS = WheelSettings::TREAD_RAD.value;
+
+    struct Waypoint
+    {
+        float x;
+        float y;
+        float theta;
+    };
+
+    // 経路長sあたりの変化量 (dx/ds, dy/ds, dtheta/ds)
+    struct Direction
+    {
+        float x;
+        float y;
+        float theta;
+    };
+
+    struct Sample
+    {
+        float s;     // 経路長
+        float x;
+        float y;
+        float theta;
+        int segment; // 属する区間
+        float v_max; // 速度上限
+        float v;     // 計画した速度
+        float t;     // 到達時刻
+    };
+
+    struct Options
+    {
+        float max_wheel_rps = DEFAULT_MAX_WHEEL_RPS;
+        float max_duty = DEFAULT_MAX_DUTY;
+        float max_acceleration = DEFAULT_MAX_ACCELERATION;
+        float period = DEFAULT_PERIOD;
+    };
+
+    float segmentLength(const Waypoint &from, const Waypoint &to)
+    {
+        float linear = std::hypot(to.x - from.x, to.y - from.y);
+        float angular = std::fabs(to.theta - from.theta) * ROTATION_RADIUS;
+        return std::max(linear, angular);
+    }
+
+    std::vector<Waypoint> readCourse(const char *path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            fprintf(stderr, "cannot open %s\n", path);
+            exit(1);
+        }
+
+        std::vector<Waypoint> waypoints;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream stream(line);
+            float x, y, theta_deg;
+            if (!(stream >> x >> y >> theta_deg))
+            {
+                continue;
+            }
+
+            // 長さ0の区間は進行方向が決まらない(0で割ってNaNになる)ので、同じ経由点は1つにまとめる
+            Waypoint waypoint = {x, y, theta_deg * (float)M_PI / 180.0f};
+            if (!waypoints.empty() && segmentLength(waypoints.back(), waypoint) < MIN_SEGMENT_LENGTH)
+            {
+                fprintf(stderr, "%s: skipping duplicate waypoint (%g, %g, %g)\n", path, x, y, theta_deg);
+                continue;
+            }
+            waypoints.push_back(waypoint);
+        }
+
+        if (waypoints.size() < 2)
+        {
+            fprintf(stderr, "%s must have at least 2 distinct waypoints\n", path);
+            exit(1);
+        }
+
+        return waypoints;
+    }
+
+    // readCourseで長さ0の区間は取り除いてあるので、lengthは0にならない
+    Direction segmentDirection(const Waypoint &from, const Waypoint &to)
+    {
+        float length = segmentLength(from, to);
+        return Direction{
+            (to.x - from.x) / length,
+            (to.y - from.y) / length,
+            (to.theta - from.theta) / length,
+        };
+    }
+
+    // 向きthetaで方向directionに進むとき、駆動輪の回転数制限を満たす最大速度
+    float wheelSpeedLimit(const std::array<WheelVector, DRIVE_WHEELS> &wheel_vectors, Direction direction, float theta, float max_rps)
+    {
+        // フィールド座標系の進行方向をロボット座標系に変換
+        float body_x = direction.x * std::cos(theta) + direction.y * std::sin(theta);
+        float body_y = -direction.x * std::sin(theta) + direction.y * std::cos(theta);
+
+        float max_ratio = 0.0f;
+        for (const WheelVector &wheel_vector : wheel_vectors)
+        {
+            float ratio = wheel_vector.x * body_x + wheel_vector.y * body_y + wheel_vector.theta * direction.theta;
+            max_ratio = std::max(max_ratio, std::fabs(ratio));
+        }
+
+        return max_rps / max_ratio;
+    }
+
+    std::vector<Sample> planVelocity(const std::vector<Waypoint> &waypoints, const Options &options)
+    {
+        std::array<WheelVector, DRIVE_WHEELS> wheel_vectors;
+        for (int i = 0; i < DRIVE_WHEELS; i++)
+        {
+            wheel_vectors[i] = getWheelVector(WheelSettings::drive_wheels[i]);
+        }
+        const float max_rps = options.max_wheel_rps * options.max_duty;
+
+        // 経路をサンプリング
+        std::vector<Sample> samples;
+        float s = 0.0f;
+        for (size_t i = 0; i + 1 < waypoints.size(); i++)
+        {
+            const Waypoint &from = waypoints[i];
+            const Waypoint &to = waypoints[i + 1];
+            float length = segmentLength(from, to);
+            Direction direction = segmentDirection(from, to);
+            int steps = std::max(1, (int)std::ceil(length / SAMPLE_LENGTH));
+
+            // 経由点(前の区間の最後のサンプル)はこの区間の制限も受ける
+            if (i > 0)
+            {
+                samples.back().v_max = std::min(samples.back().v_max, wheelSpeedLimit(wheel_vectors, direction, from.theta, max_rps));
+            }
+
+            for (int k = (i == 0 ? 0 : 1); k <= steps; k++)
+            {
+                float ratio = (float)k / steps;
+                float theta = from.theta + (to.theta - from.theta) * ratio;
+                float v_max = wheelSpeedLimit(wheel_vectors, direction, theta, max_rps);
+
+                samples.push_back({s + length * ratio, from.x + (to.x - from.x) * ratio, from.y + (to.y - from.y) * ratio, theta, (int)i, v_max, 0.0f, 0.0f});
+            }
+
+            s += length;
+        }
+
+        // 経由点での方向転換
+        // 速度ベクトルの変化量 v * |Δdirection| を1サンプル(SAMPLE_LENGTH / v)の間に加速度上限内で変化させる
+        for (size_t i = 1; i + 1 < waypoints.size(); i++)
+        {
+            Direction before = segmentDirection(waypoints[i - 1], waypoints[i]);
+            Direction after = segmentDirection(waypoints[i], waypoints[i + 1]);
+            float change = std::hypot(after.x - before.x, after.y - before.y) + std::fabs(after.theta - before.theta) * ROTATION_RADIUS;
+            if (change <= 0.0f)
+            {
+                continue;
+            }
+
+            float v_corner = std::sqrt(options.max_acceleration * SAMPLE_LENGTH / change);
+            // 区間iの最初のサンプルの1つ前が経由点
+            for (size_t k = 0; k < samples.size(); k++)
+            {
+                if (samples[k].segment == (int)i)
+                {
+                    samples[k - 1].v_max = std::min(samples[k - 1].v_max, v_corner);
+                    break;
+                }
+            }
+        }
+
+        // 始点と終点は停止
+        samples.front().v_max = 0.0f;
+        samples.back().v_max = 0.0f;
+
+        // 前進パス: 加速度制限
+        samples.front().v = 0.0f;
+        for (size_t k = 1; k < samples.size(); k++)
+        {
+            float ds = samples[k].s - samples[k - 1].s;
+            float v_reachable = std::sqrt(samples[k - 1].v * samples[k - 1].v + 2.0f * options.max_acceleration * ds);
+            samples[k].v = std::min(samples[k].v_max, v_reachable);
+        }
+
+        // 後退パス: 減速度制限
+        for (size_t k = samples.size() - 1; k > 0; k--)
+        {
+            float ds = samples[k].s - samples[k - 1].s;
+            float v_stoppable = std::sqrt(samples[k].v * samples[k].v + 2.0f * options.max_acceleration * ds);
+            samples[k - 1].v = std::min(samples[k - 1].v, v_stoppable);
+        }
+
+        // 時刻を積分
+        samples.front().t = 0.0f;
+        for (size_t k = 1; k < samples.size(); k++)
+        {
+            float ds = samples[k].s - samples[k - 1].s;
+            float v_mean = (samples[k].v + samples[k - 1].v) / 2.0f;
+            samples[k].t = samples[k - 1].t + (v_mean > 0.0f ? ds / v_mean : 0.0f);
+        }
+
+        return samples;
+    }
+
+    void printHeader(const std::vector<Waypoint> &waypoints, const std::vector<Sample> &samples, const char *course, const char *name, const Options &options)
+    {
+        float duration = samples.back().t;
+
+        printf("#pragma once\n");
+        printf("#include \"system/TrajectoryPlayer.hpp\"\n\n");
+        printf("// tools/trajectory_plannerで生成。手で編集しないこと。\n");
+        printf("// course: %s\n", course);
+        printf("// max_wheel_rps: %.3f, max_duty: %.3f, max_acceleration: %.3f m/s^2, period: %.3f s\n",
+               options.max_wheel_rps, options.max_duty, options.max_acceleration, options.period);
+        printf("// duration: %.3f s\n", duration);
+        printf("constexpr TrajectoryPoint %s[] = {\n", name);
+
+        size_t k = 0;
+        int points = (int)std::ceil(duration / options.period);
+        for (int n = 0; n <= points; n++)
+        {
+            float t = std::min(n * options.period, duration);
+            while (k + 2 < samples.size() && samples[k + 1].t <= t)
+            {
+                k++;
+            }
+
+            const Sample &from = samples[k];
+            const Sample &to = samples[k + 1];
+            float ratio = to.t > from.t ? (t - from.t) / (to.t - from.t) : 1.0f;
+            ratio = std::min(std::max(ratio, 0.0f), 1.0f);
+
+            float x = from.x + (to.x - from.x) * ratio;
+            float y = from.y + (to.y - from.y) * ratio;
+            float theta = from.theta + (to.theta - from.theta) * ratio;
+            float v = from.v + (to.v - from.v) * ratio;
+            Direction direction = segmentDirection(waypoints[to.segment], waypoints[to.segment + 1]);
+
+            printf("    {%.3ff, {%.4f_m, %.4f_m, %.4f_rad}, {%.4f_m_s, %.4f_m_s, %.4f_rad_s}},\n",
+                   t, x, y, theta, v * direction.x, v * direction.y, v * direction.theta);
+        }
+
+        printf("};\n");
+    }
+
+    void printUsage(const char *program)
+    {
+        fprintf(stderr,
+                "usage: %s <course.txt> <name> [--max-wheel-rps R] [--max-duty D] [--max-acceleration A] [--period T]\n",
+                program);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Options options;
+    for (int i = 3; i + 1 < argc; i += 2)
+    {
+        float value = std::strtof(argv[i + 1], nullptr);
+
+        if (std::strcmp(argv[i], "--max-wheel-rps") == 0)
+        {
+            options.max_wheel_rps = value;
+        }
+        else if (std::strcmp(argv[i], "--max-duty") == 0)
+        {
+            options.max_duty = value;
+        }
+        else if (std::strcmp(argv[i], "--max-acceleration") == 0)
+        {
+            options.max_acceleration = value;
+        }
+        else if (std::strcmp(argv[i], "--period") == 0)
+        {
+            options.period = value;
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Waypoint> waypoints = readCourse(argv[1]);
+    std::vector<Sample> samples = planVelocity(waypoints, options);
+    printHeader(waypoints, samples, argv[1], argv[2], options);
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+// units_check.shが逆アセンブルして比べる関数の組。
+// unit_XXXは単位付きの型で、raw_XXXは同じ計算をfloatで書いたもの。組ごとに同じ命令列になるはず。
+// 戻り値・引数のレイアウトを揃えるため、ベクトルのraw版はfloat3つの構造体を使う。
+#include <chrono>
+#include "units/units.hpp"
+
+struct RawVector
+{
+    float x;
+    float y;
+    float theta;
+};
+
+constexpr float MM_TO_M = 0.001f;
+constexpr float DEG_TO_RAD = (float)(M_PI / 180.0);
+constexpr float KMH_TO_MS = (float)(1000.0 / 3600.0);
+
+extern "C"
+{
+    // 異なる単位の加算
+    Meter unit_add_mm(Meter a, Millimeter b) { return a + b; }
+    float raw_add_mm(float a, float b) { return a + b * MM_TO_M; }
+
+    // 異なる単位の比較
+    bool unit_less_mm(Meter a, Millimeter b) { return a < b; }
+    bool raw_less_mm(float a, float b) { return a < b * MM_TO_M; }
+
+    // 度 -> ラジアン
+    Radian unit_deg_to_rad(Degree a) { return a; }
+    float raw_deg_to_rad(float a) { return a * DEG_TO_RAD; }
+
+    // km/h -> m/s
+    MeterPerSecond unit_kmh_to_ms(KilometerPerHour a) { return a; }
+    float raw_kmh_to_ms(float a) { return a * KMH_TO_MS; }
+
+    // 同じ単位の演算 (PIDの比例項)
+    Meter unit_scale(Meter target, Meter current, float gain) { return (target - current) * gain; }
+    float raw_scale(float target, float current, float gain) { return (target - current) * gain; }
+
+    // 位置の偏差にゲインを掛ける (PIDController<Position>)
+    Position unit_position_error(Position target, Position current, float gain) { return (target - current) * gain; }
+    RawVector raw_position_error(RawVector target, RawVector current, float gain)
+    {
+        return RawVector{(target.x - current.x) * gain, (target.y - current.y) * gain, (target.theta - current.theta) * gain};
+    }
+
+    // 速度を積分して位置を進める (Velocity * 時間 -> Position)
+    Position unit_integrate(Position position, Velocity velocity, float dt)
+    {
+        return position + velocity * std::chrono::duration<float>(dt);
+    }
+    RawVector raw_integrate(RawVector position, RawVector velocity, float dt)
+    {
+        return RawVector{position.x + velocity.x * dt, position.y + velocity.y * dt, position.theta + velocity.theta * dt};
+    }
+
+    // 角速度が度毎秒の速度ベクトルを足す
+    Velocity unit_add_deg_s(Velocity a, Velocity_m_s_deg_s b) { return a + b; }
+    RawVector raw_add_deg_s(RawVector a, RawVector b)
+    {
+        return RawVector{a.x + b.x, a.y + b.y, a.theta + b.theta * DEG_TO_RAD};
+    }
+}
@@ -0,0 +1,175 @@
+// 単位付きの型(units)で書いた計算と、同じ計算をfloatで書いたものの実行時間を比べるホスト用ツール。
+// どちらも同じ命令になるはずなので、比(unit / raw)は1前後になる。命令の比較はunits_check.shで行う。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Ilib/Eigen/include tools/units_bench/units_bench.cpp -o units_bench
+//
+// ### usage
+// ./units_bench [repeat]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "units/units.hpp"
+#include "units/eigenMap.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int SIZE = 1024;
+    constexpr float DT = 0.005f;
+    constexpr float GAIN = 0.8f;
+    constexpr float MM_TO_M = 0.001f;
+    constexpr float M_TO_MM = 1000.0f;
+    constexpr float DEG_TO_RAD = (float)(M_PI / 180.0);
+
+    struct RawVector
+    {
+        float x;
+        float y;
+        float theta;
+    };
+
+    volatile float sink;
+
+    // functionをrepeat回呼んだときの1要素あたりの時間[ns]
+    template <typename Function>
+    double measure(int repeat, Function function)
+    {
+        function(); // キャッシュを温める
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < repeat; i++)
+        {
+            function();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+        return elapsed.count() / repeat / SIZE;
+    }
+
+    void report(const char *name, double unit, double raw)
+    {
+        printf("%-28s unit %7.3f ns  raw %7.3f ns  ratio %.2f\n", name, unit, raw, unit / raw);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<Position> targets(SIZE), currents(SIZE), errors(SIZE);
+    std::vector<Velocity_m_s_deg_s> velocities(SIZE);
+    std::vector<Millimeter> offsets(SIZE);
+    std::vector<RawVector> raw_targets(SIZE), raw_currents(SIZE), raw_errors(SIZE), raw_velocities(SIZE);
+    std::vector<float> raw_offsets(SIZE);
+    for (int i = 0; i < SIZE; i++)
+    {
+        raw_targets[i] = {distribution(random), distribution(random), distribution(random)};
+        raw_currents[i] = {distribution(random), distribution(random), distribution(random)};
+        raw_velocities[i] = {distribution(random), distribution(random), distribution(random) * 180.0f};
+        raw_offsets[i] = distribution(random) * 1000.0f;
+
+        targets[i] = Position(Meter(raw_targets[i].x), Meter(raw_targets[i].y), Radian(raw_targets[i].theta));
+        currents[i] = Position(Meter(raw_currents[i].x), Meter(raw_currents[i].y), Radian(raw_currents[i].theta));
+        velocities[i] = Velocity_m_s_deg_s(MeterPerSecond(raw_velocities[i].x), MeterPerSecond(raw_velocities[i].y), DegPerSecond(raw_velocities[i].theta));
+        offsets[i] = Millimeter(raw_offsets[i]);
+    }
+
+    // 位置の偏差にゲインを掛ける (PIDController<Position>の比例項)
+    double unit = measure(repeat, [&]
+                          {
+                              for (int i = 0; i < SIZE; i++)
+                              {
+                                  errors[i] = (targets[i] - currents[i]) * GAIN;
+                              }
+                              sink = errors[SIZE - 1].x.value; });
+    double raw = measure(repeat, [&]
+                         {
+                             for (int i = 0; i < SIZE; i++)
+                             {
+                                 raw_errors[i] = {(raw_targets[i].x - raw_currents[i].x) * GAIN,
+                                                  (raw_targets[i].y - raw_currents[i].y) * GAIN,
+                                                  (raw_targets[i].theta - raw_currents[i].theta) * GAIN};
+                             }
+                             sink = raw_errors[SIZE - 1].x; });
+    report("position error * gain", unit, raw);
+
+    // 度毎秒の速度を積分する (Velocity * 時間 -> Position, 度 -> ラジアンの変換を含む)
+    unit = measure(repeat, [&]
+                   {
+                       Position position(0_m, 0_m, 0_rad);
+                       for (int i = 0; i < SIZE; i++)
+                       {
+                           position += velocities[i] * std::chrono::duration<float>(DT);
+                       }
+                       sink = position.theta.value; });
+    raw = measure(repeat, [&]
+                  {
+                      RawVector position = {0.0f, 0.0f, 0.0f};
+                      for (int i = 0; i < SIZE; i++)
+                      {
+                          position.x += raw_velocities[i].x * DT;
+                          position.y += raw_velocities[i].y * DT;
+                          position.theta += raw_velocities[i].theta * DT * DEG_TO_RAD;
+                      }
+                      sink = position.theta; });
+    report("integrate deg/s velocity", unit, raw);
+
+    // 異なる単位の比較と加算 (ミリメートルの補正をメートルの位置に足す)
+    // どちらも右辺を左辺の単位に変換する (比較はミリメートル、加算はメートルで行う)
+    unit = measure(repeat, [&]
+                   {
+                       Meter sum = 0_m;
+                       for (int i = 0; i < SIZE; i++)
+                       {
+                           if (offsets[i] < targets[i].x)
+                           {
+                               sum += offsets[i];
+                           }
+                       }
+                       sink = sum.value; });
+    raw = measure(repeat, [&]
+                  {
+                      float sum = 0.0f;
+                      for (int i = 0; i < SIZE; i++)
+                      {
+                          if (raw_offsets[i] < raw_targets[i].x * M_TO_MM)
+                          {
+                              sum += raw_offsets[i] * MM_TO_M;
+                          }
+                      }
+                      sink = sum; });
+    report("mm vs m compare and add", unit, raw);
+
+    // Eigenの固定長ベクトルとして回転行列を掛ける (units/eigenMap.hpp)
+    Eigen::Matrix3f rotation;
+    rotation << 0.6f, -0.8f, 0.0f,
+        0.8f, 0.6f, 0.0f,
+        0.0f, 0.0f, 1.0f;
+    unit = measure(repeat, [&]
+                   {
+                       for (int i = 0; i < SIZE; i++)
+                       {
+                           asEigen(errors[i]) = rotation * asEigen(targets[i]);
+                       }
+                       sink = errors[SIZE - 1].y.value; });
+    raw = measure(repeat, [&]
+                  {
+                      for (int i = 0; i < SIZE; i++)
+                      {
+                          const RawVector &target = raw_targets[i];
+                          raw_errors[i] = {rotation(0, 0) * target.x + rotation(0, 1) * target.y + rotation(0, 2) * target.theta,
+                                           rotation(1, 0) * target.x + rotation(1, 1) * target.y + rotation(1, 2) * target.theta,
+                                           rotation(2, 0) * target.x + rotation(2, 1) * target.y + rotation(2, 2) * target.theta};
+                      }
+                      sink = raw_errors[SIZE - 1].y; });
+    report("rotate via Eigen::Map", unit, raw);
+
+    return 0;
+}
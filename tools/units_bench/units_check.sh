@@ -0,0 +1,51 @@
+#!/bin/sh
+# asm_probe.cppをコンパイルし、単位付きの関数(unit_XXX)とfloatの関数(raw_XXX)の命令列を組ごとに比べる。
+#   same:       アドレスと関数名を除いた逆アセンブルが一致
+#   reordered:  演算命令(転送以外)の種類と数が一致し、命令数がraw以下 (並び順やレジスタ割り当てだけが違う)
+#   DIFFERENT:  それ以外。差分を表示して終了コード1
+#
+# ### usage (リポジトリのルートで実行)
+# sh tools/units_bench/units_check.sh
+# Cortex-M4Fのコンパイラで確かめるとき
+# CXX=arm-none-eabi-g++ OBJDUMP=arm-none-eabi-objdump CXXFLAGS="-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard -Os" sh tools/units_bench/units_check.sh
+CXX=${CXX:-g++}
+OBJDUMP=${OBJDUMP:-objdump}
+CXXFLAGS=${CXXFLAGS:--O2}
+PROBE=tools/units_bench/asm_probe.cpp
+OUT=${TMPDIR:-/tmp}/units_check.$$
+
+$CXX -std=gnu++17 $CXXFLAGS -Isrc -c $PROBE -o $OUT.o || exit 1
+
+# 関数1つの命令列 (アドレス・機械語・分岐先の名前を除く)
+disassemble() {
+    $OBJDUMP -d --no-show-raw-insn --disassemble="$1" $OUT.o |
+        sed -n '/^[0-9a-f]* <'"$1"'>:$/,/^$/p' |
+        sed -e '1d' -e '/^$/d' -e 's/^ *[0-9a-f]*:[[:space:]]*//' -e 's/<[^>]*>//g' -e 's/[[:space:]]*#.*$//' -e 's/[[:space:]]*$//' -e 's/[[:space:]]\{1,\}/ /g' |
+        grep -v '^\(nop\|xchg %ax,%ax\|data16\|cs nopw\)'
+}
+
+# 転送(mov, load/store, push/pop)を除いた演算命令の名前を並べ替えたもの
+operations() {
+    sed 's/ .*//' "$1" | grep -v '^\(v\{0,1\}mov\|v\{0,1\}ldr\|v\{0,1\}str\|ld\|st\|push\|pop\|vpush\|vpop\)' | sort
+}
+
+status=0
+for unit in $(nm $OUT.o | sed -n 's/.* T \(unit_.*\)$/\1/p' | sort); do
+    raw=raw_${unit#unit_}
+    disassemble $unit > $OUT.unit
+    disassemble $raw > $OUT.raw
+    count=$(wc -l < $OUT.unit)
+    raw_count=$(wc -l < $OUT.raw)
+    if cmp -s $OUT.unit $OUT.raw; then
+        printf '%-24s same (%d instructions)\n' "${unit#unit_}" $count
+    elif [ "$(operations $OUT.unit)" = "$(operations $OUT.raw)" ] && [ $count -le $raw_count ]; then
+        printf '%-24s reordered (%d instructions, raw %d)\n' "${unit#unit_}" $count $raw_count
+    else
+        printf '%-24s DIFFERENT\n' "${unit#unit_}"
+        diff $OUT.unit $OUT.raw | sed 's/^/    /'
+        status=1
+    fi
+done
+
+rm -f $OUT.o $OUT.unit $OUT.raw
+exit $status
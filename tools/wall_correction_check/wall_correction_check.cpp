@@ -0,0 +1,204 @@
+// WallCorrectedOdometryが壁との接触でオドメトリのずれを引き戻すことを確かめるホスト用ツール。
+// 機体を斜めに走らせ、駆動輪3輪のエンコーダーにカウントを与えてオドメトリを200Hzで更新する。
+// 車輪0は滑ってカウントがSLIP_SCALE倍に出て、IMUのヨーはGYRO_DRIFTで流れるので、推定は真値からずれていく。
+// - TOF (ポーリング): y = Y_WALLの壁をセンサーが検知した更新で補正する (addPolledSensor)
+// - リミットスイッチ: x = X_WALLの壁に当たった時刻のイベントを、NOTIFY_DELAYだけ遅れて処理する
+//   (LimitSwitchの通知スレッドはホストで動かないので、ContactListenerと同じくイベントの時刻でcorrectを呼ぶ)
+// 次を確かめる。
+// - 補正の直後に、壁で拘束される軸の推定の誤差がMAX_ERROR以下か (補正前の誤差も表示する)
+// - リミットスイッチで向きも壁に合わせたとき、向きの誤差がMAX_HEADING_ERROR以下か
+// - ImuWheelOdometryを内側にしたとき、補正でIMUのヨーがリセットされないか (Imu::getYawが変わらない)
+// 1つでも満たさなければ終了コード1。
+//
+// ### build
+// g++ -std=gnu++17 -O2 -Isrc -Itools/host -Ilib/Eigen/include tools/wall_correction_check/wall_correction_check.cpp -o wall_correction_check
+//
+// ### usage
+// ./wall_correction_check
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "WheelSettings.hpp"
+#include "system/odometry/WheelOdometry.hpp"
+#include "system/odometry/ImuWheelOdometry.hpp"
+#include "system/odometry/WallCorrectedOdometry.hpp"
+
+namespace
+{
+    constexpr int FREQUENCY = 200;
+    constexpr std::chrono::microseconds PERIOD(1000000 / FREQUENCY);
+    constexpr std::chrono::milliseconds NOTIFY_DELAY(20); // リミットスイッチの通知から補正までの遅れ
+    constexpr int ENCODER_RESOLUTION = 2048;
+    constexpr double SLIP_SCALE = 1.03;                    // 車輪0のカウントの倍率
+    constexpr double GYRO_DRIFT = 0.5;                     // IMUのヨーのドリフト [deg/s] (機体の向きは0のまま)
+    constexpr double VELOCITY_X = 0.5;                     // [m/s]
+    constexpr double VELOCITY_Y = -0.15;                   // [m/s]
+    constexpr double X_WALL = 1.5;                         // [m]
+    constexpr double Y_WALL = -0.6;                        // [m]
+    constexpr double MAX_ERROR = 0.002;                    // [m]
+    constexpr double MAX_HEADING_ERROR = 0.2 * M_PI / 180; // [rad]
+
+    constexpr std::array<WheelPositions, 3> WHEEL_POSITIONS = WheelSettings::drive_wheels;
+
+    // 前向きのリミットスイッチ (機体中心から0.2m前)
+    const WallContact LIMIT_SWITCH_CONTACT = {
+        WallAxis::X, Meter((float)X_WALL), Position(0.2_m, 0_m, 0_rad), 0_m, true, 0_rad, 0.1_m};
+    // 右向きのTOF (機体中心から0.15m右、0.1m先を検知したら反応)
+    const WallContact TOF_CONTACT = {
+        WallAxis::Y, Meter((float)Y_WALL), Position(0_m, -0.15_m, Radian(Degree(-90.0f))), 0.1_m, false, 0_rad, 0.1_m};
+
+    // シミュレーションの時刻 (戻さない)
+    HighResClock::time_point now = HighResClock::now();
+
+    struct Report
+    {
+        double before; // 補正する前の、拘束される軸の誤差 (推定 - 真値)
+        double after;  // 補正した直後の誤差
+        bool done;
+    };
+
+    void printReport(const char *name, const Report &report, bool ok)
+    {
+        if (!report.done)
+        {
+            printf("  %-14s not corrected FAILED\n", name);
+            return;
+        }
+        printf("  %-14s error %7.2f mm -> %6.2f mm %s\n", name, report.before * 1000.0, report.after * 1000.0, ok ? "ok" : "FAILED");
+    }
+
+    // Inner: 内側のオドメトリ (WheelOdometry<3>かImuWheelOdometry<3>)
+    template <typename Inner>
+    bool run(const char *name, Inner &inner, array<Encoder, 3> &encoders, Imu *imu)
+    {
+        WallCorrectedOdometry<3> odometry(inner);
+
+        double x = 0.0;
+        double y = 0.0;
+        std::array<double, 3> rotations = {};
+        std::array<long, 3> counts = {};
+
+        bool tof_detecting = false;
+        odometry.addPolledSensor([&]
+                                 { return tof_detecting; },
+                                 TOF_CONTACT);
+
+        Report tof = {0.0, 0.0, false};
+        Report limit_switch = {0.0, 0.0, false};
+        double heading_error = 0.0;
+        bool yaw_kept = true;
+        bool is_touching = false;
+        HighResClock::time_point contact_time{};
+        double heading_before = 0.0;
+
+        double duration = (X_WALL - 0.2) / VELOCITY_X + 0.5;
+        for (int k = 0; k < (int)(duration * FREQUENCY); k++)
+        {
+            // 壁に当たったらx方向には進まない (リミットスイッチが壁の位置で止まる)
+            double dt = 1.0 / FREQUENCY;
+            double vx = std::fmin(VELOCITY_X, (X_WALL - 0.2 - x) / dt);
+            double vy = y - 0.15 - 0.1 <= Y_WALL - 0.05 ? 0.0 : VELOCITY_Y;
+            x += vx * dt;
+            y += vy * dt;
+
+            for (int i = 0; i < 3; i++)
+            {
+                WheelVector wheel_vector = getWheelVector(WHEEL_POSITIONS[i]);
+                rotations[i] += (wheel_vector.x * vx + wheel_vector.y * vy) * dt * (i == 0 ? SLIP_SCALE : 1.0);
+                long count = std::lround(rotations[i] * ENCODER_RESOLUTION);
+                encoders[i].addCount((int)(count - counts[i]));
+                counts[i] = count;
+            }
+
+            now += PERIOD;
+            HighResClock::setNow(now);
+            if (imu != nullptr)
+            {
+                imu->setYaw((float)(GYRO_DRIFT * (k + 1) * dt));
+            }
+
+            // TOFは更新のたびにポーリングされる
+            bool was_detecting = tof_detecting;
+            tof_detecting = y - 0.15 - 0.1 <= Y_WALL;
+            if (tof_detecting && !was_detecting)
+            {
+                tof.before = (odometry.getCurrentPosition().y.value - y);
+            }
+
+            float yaw_before = imu != nullptr ? imu->getYaw() : 0.0f;
+            int corrections = odometry.getCorrectionCount();
+            odometry.updatePosition();
+            if (tof_detecting && !was_detecting)
+            {
+                tof.after = odometry.getCurrentPosition().y.value - y;
+                tof.done = odometry.getCorrectionCount() > corrections;
+            }
+
+            // リミットスイッチ: 当たった時刻を記録し、遅れて補正する
+            if (!is_touching && x + 0.2 >= X_WALL - 1e-9)
+            {
+                is_touching = true;
+                contact_time = now;
+                Position estimate = odometry.getCurrentPosition();
+                limit_switch.before = estimate.x.value - x;
+                heading_before = normalizeAngle(estimate.theta).value;
+            }
+            if (is_touching && !limit_switch.done && now - contact_time >= NOTIFY_DELAY)
+            {
+                limit_switch.done = odometry.correct(LIMIT_SWITCH_CONTACT, contact_time);
+                Position estimate = odometry.getCurrentPosition();
+                limit_switch.after = estimate.x.value - x;
+                heading_error = normalizeAngle(estimate.theta).value;
+            }
+
+            if (imu != nullptr && imu->getYaw() != yaw_before)
+            {
+                yaw_kept = false;
+            }
+        }
+
+        bool tof_ok = tof.done && std::fabs(tof.after) <= MAX_ERROR;
+        bool limit_switch_ok = limit_switch.done && std::fabs(limit_switch.after) <= MAX_ERROR;
+        bool heading_ok = limit_switch.done && std::fabs(heading_error) <= MAX_HEADING_ERROR;
+
+        printf("%s\n", name);
+        printReport("TOF (y)", tof, tof_ok);
+        printReport("switch (x)", limit_switch, limit_switch_ok);
+        printf("  %-14s error %7.3f deg -> %6.3f deg %s\n", "heading", heading_before * 180.0 / M_PI, heading_error * 180.0 / M_PI, heading_ok ? "ok" : "FAILED");
+        if (imu != nullptr)
+        {
+            printf("  %-14s %s\n", "imu yaw", yaw_kept ? "not reset ok" : "reset by the correction FAILED");
+        }
+
+        return tof_ok && limit_switch_ok && heading_ok && yaw_kept;
+    }
+
+    struct Sensors
+    {
+        array<Encoder, 3> encoders = {Encoder(NC, NC, ENCODER_RESOLUTION), Encoder(NC, NC, ENCODER_RESOLUTION), Encoder(NC, NC, ENCODER_RESOLUTION)};
+        array<MeasuringWheel, 3> measuring_wheels = {
+            MeasuringWheel{WHEEL_POSITIONS[0], encoders[0]},
+            MeasuringWheel{WHEEL_POSITIONS[1], encoders[1]},
+            MeasuringWheel{WHEEL_POSITIONS[2], encoders[2]},
+        };
+    };
+}
+
+int main()
+{
+    printf("drift: wheel 0 slips (counts x%.2f), imu yaw drifts %.1f deg/s; correction checked within %.1f mm, %.1f deg\n", SLIP_SCALE, GYRO_DRIFT, MAX_ERROR * 1000.0, MAX_HEADING_ERROR * 180.0 / M_PI);
+
+    Sensors wheel_sensors;
+    WheelOdometry<3> wheel_odometry(wheel_sensors.measuring_wheels);
+    bool ok = run("WheelOdometry<3>", wheel_odometry, wheel_sensors.encoders, nullptr);
+
+    Sensors imu_sensors;
+    Imu imu(NC, NC);
+    imu.setYaw(0.0f);
+    ImuWheelOdometry<3> imu_odometry(imu_sensors.measuring_wheels, imu);
+    ok &= run("ImuWheelOdometry<3>", imu_odometry, imu_sensors.encoders, &imu);
+
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}